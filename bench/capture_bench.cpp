@@ -0,0 +1,192 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file capture_bench.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Render thread cost of capturing 4K frames with synchronous read backs and with the pixel buffer ring.
+
+#include "../src/frame_capture.h"
+#include "../src/headless_context.h"
+#include "../src/image.h"
+#include "../src/render_target.h"
+#include "../src/shader_program.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+namespace {
+
+const char *vertex_source = R"(#version 440 core
+out vec2 uv;
+void main() {
+  uv = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+  gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// gradient plus noise, so the encoder has real work to do
+const char *fragment_source = R"(#version 440 core
+layout(location = 0) uniform float time;
+in vec2 uv;
+out vec4 fragColor;
+void main() {
+  float noise = fract(sin(dot(gl_FragCoord.xy + time, vec2(12.9898, 78.233))) * 43758.5453);
+  fragColor = vec4(uv, 0.5 + 0.5 * sin(time), 1.0) * (0.8 + 0.2 * noise);
+}
+)";
+
+struct CaptureResult {
+  f64 median_ms{0}; //!< render thread time per frame
+  f64 p95_ms{0};
+  f64 max_ms{0};
+  u32 late_frames{0}; //!< frames over the frame budget
+  f64 total_ms{0};    //!< until every file was written
+  u32 written{0};
+  u32 stalls{0};
+};
+
+/// Renders **frames** frames paced at **fps** and captures each one, either
+/// with a synchronous glReadPixels or through FrameCapture. Both hand the
+/// encoding to the thread pool, so only the read back differs.
+CaptureResult run(bool async, RenderTarget &target, const ShaderProgram &program, GLuint vao, u32 frames, u32 fps,
+                  u32 ring_size, const std::string &directory) {
+  FrameCapture capture(ring_size);
+  std::vector<std::future<void>> sync_encodes;
+  std::vector<f64> frame_ms;
+  const auto budget = std::chrono::duration<f64>(1.0 / fps);
+  ponos::Timer total;
+  auto next_frame = std::chrono::steady_clock::now();
+  for (u32 f = 0; f < frames; ++f) {
+    ponos::Timer timer;
+    target.bind();
+    program.use();
+    glUniform1f(0, static_cast<f32>(f) / fps);
+    glBindVertexArray(vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    auto path = ponos::concat(directory, "/", async ? "async_" : "sync_", f, ".png");
+    if (async) {
+      capture.capture(target.id(), target.width(), target.height(), path);
+      capture.poll();
+    } else {
+      auto pixels = std::make_shared<std::vector<u8>>();
+      // waits for the frame to finish on the GPU
+      target.read(*pixels);
+      const u32 width = target.width(), height = target.height();
+      sync_encodes.emplace_back(ThreadPool::global().submit([pixels, width, height, path] {
+        std::vector<u8> flipped(pixels->size());
+        const size_t row = size_t(width) * 4;
+        for (u32 y = 0; y < height; ++y)
+          std::memcpy(&flipped[(height - 1 - y) * row], &(*pixels)[y * row], row);
+        std::string err;
+        encodePng(path, width, height, flipped.data(), err);
+      }));
+    }
+    // the swap of a windowed application
+    glFlush();
+    frame_ms.emplace_back(timer.tack());
+    next_frame += std::chrono::duration_cast<std::chrono::steady_clock::duration>(budget);
+    std::this_thread::sleep_until(next_frame);
+  }
+  CaptureResult result;
+  if (async) {
+    capture.finish();
+    result.written = capture.written;
+    result.stalls = capture.stalls;
+  } else {
+    for (auto &encode : sync_encodes)
+      encode.wait();
+    result.written = static_cast<u32>(sync_encodes.size());
+  }
+  result.total_ms = total.tack();
+  const f64 budget_ms = 1000.0 / fps;
+  for (auto ms : frame_ms)
+    if (ms > budget_ms)
+      result.late_frames++;
+  std::sort(frame_ms.begin(), frame_ms.end());
+  result.median_ms = frame_ms[frame_ms.size() / 2];
+  result.p95_ms = frame_ms[std::min(frame_ms.size() - 1, frame_ms.size() * 95 / 100)];
+  result.max_ms = frame_ms.back();
+  return result;
+}
+
+}
+
+int main(int argc, char **argv) {
+  u32 width = 3840, height = 2160, frames = 120, fps = 30, ring_size = 3;
+  std::string directory = (std::filesystem::temp_directory_path() / "capture_bench").string();
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "-w" && has_value)
+      width = std::max(1, atoi(argv[++i]));
+    else if (arg == "-h" && has_value)
+      height = std::max(1, atoi(argv[++i]));
+    else if (arg == "-n" && has_value)
+      frames = std::max(1, atoi(argv[++i]));
+    else if (arg == "-f" && has_value)
+      fps = std::max(1, atoi(argv[++i]));
+    else if (arg == "-r" && has_value)
+      ring_size = std::max(1, atoi(argv[++i]));
+    else if (arg == "-o" && has_value)
+      directory = argv[++i];
+    else {
+      printf("usage: %s [-w width] [-h height] [-n frames] [-f fps] [-r ring size] [-o output dir]\n", argv[0]);
+      return -1;
+    }
+  }
+  HeadlessContext context;
+  std::string err;
+  if (!context.create(err)) {
+    printf("%s\n", err.c_str());
+    return -1;
+  }
+  RenderTarget target;
+  ShaderProgram program;
+  circe::gl::Shader vertex_shader, fragment_shader;
+  if (!target.resize(width, height) || !vertex_shader.compile(vertex_source, GL_VERTEX_SHADER)
+      || !fragment_shader.compile(fragment_source, GL_FRAGMENT_SHADER)
+      || !program.link({&vertex_shader, &fragment_shader})) {
+    printf("setup failed: %s%s%s\n", vertex_shader.err.c_str(), fragment_shader.err.c_str(), program.err.c_str());
+    return -1;
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  GLuint vao = 0;
+  glGenVertexArrays(1, &vao);
+  printf("%s | %ux%u | %u frames at %u fps | ring %u | %u encode threads | %s\n", context.renderer().c_str(), width,
+         height, frames, fps, ring_size, ThreadPool::global().size(), directory.c_str());
+  printf("%-8s %10s %10s %10s %6s %10s %8s %7s\n", "readback", "median ms", "p95 ms", "max ms", "late", "total ms",
+         "written", "stalls");
+  for (bool async : {false, true}) {
+    auto r = run(async, target, program, vao, frames, fps, ring_size, directory);
+    printf("%-8s %10.2f %10.2f %10.2f %6u %10.1f %8u %7u\n", async ? "pbo" : "sync", r.median_ms, r.p95_ms,
+           r.max_ms, r.late_frames, r.total_ms, r.written, r.stalls);
+  }
+  glDeleteVertexArrays(1, &vao);
+  return 0;
+}
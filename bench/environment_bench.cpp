@@ -0,0 +1,118 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file environment_bench.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Cost of the image based lighting precompute for different worker counts, against reading it back from the cache.
+
+#include "../src/environment.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+namespace {
+
+/// Sky gradient over a dark ground, with a small bright sun
+void proceduralSky(u32 width, HdrImage &image) {
+  image.width = width;
+  image.height = width / 2;
+  image.data.resize(size_t(image.width) * image.height * 3);
+  for (u32 y = 0; y < image.height; ++y)
+    for (u32 x = 0; x < image.width; ++x) {
+      f32 elevation = 1 - 2 * (y + 0.5f) / image.height;
+      f32 *rgb = image.data.data() + (size_t(y) * image.width + x) * 3;
+      bool sun = std::abs(elevation - 0.5f) < 0.02f && x % (image.width / 2) < image.width / 100;
+      for (int c = 0; c < 3; ++c)
+        rgb[c] = sun ? 50.f : elevation > 0 ? 0.3f + 0.7f * elevation * (c + 1) / 3 : 0.1f;
+    }
+}
+
+}
+
+int main(int argc, char **argv) {
+  // usage: environment_bench [-w equirect width] [-n repetitions] [file.hdr]
+  u32 width = 2048;
+  int repetitions = 3;
+  std::string path;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-w" && i + 1 < argc)
+      width = std::max(64, atoi(argv[++i]));
+    else if (arg == "-n" && i + 1 < argc)
+      repetitions = std::max(1, atoi(argv[++i]));
+    else if (arg[0] == '-') {
+      printf("usage: %s [-w equirect width] [-n repetitions] [file.hdr]\n", argv[0]);
+      return -1;
+    } else
+      path = arg;
+  }
+  HdrImage equirect;
+  std::string err;
+  if (path.empty())
+    proceduralSky(width, equirect);
+  else if (!decodeHdrImage(path, equirect, err)) {
+    printf("%s\n", err.c_str());
+    return -1;
+  }
+  EnvironmentParams params;
+  printf("%ux%u equirect | specular %u px, %u samples | brdf %u px, %u samples\n", equirect.width, equirect.height,
+         params.specular_size, params.specular_samples, params.brdf_size, params.brdf_samples);
+  std::vector<u32> thread_counts;
+  for (u32 threads = 1; threads < std::thread::hardware_concurrency(); threads *= 2)
+    thread_counts.emplace_back(threads);
+  thread_counts.emplace_back(std::max(1u, std::thread::hardware_concurrency()));
+  // best of repetitions
+  auto best = [&](const std::function<void()> &f) {
+    f64 best_ms = 0;
+    for (int r = 0; r < repetitions; ++r) {
+      ponos::Timer timer;
+      f();
+      f64 ms = timer.tack();
+      if (r == 0 || ms < best_ms)
+        best_ms = ms;
+    }
+    return best_ms;
+  };
+  printf("%8s %10s %14s\n", "threads", "SH ms", "precompute ms");
+  Environment environment;
+  for (auto threads : thread_counts) {
+    ThreadPool pool(threads);
+    f32 sh[9][3];
+    f64 sh_ms = best([&] { projectIrradiance(equirect, sh, pool); });
+    f64 precompute_ms = best([&] { precomputeEnvironment(equirect, params, environment, pool); });
+    printf("%8u %10.1f %14.1f\n", threads, sh_ms, precompute_ms);
+  }
+  // what switching to an already computed environment costs
+  auto cache_path = (std::filesystem::temp_directory_path() / "environment_bench.env").string();
+  f64 write_ms = best([&] { writeEnvironmentFile(cache_path, environment, 0); });
+  Environment cached;
+  u64 source_hash = 0;
+  f64 read_ms = best([&] { readEnvironmentFile(cache_path, cached, source_hash); });
+  printf("cache file %.1f KB | write %.2f ms | read %.2f ms\n", std::filesystem::file_size(cache_path) / 1024.0,
+         write_ms, read_ms);
+  std::error_code ec;
+  std::filesystem::remove(cache_path, ec);
+  return 0;
+}
@@ -0,0 +1,227 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_optimizer_bench.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Vertex cache statistics and vertex throughput before and after mesh optimization.
+
+#include "../src/gpu_mesh.h"
+#include "../src/gpu_timer.h"
+#include "../src/headless_context.h"
+#include "../src/mesh_optimizer.h"
+#include "../src/obj_loader.h"
+#include "../src/render_target.h"
+#include "../src/shader_program.h"
+#include "../src/vertex_format.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// vertex bound on purpose: every vertex runs a small loop and the target is
+// tiny, so the time follows the number of vertex shader invocations
+const char *vertex_source = R"(#version 440 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec2 texcoord;
+layout(location = 0) uniform mat4 model;
+layout(location = 1) uniform vec3 positionScale;
+layout(location = 2) uniform vec3 positionOffset;
+layout(location = 3) uniform int normalEncoding;
+out vec3 color;
+void main() {
+  vec3 n = normal;
+  if (normalEncoding == 1) {
+    n.z = 1.0 - abs(n.x) - abs(n.y);
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+  }
+  vec3 c = normalize(n) * 0.5 + 0.5;
+  for (int i = 0; i < 16; ++i)
+    c = fract(c * 1.618 + sin(c.zxy + float(i)) * 0.1 + vec3(texcoord, 0.0));
+  color = c;
+  gl_Position = model * vec4(position * positionScale + positionOffset, 1.0);
+}
+)";
+
+const char *fragment_source = R"(#version 440 core
+in vec3 color;
+layout(location = 0) out vec4 fragColor;
+void main() {
+  fragColor = vec4(color, 1.0);
+}
+)";
+
+struct GpuResult {
+  f64 median_ms{0};
+  f64 mtris{0}; //!< million triangles per second
+};
+
+std::string baseName(const std::string &path) {
+  auto slash = path.find_last_of('/');
+  auto name = slash == std::string::npos ? path : path.substr(slash + 1);
+  return name.substr(0, name.find_last_of('.'));
+}
+
+MeshAttribute attribute(const char *name, u32 component_count, u32 offset) {
+  MeshAttribute a;
+  strncpy(a.name, name, sizeof(a.name) - 1);
+  a.component_count = component_count;
+  a.type = GL_FLOAT;
+  a.offset = offset;
+  return a;
+}
+
+/// \return **vertex_data** in **format**
+PackedVertices pack(const std::vector<f32> &vertex_data, int format) {
+  const MeshAttribute attributes[] = {attribute("position", 3, 0), attribute("normal", 3, 12),
+                                      attribute("uv", 2, 24)};
+  PackedVertices packed;
+  std::string err;
+  packVertices(vertex_data.data(), vertex_data.size() / ObjMesh::vertex_stride, attributes, 3,
+               ObjMesh::vertex_stride * sizeof(f32), format, packed, err);
+  return packed;
+}
+
+/// Draws **instances** copies of the mesh per frame and measures the GPU time
+GpuResult measure(const ObjMesh &mesh, const PackedVertices &vertices, const std::vector<u32> &index_data,
+                  const ShaderProgram &program, RenderTarget &target, u32 frames, u32 instances) {
+  GpuMesh gpu_mesh;
+  gpu_mesh.upload(vertices.attributes, vertices.attribute_count, vertices.stride, vertices.data.data(),
+                  vertices.data.size(), index_data.data(), index_data.size());
+  const auto &dequantization = vertices.dequantization;
+  // the mesh fit into [-0.5, 0.5]
+  f32 extent = 0, center[3];
+  for (int d = 0; d < 3; ++d) {
+    extent = std::max(extent, mesh.bounds_max[d] - mesh.bounds_min[d]);
+    center[d] = (mesh.bounds_max[d] + mesh.bounds_min[d]) * 0.5f;
+  }
+  f32 s = extent > 0 ? 1 / extent : 1;
+  const f32 model[16] = {s, 0, 0, 0, 0, s, 0, 0, 0, 0, s, 0, -center[0] * s, -center[1] * s, -center[2] * s, 1};
+  GpuTimer timer(8);
+  std::vector<f64> frame_ms;
+  glEnable(GL_DEPTH_TEST);
+  for (u32 f = 0; f < frames + 10; ++f) {
+    bool measured = f >= 10;
+    if (measured)
+      timer.begin();
+    target.bind();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    program.use();
+    glUniformMatrix4fv(0, 1, GL_FALSE, model);
+    glUniform3fv(1, 1, dequantization.position_scale);
+    glUniform3fv(2, 1, dequantization.position_offset);
+    glUniform1i(3, dequantization.normal_encoding);
+    gpu_mesh.drawInstanced(instances);
+    if (measured) {
+      timer.end();
+      timer.collect(frame_ms);
+    } else
+      glFinish();
+  }
+  timer.collect(frame_ms, true);
+  GpuResult result;
+  if (frame_ms.empty())
+    return result;
+  std::sort(frame_ms.begin(), frame_ms.end());
+  result.median_ms = frame_ms[frame_ms.size() / 2];
+  result.mtris = index_data.size() / 3.0 * instances / 1e6 / (result.median_ms / 1000);
+  return result;
+}
+
+}
+
+int main(int argc, char **argv) {
+  u32 frames = 100, instances = 256, cache_size = default_vertex_cache_size;
+  int format = VertexFormat::FLOAT;
+  std::vector<std::string> meshes;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "-n" && has_value)
+      frames = std::max(1, atoi(argv[++i]));
+    else if (arg == "-i" && has_value)
+      instances = std::max(1, atoi(argv[++i]));
+    else if (arg == "-c" && has_value)
+      cache_size = std::max(3, atoi(argv[++i]));
+    else if (arg == "-f" && has_value)
+      format = std::max(0, std::min(atoi(argv[++i]), VertexFormat::COUNT - 1));
+    else if (arg[0] == '-') {
+      printf("usage: %s [-n frames] [-i instances] [-c cache size] [-f vertex format 0-2] [mesh.obj]...\n",
+             argv[0]);
+      return -1;
+    } else
+      meshes.emplace_back(arg);
+  }
+  if (meshes.empty())
+    for (const auto *name : {"suzanne", "torusknot"})
+      meshes.emplace_back(ponos::concat(MODELS_PATH, "/assets/", name, ".obj"));
+  // the cache statistics do not need a GPU
+  HeadlessContext context;
+  std::string err;
+  bool gpu = context.create(err) && GpuTimer::supported();
+  RenderTarget target;
+  ShaderProgram program;
+  if (gpu) {
+    circe::gl::Shader vertex_shader, fragment_shader;
+    gpu = target.resize(64, 64) && vertex_shader.compile(vertex_source, GL_VERTEX_SHADER)
+        && fragment_shader.compile(fragment_source, GL_FRAGMENT_SHADER)
+        && program.link({&vertex_shader, &fragment_shader});
+    if (!gpu)
+      err = vertex_shader.err + fragment_shader.err + program.err;
+  }
+  if (gpu)
+    printf("%s | %u frames | %u instances | cache %u | optimized vertices: %s\n", context.renderer().c_str(), frames,
+           instances, cache_size, vertexFormatName(format));
+  else
+    printf("no GPU timing (%s) | cache %u\n", err.c_str(), cache_size);
+  printf("%-12s %8s %8s %13s %13s %8s %17s %17s %7s\n", "mesh", "verts", "tris", "ACMR", "ATVR", "opt ms",
+         "GPU ms", "Mtri/s", "gain");
+  int result = 0;
+  for (const auto &path : meshes) {
+    ObjMesh mesh;
+    if (!loadObj(path, mesh, err)) {
+      printf("%-12s %s\n", baseName(path).c_str(), err.c_str());
+      result = -1;
+      continue;
+    }
+    auto vertex_data = mesh.vertex_data;
+    auto index_data = mesh.index_data;
+    auto report = optimizeMesh(vertex_data, ObjMesh::vertex_stride, index_data, cache_size);
+    printf("%-12s %8u %8zu %6.3f %6.3f %6.3f %6.3f %8.2f", baseName(path).c_str(), mesh.vertex_count,
+           mesh.index_data.size() / 3, report.before.acmr, report.after.acmr, report.before.atvr,
+           report.after.atvr, report.ms);
+    if (gpu) {
+      auto before = measure(mesh, pack(mesh.vertex_data, VertexFormat::FLOAT), mesh.index_data, program, target,
+                            frames, instances);
+      auto after = measure(mesh, pack(vertex_data, format), index_data, program, target, frames, instances);
+      printf(" %8.3f %8.3f %8.1f %8.1f %6.1f%%", before.median_ms, after.median_ms, before.mtris, after.mtris,
+             before.mtris > 0 ? (after.mtris / before.mtris - 1) * 100 : 0.0);
+    }
+    printf("\n");
+  }
+  return result;
+}
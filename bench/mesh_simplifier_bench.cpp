@@ -0,0 +1,97 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_simplifier_bench.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "../src/mesh_simplifier.h"
+#include "../src/obj_loader.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+/// UV sphere with a texture seam, a dense mesh the bundled assets lack
+ObjMesh uvSphere(u32 segments) {
+  ObjMesh mesh;
+  const u32 rings = std::max(2u, segments / 2);
+  for (u32 j = 0; j <= rings; ++j)
+    for (u32 i = 0; i <= segments; ++i) {
+      const f32 theta = static_cast<f32>(M_PI) * j / rings, phi = 2 * static_cast<f32>(M_PI) * i / segments;
+      const f32 p[3] = {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+      mesh.vertex_data.insert(mesh.vertex_data.end(), {p[0], p[1], p[2], p[0], p[1], p[2],
+                                                       static_cast<f32>(i) / segments, static_cast<f32>(j) / rings});
+    }
+  for (u32 j = 0; j < rings; ++j)
+    for (u32 i = 0; i < segments; ++i) {
+      const u32 a = j * (segments + 1) + i, b = a + 1, c = a + segments + 1, d = c + 1;
+      mesh.index_data.insert(mesh.index_data.end(), {a, c, b, b, c, d});
+    }
+  mesh.vertex_count = static_cast<u32>(mesh.vertex_data.size() / ObjMesh::vertex_stride);
+  return mesh;
+}
+
+}
+
+int main(int argc, char **argv) {
+  // usage: mesh_simplifier_bench [-s sphere segments] [mesh.obj]...
+  u32 segments = 512;
+  std::vector<std::string> meshes;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-s" && i + 1 < argc)
+      segments = std::max(4, atoi(argv[++i]));
+    else
+      meshes.emplace_back(arg);
+  }
+  if (meshes.empty())
+    for (const auto *name : {"suzanne", "torusknot", "teapot"})
+      meshes.emplace_back(ponos::concat(MODELS_PATH, "/assets/", name, ".obj"));
+  meshes.emplace_back("");
+  printf("%-14s %8s %8s %10s %10s %10s %10s\n", "mesh", "tris", "lod ms", "lod 1", "lod 2", "lod 3", "max error");
+  for (const auto &path : meshes) {
+    ObjMesh mesh;
+    std::string name = "sphere", err;
+    if (path.empty())
+      mesh = uvSphere(segments);
+    else if (!loadObj(path, mesh, err)) {
+      printf("%s: %s\n", path.c_str(), err.c_str());
+      continue;
+    } else
+      name = path.substr(path.find_last_of('/') + 1);
+    auto chain = buildLodChain(mesh.index_data.data(), mesh.index_data.size(), mesh.vertex_data.data(),
+                               mesh.vertex_count, ObjMesh::vertex_stride);
+    printf("%-14s %8zu %8.1f", name.c_str(), mesh.index_data.size() / 3, chain.ms);
+    for (size_t i = 1; i < 4; ++i) {
+      if (i < chain.lods.size())
+        printf(" %10u", chain.lods[i].count / 3);
+      else
+        printf(" %10s", "-");
+    }
+    printf(" %10.5f\n", chain.lods.back().error);
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file obj_loader_bench.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Throughput of the OBJ importer for different worker counts.
+
+#include "../src/obj_loader.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Writes a torus with v/vt/vn, so deduplication has real work to do.
+bool writeTorus(const std::string &path, u32 triangle_count) {
+  FILE *file = fopen(path.c_str(), "w");
+  if (!file)
+    return false;
+  auto n = static_cast<u32>(std::sqrt(triangle_count / 2.0));
+  const f64 pi = 3.14159265358979323846, R = 1.0, r = 0.3;
+  for (u32 i = 0; i < n; ++i)
+    for (u32 j = 0; j < n; ++j) {
+      f64 u = 2 * pi * i / n, v = 2 * pi * j / n;
+      fprintf(file, "v %f %f %f\n", (R + r * cos(v)) * cos(u), r * sin(v), (R + r * cos(v)) * sin(u));
+      fprintf(file, "vn %f %f %f\n", cos(v) * cos(u), sin(v), cos(v) * sin(u));
+    }
+  for (u32 i = 0; i <= n; ++i)
+    for (u32 j = 0; j <= n; ++j)
+      fprintf(file, "vt %f %f\n", f64(i) / n, f64(j) / n);
+  auto vertex = [n](u32 i, u32 j) { return (i % n) * n + (j % n) + 1; };
+  auto uv = [n](u32 i, u32 j) { return i * (n + 1) + j + 1; };
+  for (u32 i = 0; i < n; ++i)
+    for (u32 j = 0; j < n; ++j) {
+      u32 a = vertex(i, j), b = vertex(i + 1, j), c = vertex(i + 1, j + 1), d = vertex(i, j + 1);
+      fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n",
+              a, uv(i, j), a, b, uv(i + 1, j), b, c, uv(i + 1, j + 1), c, d, uv(i, j + 1), d);
+    }
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  // usage: obj_loader_bench [file.obj | triangle count] [repetitions]
+  std::string path = "obj_loader_bench.obj";
+  u32 triangle_count = 4000000;
+  if (argc > 1) {
+    char *end = nullptr;
+    auto count = strtoul(argv[1], &end, 10);
+    if (*end)
+      path = argv[1];
+    else
+      triangle_count = count;
+  }
+  int repetitions = argc > 2 ? std::max(1, atoi(argv[2])) : 3;
+  if (path == "obj_loader_bench.obj") {
+    printf("generating %u triangles into %s\n", triangle_count, path.c_str());
+    if (!writeTorus(path, triangle_count))
+      return -1;
+  }
+  printf("%8s %10s %10s %10s %10s %10s %10s %10s\n",
+         "threads", "total ms", "parse", "resolve", "dedup", "build", "MB/s", "Mtri/s");
+  std::vector<u32> thread_counts;
+  for (u32 threads = 1; threads < std::thread::hardware_concurrency(); threads *= 2)
+    thread_counts.emplace_back(threads);
+  thread_counts.emplace_back(std::max(1u, std::thread::hardware_concurrency()));
+  for (auto threads : thread_counts) {
+    ThreadPool pool(threads);
+    ObjLoadStats best;
+    f64 best_ms = 0;
+    ObjMesh mesh;
+    for (int r = 0; r < repetitions; ++r) {
+      ObjLoadStats stats;
+      std::string err;
+      ponos::Timer timer;
+      if (!loadObj(path, mesh, err, pool, &stats)) {
+        printf("error: %s\n", err.c_str());
+        return -1;
+      }
+      f64 ms = timer.tack();
+      if (r == 0 || ms < best_ms) {
+        best_ms = ms;
+        best = stats;
+      }
+    }
+    printf("%8u %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.2f\n", threads, best_ms,
+           best.parse_ms, best.resolve_ms, best.deduplicate_ms, best.build_ms,
+           best.file_size / (1024.0 * 1024.0) / (best_ms / 1000.0),
+           mesh.index_data.size() / 3 / 1e6 / (best_ms / 1000.0));
+  }
+  return 0;
+}
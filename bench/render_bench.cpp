@@ -0,0 +1,378 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file render_bench.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Frame times of shader configs rendered offscreen, without a window.
+
+#include "../src/gpu_mesh.h"
+#include "../src/gpu_timer.h"
+#include "../src/headless_context.h"
+#include "../src/image.h"
+#include "../src/render_target.h"
+#include "../src/shader_config.h"
+#include "../src/shader_preprocessor.h"
+#include "../src/shader_program.h"
+
+#include <json11.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+struct BenchOptions {
+  u32 frames{200};
+  u32 warmup_frames{10};
+  u32 width{800};
+  u32 height{800};
+  bool cpu_timing{false};
+  std::vector<std::string> configs;
+  std::vector<std::string> meshes;
+  std::string output;
+};
+
+struct FrameStats {
+  f64 min_ms{0};
+  f64 median_ms{0};
+  f64 p99_ms{0};
+  f64 mean_ms{0};
+};
+
+FrameStats frameStats(std::vector<f64> ms) {
+  FrameStats stats;
+  if (ms.empty())
+    return stats;
+  std::sort(ms.begin(), ms.end());
+  stats.min_ms = ms.front();
+  stats.median_ms = ms[ms.size() / 2];
+  stats.p99_ms = ms[std::min(ms.size() - 1, static_cast<size_t>(std::ceil(ms.size() * 0.99)) - 1)];
+  for (auto t : ms)
+    stats.mean_ms += t;
+  stats.mean_ms /= ms.size();
+  return stats;
+}
+
+std::string baseName(const std::string &path) {
+  auto slash = path.find_last_of('/');
+  auto name = slash == std::string::npos ? path : path.substr(slash + 1);
+  return name.substr(0, name.find_last_of('.'));
+}
+
+// column major matrices, as the shaders take them
+
+void lookAt(const f32 eye[3], f32 m[16]) {
+  // looking at the origin, y up
+  f32 f[3] = {-eye[0], -eye[1], -eye[2]};
+  f32 fl = std::sqrt(f[0] * f[0] + f[1] * f[1] + f[2] * f[2]);
+  for (auto &c : f)
+    c /= fl;
+  f32 s[3] = {-f[2], 0, f[0]};
+  f32 sl = std::sqrt(s[0] * s[0] + s[2] * s[2]);
+  s[0] /= sl;
+  s[2] /= sl;
+  f32 u[3] = {s[1] * f[2] - s[2] * f[1], s[2] * f[0] - s[0] * f[2], s[0] * f[1] - s[1] * f[0]};
+  const f32 values[16] = {s[0], u[0], -f[0], 0,
+                          s[1], u[1], -f[1], 0,
+                          s[2], u[2], -f[2], 0,
+                          -(s[0] * eye[0] + s[1] * eye[1] + s[2] * eye[2]),
+                          -(u[0] * eye[0] + u[1] * eye[1] + u[2] * eye[2]),
+                          f[0] * eye[0] + f[1] * eye[1] + f[2] * eye[2], 1};
+  std::copy(values, values + 16, m);
+}
+
+void perspective(f32 fov_y, f32 aspect, f32 near, f32 far, f32 m[16]) {
+  f32 t = 1.f / std::tan(fov_y * 0.5f);
+  std::fill(m, m + 16, 0.f);
+  m[0] = t / aspect;
+  m[5] = t;
+  m[10] = (far + near) / (near - far);
+  m[11] = -1;
+  m[14] = 2 * far * near / (near - far);
+}
+
+GLuint uploadTexture(const std::string &path, std::string &err) {
+  Image image;
+  if (!decodeImage(path, image, err))
+    return 0;
+  GLuint texture = 0;
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D, texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+               image.data.data());
+  glGenerateMipmap(GL_TEXTURE_2D);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  return texture;
+}
+
+/// 1x1 black texture for the samplers the bench does not feed
+/// \param target **[in]** GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP
+GLuint blackTexture(GLenum target) {
+  const u8 black[4] = {0, 0, 0, 255};
+  GLuint texture = 0;
+  glGenTextures(1, &texture);
+  glBindTexture(target, texture);
+  if (target == GL_TEXTURE_CUBE_MAP)
+    for (GLenum face = 0; face < 6; ++face)
+      glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, black);
+  else
+    glTexImage2D(target, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, black);
+  glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  return texture;
+}
+
+/// Renders **options.frames** frames of **config_path** applied to **mesh_path**
+/// \return false if the config, shader or mesh could not be loaded
+bool runBench(const BenchOptions &options, const std::string &config_path, const std::string &mesh_path,
+              RenderTarget &target, std::vector<f64> &frame_ms, std::string &err) {
+  ShaderConfig config;
+  if (!loadShaderConfig(config_path, config, err))
+    return false;
+  ShaderIncludeCache includes;
+  PreprocessedSource vertex_source, fragment_source;
+  auto directory = std::filesystem::path(config_path).parent_path().string();
+  auto defines = featureDefines(config.features, defaultFeatureMask(config.features));
+  if (!includes.preprocess(config.vertex_source, "vertex", directory, vertex_source, err, defines)
+      || !includes.preprocess(config.fragment_source, "fragment", directory, fragment_source, err, defines))
+    return false;
+  circe::gl::Shader vertex_shader, fragment_shader;
+  if (!vertex_shader.compile(vertex_source.code, GL_VERTEX_SHADER)) {
+    err = vertex_source.mapLog(vertex_shader.err);
+    return false;
+  }
+  if (!fragment_shader.compile(fragment_source.code, GL_FRAGMENT_SHADER)) {
+    err = fragment_source.mapLog(fragment_shader.err);
+    return false;
+  }
+  ShaderProgram program;
+  if (!program.link({&vertex_shader, &fragment_shader})) {
+    err = program.err;
+    return false;
+  }
+  MeshFile file;
+  std::string cache_warning;
+  if (!openMeshCached(mesh_path, file, err, nullptr, &cache_warning))
+    return false;
+  if (!cache_warning.empty())
+    printf("%s\n", cache_warning.c_str());
+  GpuMesh mesh;
+  mesh.upload(file);
+  // same scene as the editor: the mesh fit into [-1, 1] at the origin
+  const auto &header = file.header();
+  f32 extent = 0, center[3];
+  for (int d = 0; d < 3; ++d) {
+    extent = std::max(extent, header.bounds_max[d] - header.bounds_min[d]);
+    center[d] = (header.bounds_max[d] + header.bounds_min[d]) * 0.5f;
+  }
+  f32 s = extent > 0 ? 2 / extent : 1;
+  const f32 model[16] = {s, 0, 0, 0, 0, s, 0, 0, 0, 0, s, 0, -center[0] * s, -center[1] * s, -center[2] * s, 1};
+  FrameBlockData frame;
+  const f32 eye[3] = {0, 1.5f, 4};
+  lookAt(eye, frame.view);
+  perspective(0.785f, static_cast<f32>(options.width) / options.height, 0.1f, 100.f, frame.projection);
+  std::copy(eye, eye + 3, frame.camera_position);
+  frame.screen_resolution[0] = static_cast<f32>(options.width);
+  frame.screen_resolution[1] = static_cast<f32>(options.height);
+  SceneBlockData scene;
+  scene.light = config.light;
+  scene.material = config.material;
+  UniformBlockBuffer frame_block{"FrameBlock", 0, sizeof(FrameBlockData)};
+  UniformBlockBuffer scene_block{"SceneBlock", 1, sizeof(SceneBlockData)};
+  bool uses_frame_block = frame_block.attach(program.id());
+  bool uses_scene_block = scene_block.attach(program.id());
+  // no environment lighting, as in the editor before an .hdr is loaded
+  EnvironmentBlockData environment;
+  UniformBlockBuffer environment_block{"EnvironmentBlock", 2, sizeof(EnvironmentBlockData)};
+  bool uses_environment_block = environment_block.attach(program.id());
+  // textures
+  GLuint textures[ShaderConfig::texture_count]{};
+  program.use();
+  for (int i = 0; i < ShaderConfig::texture_count; ++i) {
+    if (config.textures[i].empty())
+      continue;
+    textures[i] = uploadTexture(config.textures[i], err);
+    if (!textures[i]) {
+      glDeleteTextures(i, textures);
+      return false;
+    }
+    program.setUniform(ponos::concat("channel", i), i);
+  }
+  // the environment takes the units after the channels, as in the editor: a
+  // cube and a 2D sampler left on unit 0 would fail every draw
+  const GLenum environment_targets[2] = {GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D};
+  const char *environment_samplers[2] = {"environmentMap", "brdfLut"};
+  GLuint environment_textures[2]{};
+  for (int i = 0; i < 2; ++i)
+    if (program.hasUniform(environment_samplers[i])) {
+      environment_textures[i] = blackTexture(environment_targets[i]);
+      program.setUniform(environment_samplers[i], 2 + i);
+    }
+  GLint model_location = program.locateUniform("model");
+  // render
+  GpuTimer gpu_timer(8);
+  bool use_gpu_timer = !options.cpu_timing && GpuTimer::supported();
+  ponos::Timer clock;
+  frame_ms.clear();
+  glEnable(GL_DEPTH_TEST);
+  for (u32 f = 0; f < options.warmup_frames + options.frames; ++f) {
+    bool measured = f >= options.warmup_frames;
+    ponos::Timer cpu_timer;
+    if (measured && use_gpu_timer)
+      gpu_timer.begin();
+    target.bind();
+    glClearColor(0, 0, 0, 1);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    program.use();
+    if (model_location >= 0)
+      glUniformMatrix4fv(model_location, 1, GL_FALSE, model);
+    if (uses_frame_block) {
+      frame.time = static_cast<f32>(clock.tack() / 1000);
+      frame_block.update(&frame);
+      frame_block.bind();
+    }
+    if (uses_scene_block) {
+      scene_block.update(&scene);
+      scene_block.bind();
+    }
+    if (uses_environment_block) {
+      environment_block.update(&environment);
+      environment_block.bind();
+    }
+    for (int i = 0; i < ShaderConfig::texture_count; ++i)
+      if (textures[i]) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+      }
+    for (int i = 0; i < 2; ++i)
+      if (environment_textures[i]) {
+        glActiveTexture(GL_TEXTURE2 + i);
+        glBindTexture(environment_targets[i], environment_textures[i]);
+      }
+    mesh.draw();
+    if (!measured)
+      glFinish();
+    else if (use_gpu_timer) {
+      gpu_timer.end();
+      gpu_timer.collect(frame_ms);
+    } else {
+      // without timer queries the frame is measured from the CPU, up to its completion
+      glFinish();
+      frame_ms.emplace_back(cpu_timer.tack());
+    }
+  }
+  if (use_gpu_timer)
+    gpu_timer.collect(frame_ms, true);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  for (auto texture : textures)
+    if (texture)
+      glDeleteTextures(1, &texture);
+  for (auto texture : environment_textures)
+    if (texture)
+      glDeleteTextures(1, &texture);
+  return true;
+}
+
+}
+
+int main(int argc, char **argv) {
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "-n" && has_value)
+      options.frames = std::max(1, atoi(argv[++i]));
+    else if (arg == "-w" && has_value)
+      options.width = std::max(1, atoi(argv[++i]));
+    else if (arg == "-h" && has_value)
+      options.height = std::max(1, atoi(argv[++i]));
+    else if (arg == "-m" && has_value)
+      options.meshes.emplace_back(argv[++i]);
+    else if (arg == "-o" && has_value)
+      options.output = argv[++i];
+    else if (arg == "--cpu")
+      options.cpu_timing = true;
+    else if (arg[0] == '-') {
+      printf("usage: %s [-n frames] [-w width] [-h height] [-m mesh.obj]... [-o results.json] [--cpu] "
+             "[config.json]...\n", argv[0]);
+      return -1;
+    } else
+      options.configs.emplace_back(arg);
+  }
+  if (options.configs.empty())
+    for (const auto *name : {"blinn_phong", "pbr", "toon_shader", "normal_mapping", "topographical_map"})
+      options.configs.emplace_back(ponos::concat(SHADERS_PATH, "/", name, "/", name, ".json"));
+  if (options.meshes.empty())
+    options.meshes.emplace_back(ponos::concat(MODELS_PATH, "/assets/suzanne.obj"));
+
+  HeadlessContext context;
+  std::string err;
+  if (!context.create(err)) {
+    printf("%s\n", err.c_str());
+    return -1;
+  }
+  RenderTarget target;
+  if (!target.resize(options.width, options.height)) {
+    printf("incomplete %ux%u framebuffer\n", options.width, options.height);
+    return -1;
+  }
+  const char *timing = !options.cpu_timing && GpuTimer::supported() ? "gpu" : "cpu";
+  printf("%s | %ux%u | %u frames | %s timing\n", context.renderer().c_str(), options.width, options.height,
+         options.frames, timing);
+  printf("%-20s %-12s %10s %10s %10s %10s\n", "config", "mesh", "min ms", "median ms", "p99 ms", "mean ms");
+  json11::Json::array results;
+  int result = 0;
+  for (const auto &config : options.configs)
+    for (const auto &mesh : options.meshes) {
+      std::vector<f64> frame_ms;
+      if (!runBench(options, config, mesh, target, frame_ms, err)) {
+        printf("%-20s %-12s %s\n", baseName(config).c_str(), baseName(mesh).c_str(), err.c_str());
+        result = -1;
+        continue;
+      }
+      auto stats = frameStats(frame_ms);
+      printf("%-20s %-12s %10.3f %10.3f %10.3f %10.3f\n", baseName(config).c_str(), baseName(mesh).c_str(),
+             stats.min_ms, stats.median_ms, stats.p99_ms, stats.mean_ms);
+      results.emplace_back(json11::Json::object{
+          {"config", baseName(config)}, {"mesh", baseName(mesh)},
+          {"frames", static_cast<int>(frame_ms.size())},
+          {"min_ms", stats.min_ms}, {"median_ms", stats.median_ms},
+          {"p99_ms", stats.p99_ms}, {"mean_ms", stats.mean_ms}});
+    }
+  if (!options.output.empty()) {
+    std::ofstream out(options.output);
+    out << json11::Json(json11::Json::object{
+        {"renderer", context.renderer()}, {"timing", timing},
+        {"width", static_cast<int>(options.width)}, {"height", static_cast<int>(options.height)},
+        {"results", results}}).dump() << "\n";
+    if (!out) {
+      printf("could not write %s\n", options.output.c_str());
+      return -1;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,72 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file terrain_bench.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Throughput of the procedural terrain generator for different resolutions and worker counts.
+
+#include "../src/terrain.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char **argv) {
+  // usage: terrain_bench [max resolution] [repetitions]
+  u32 max_resolution = argc > 1 ? static_cast<u32>(atoi(argv[1])) : 4096;
+  int repetitions = argc > 2 ? std::max(1, atoi(argv[2])) : 3;
+  std::vector<u32> thread_counts;
+  for (u32 threads = 1; threads < std::thread::hardware_concurrency(); threads *= 2)
+    thread_counts.emplace_back(threads);
+  thread_counts.emplace_back(std::max(1u, std::thread::hardware_concurrency()));
+  printf("fBm with %u octaves\n", TerrainParams().octaves);
+  printf("%10s %8s %10s %12s %12s %10s %12s\n",
+         "resolution", "threads", "fBm ms", "Msamples/s", "scalar Ms/s", "normal ms", "Msamples/s");
+  for (u32 resolution = 256; resolution <= max_resolution; resolution *= 2)
+    for (auto threads : thread_counts) {
+      ThreadPool pool(threads);
+      TerrainParams params;
+      params.resolution = resolution;
+      Heightfield field;
+      // best of repetitions
+      auto best = [&](const std::function<void()> &f) {
+        f64 best_ms = 0;
+        for (int r = 0; r < repetitions; ++r) {
+          ponos::Timer timer;
+          f();
+          f64 ms = timer.tack();
+          if (r == 0 || ms < best_ms)
+            best_ms = ms;
+        }
+        return best_ms;
+      };
+      params.use_simd = false;
+      f64 scalar_ms = best([&] { generateHeights(params, field, pool); });
+      params.use_simd = true;
+      f64 fbm_ms = best([&] { generateHeights(params, field, pool); });
+      f64 normals_ms = best([&] { computeNormals(field, true, pool); });
+      f64 samples = f64(resolution) * resolution / 1e6;
+      printf("%10u %8u %10.1f %12.1f %12.1f %10.1f %12.1f\n", resolution, threads, fbm_ms,
+             samples / (fbm_ms / 1000), samples / (scalar_ms / 1000), normals_ms, samples / (normals_ms / 1000));
+    }
+  return 0;
+}
@@ -0,0 +1,16 @@
+include(ExternalProject)
+ExternalProject_Add(
+        stb PREFIX stb
+        URL "https://github.com/nothings/stb/archive/master.zip"
+        # header only
+        CONFIGURE_COMMAND ""
+        BUILD_COMMAND ""
+        INSTALL_COMMAND ""
+)
+
+ExternalProject_Get_Property(stb SOURCE_DIR)
+set(STB_INCLUDES
+        ${SOURCE_DIR}
+        )
+
+set(STB_INCLUDES ${STB_INCLUDES} CACHE STRING "")
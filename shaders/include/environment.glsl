@@ -0,0 +1,37 @@
+// image based lighting of the environment loaded in the editor, see
+// src/environment.h for how each part is precomputed
+layout(std140, binding = 2) uniform EnvironmentBlock {
+  vec4 irradianceSH[9];
+  float environmentLevels;
+  float environmentIntensity;
+  int environmentEnabled;
+};
+// prefiltered radiance, mip l holds roughness l / (environmentLevels - 1)
+uniform samplerCube environmentMap;
+// split sum scale (r) and bias (g) of F0, indexed by (n.v, roughness)
+uniform sampler2D brdfLut;
+
+// diffuse radiance reflected by a white lambertian surface facing n
+vec3 environmentIrradiance(vec3 n) {
+  vec3 e = irradianceSH[0].rgb * 0.282095
+      + irradianceSH[1].rgb * 0.488603 * n.y
+      + irradianceSH[2].rgb * 0.488603 * n.z
+      + irradianceSH[3].rgb * 0.488603 * n.x
+      + irradianceSH[4].rgb * 1.092548 * n.x * n.y
+      + irradianceSH[5].rgb * 1.092548 * n.y * n.z
+      + irradianceSH[6].rgb * 0.315392 * (3.0 * n.z * n.z - 1.0)
+      + irradianceSH[7].rgb * 1.092548 * n.x * n.z
+      + irradianceSH[8].rgb * 0.546274 * (n.x * n.x - n.y * n.y);
+  return max(e, vec3(0.0)) * environmentIntensity;
+}
+
+// GGX prefiltered radiance around the reflection vector r
+vec3 environmentSpecular(vec3 r, float roughness) {
+  return textureLod(environmentMap, r, roughness * (environmentLevels - 1.0)).rgb * environmentIntensity;
+}
+
+// split sum approximation of the specular integral
+vec3 environmentBRDF(vec3 F0, float NdotV, float roughness) {
+  vec2 ab = texture(brdfLut, vec2(NdotV, roughness)).rg;
+  return F0 * ab.x + ab.y;
+}
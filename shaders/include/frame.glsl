@@ -0,0 +1,8 @@
+// per frame uniforms, filled by the editor every frame
+layout(std140, binding = 0) uniform FrameBlock {
+  mat4 view;
+  mat4 projection;
+  vec3 cameraPosition;
+  float time;
+  vec2 screenResolution;
+};
@@ -0,0 +1,21 @@
+// per instance data, filled by the editor in instancing mode
+struct Instance {
+  mat4 model;
+  vec4 color;
+};
+
+layout(std430, binding = 2) readonly buffer InstanceBlock {
+  Instance instances[];
+};
+// reserved uniform, 0 when a single object is drawn
+uniform int instanceCount;
+
+// model matrix of the current instance
+mat4 instanceModel(mat4 model) {
+  return instanceCount > 0 ? instances[gl_InstanceID].model * model : model;
+}
+
+// color override of the current instance
+vec4 instanceColor() {
+  return instanceCount > 0 ? instances[gl_InstanceID].color : vec4(1.0);
+}
@@ -0,0 +1,20 @@
+// scene wide uniforms, filled by the editor from the shader config
+struct Light {
+  vec3 direction; // directional light direction
+  vec3 point; // point light position
+  vec3 ambient;
+  vec3 diffuse;
+  vec3 specular;
+};
+
+struct Material {
+  vec3 kAmbient;
+  vec3 kDiffuse;
+  vec3 kSpecular;
+  float shininess;
+};
+
+layout(std140, binding = 1) uniform SceneBlock {
+  Light light;
+  Material material;
+};
@@ -0,0 +1,46 @@
+// cascaded shadow map of the directional light (light.direction), rendered
+// by the editor when shadows are on, see src/shadow_cascades.h
+layout(std140, binding = 3) uniform ShadowBlock {
+  mat4 shadowMatrices[4];
+  vec4 shadowTiles[4];
+  vec4 shadowSplits;
+  int shadowCascadeCount;
+  float shadowBias;
+};
+// depth atlas, one tile per cascade
+uniform sampler2DShadow shadowMap;
+
+// finest cascade covering the world position p, -1 if none does
+int shadowCascade(vec3 p) {
+  vec2 atlas = vec2(textureSize(shadowMap, 0));
+  for (int c = 0; c < shadowCascadeCount; ++c) {
+    vec3 s = (shadowMatrices[c] * vec4(p, 1.0)).xyz;
+    // keeps the PCF kernel inside the tile
+    vec2 margin = 1.5 / (atlas * shadowTiles[c].zw);
+    if (all(greaterThanEqual(s.xy, margin)) && all(lessThanEqual(s.xy, 1.0 - margin)) && s.z <= 1.0)
+      return c;
+  }
+  return -1;
+}
+
+// fraction of the light reaching the world position p (3x3 PCF)
+float shadowFactor(vec3 p) {
+  int c = shadowCascade(p);
+  if (c < 0)
+    return 1.0;
+  vec3 s = (shadowMatrices[c] * vec4(p, 1.0)).xyz;
+  vec2 uv = shadowTiles[c].xy + s.xy * shadowTiles[c].zw;
+  vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0));
+  float lit = 0.0;
+  for (int y = -1; y <= 1; ++y)
+    for (int x = -1; x <= 1; ++x)
+      lit += texture(shadowMap, vec3(uv + vec2(x, y) * texel, s.z - shadowBias));
+  return lit / 9.0;
+}
+
+// debug tint of the cascade covering p
+vec3 shadowCascadeColor(vec3 p) {
+  const vec3 colors[4] = vec3[](vec3(1.0, 0.4, 0.4), vec3(0.4, 1.0, 0.4), vec3(0.4, 0.4, 1.0), vec3(1.0, 1.0, 0.4));
+  int c = shadowCascade(p);
+  return c < 0 ? vec3(1.0) : colors[c];
+}
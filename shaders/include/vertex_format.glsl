@@ -0,0 +1,23 @@
+// reserved uniforms describing the vertex format of the current mesh, the
+// defaults match float vertices
+uniform vec3 positionScale = vec3(1.0);
+uniform vec3 positionOffset = vec3(0.0);
+// 0: xyz, 1: octahedral
+uniform int normalEncoding = 0;
+
+// object space position of a (possibly 16 bit normalized) position attribute
+vec3 decodePosition(vec3 position) {
+  return position * positionScale + positionOffset;
+}
+
+// unit normal, tangent or bitangent of a float, 10:10:10:2 or octahedral attribute
+vec3 decodeNormal(vec3 normal) {
+  if (normalEncoding == 1) {
+    // 2 component attributes come with z = 0
+    vec3 n = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+  }
+  return normalize(normal);
+}
@@ -0,0 +1,35 @@
+#version 440 core
+layout(location = 0) out vec4 fragColor;
+
+in vec3 fNormal;
+in vec3 fPosition;
+in vec2 fUV;
+flat in vec4 fColor;
+
+#include "../include/scene.glsl"
+#include "../include/frame.glsl"
+
+void main() {
+  // Blinn-Phong, the diffuse color is modulated by the instance color
+  // N - surface normal
+  // L - light direction
+  // V - view direction
+  // H - half-way between V and L
+  // R - direction of reflection (ignored)
+  // (all vectors leave the surface)
+  vec3 N = normalize(fNormal);
+  vec3 L = normalize(light.point - fPosition);
+  vec3 V = normalize(cameraPosition - fPosition);
+  vec3 H = normalize(L + V);
+  // cosine of the angle between N and L is proportional to light intensity
+  float lambertian = max(dot(N, L), 0.0);
+  // specular reflection is proportional to V an H alignment
+  // material shininess property controls specular size
+  float specular = pow(max(dot(V, H), 0.0), material.shininess);
+  // final color is then calculated mixing all contributions
+  vec3 lightIntensity = (light.ambient * material.kAmbient +
+                         light.diffuse * material.kDiffuse * fColor.rgb * lambertian +
+                         light.specular * material.kSpecular * specular) *
+                        vec3(1, 1, 1);
+  fragColor = vec4(lightIntensity, 1.0);
+}
@@ -8,34 +8,27 @@ in vec3 tLightPos;
 in vec3 tViewPos;
 in vec3 tFPos;
 
-struct Light {
-    vec3 direction;// directional light direction
-    vec3 point;// point light position
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-
-struct Material {
-    vec3 kAmbient;
-    vec3 kDiffuse;
-    vec3 kSpecular;
-    float shininess;
-};
-
-layout(location = 1) uniform Light light;
-layout(location = 6) uniform Material material;
-layout(location = 10) uniform vec3 cameraPosition;
-layout(location = 14) uniform vec2 screenResolution;
+#include "../include/scene.glsl"
+#include "../include/frame.glsl"
 
 uniform sampler2D channel0;
 uniform sampler2D channel1;
 
 void main() {
-    // obtain normal from normal map in range [0,1]
-    vec3 normal = texture(channel1, fUV).rgb;
-    // transform normal vector to range [-1,1]
-    normal = normalize(normal * 2.0 - 1.0);
+#ifdef NORMAL_MAP
+    // obtain normal xy from normal map in range [0,1] and transform it to
+    // range [-1,1], z is rebuilt so two channel (BC5) maps work as well
+    vec2 xy = texture(channel1, fUV).rg * 2.0 - 1.0;
+    vec3 normal = vec3(xy, sqrt(max(0.0, 1.0 - dot(xy, xy))));
+#else
+    // the interpolated normal is the z axis of tangent space
+    vec3 normal = vec3(0.0, 0.0, 1.0);
+#endif
+#ifdef ALBEDO_MAP
+    vec3 albedo = texture(channel0, fUV).rgb;
+#else
+    vec3 albedo = material.kDiffuse;
+#endif
     // Blinn-Phong
     // N - surface normal
     // L - light direction
@@ -55,7 +48,7 @@ void main() {
     float specular = pow(max(dot(V, H), 0.0), material.shininess);
     // final color is then calculated mixing all contributions
     vec3 lightIntensity = (light.ambient * material.kAmbient +
-    light.diffuse * texture(channel0, fUV).rgb * lambertian +
+    light.diffuse * albedo * lambertian +
     light.specular * material.kSpecular * specular) *
     vec3(1, 1, 1);
     fragColor = vec4(lightIntensity, 1.0);
@@ -1,9 +1,9 @@
 #version 440 core
-layout(location = 0) in vec3 position;
-layout(location = 1) in vec3 normal;
+layout(location = 0) in vec3 vPosition;
+layout(location = 1) in vec3 vNormal;
 layout(location = 2) in vec2 texcoord;
-layout(location = 3) in vec3 tangent;
-layout(location = 4) in vec3 bitangent;
+layout(location = 3) in vec3 vTangent;
+layout(location = 4) in vec3 vBitangent;
 
 out vec3 fNormal;
 out vec3 fPosition;
@@ -12,21 +12,15 @@ out vec3 tLightPos;
 out vec3 tViewPos;
 out vec3 tFPos;
 
-struct Light {
-    vec3 direction;// directional light direction
-    vec3 point;// point light position
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-
-layout(location = 1) uniform Light light;
-layout(location = 10) uniform vec3 cameraPosition;
+#include "../include/scene.glsl"
 layout(location = 11) uniform mat4 model;
-layout(location = 12) uniform mat4 view;
-layout(location = 13) uniform mat4 projection;
+#include "../include/frame.glsl"
+#include "../include/vertex_format.glsl"
 
 void main() {
+    vec3 position = decodePosition(vPosition);
+    vec3 normal = decodeNormal(vNormal);
+    vec3 tangent = decodeNormal(vTangent);
     gl_Position = projection * view * model * vec4(position, 1.0);
     fPosition = vec3(model * vec4(position, 1.0));
     fNormal = mat3(transpose(inverse(model))) * normal;
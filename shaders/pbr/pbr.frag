@@ -3,10 +3,10 @@ layout(location = 0) out vec4 fragColor;
 
 in vec3 fNormal;
 in vec3 fPosition;
-in vec3 fUV;
+in vec2 fUV;
 
-layout(location = 10) uniform vec3 cameraPosition;
-layout(location = 14) uniform vec2 screenResolution;
+#include "../include/frame.glsl"
+#include "../include/environment.glsl"
 
 // material parameters
 uniform vec3 albedo;
@@ -59,6 +59,11 @@ vec3 fresnelSchlick(float cosTheta, vec3 F0)
 {
     return F0 + (1.0 - F0) * pow(max(1.0 - cosTheta, 0.0), 5.0);
 }
+// ----------------------------------------------------------------------------
+vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
+{
+    return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(max(1.0 - cosTheta, 0.0), 5.0);
+}
 
 void main() {
     vec3 N = normalize(fNormal);
@@ -107,9 +112,16 @@ void main() {
         Lo += (kD * albedo / PI + specular) * radiance * NdotL;// note that we already multiplied the BRDF by the Fresnel (kS) so we won't multiply by kS again
     }
 
-    // ambient lighting (note that the next IBL tutorial will replace
-    // this ambient lighting with environment lighting).
+    // ambient lighting, from the environment if one is loaded
     vec3 ambient = vec3(0.03) * albedo * ao;
+    if (environmentEnabled != 0) {
+        float NdotV = max(dot(N, V), 0.0);
+        vec3 F = fresnelSchlickRoughness(NdotV, F0, roughness);
+        vec3 kD = (1.0 - F) * (1.0 - metallic);
+        vec3 diffuse = environmentIrradiance(N) * albedo;
+        vec3 specular = environmentSpecular(reflect(-V, N), roughness) * environmentBRDF(F, NdotV, roughness);
+        ambient = (kD * diffuse + specular) * ao;
+    }
 
     vec3 color = ambient + Lo;
 
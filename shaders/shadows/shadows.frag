@@ -0,0 +1,30 @@
+#version 440 core
+layout(location = 0) out vec4 fragColor;
+
+in vec3 fNormal;
+in vec3 fPosition;
+in vec2 fUV;
+
+#include "../include/scene.glsl"
+#include "../include/frame.glsl"
+#include "../include/shadows.glsl"
+
+// 1 tints each cascade with a different color
+uniform float showCascades;
+
+void main() {
+  // Blinn-Phong under the directional light, only the ambient term
+  // reaches shadowed surfaces
+  vec3 N = normalize(fNormal);
+  vec3 L = normalize(light.direction);
+  vec3 V = normalize(cameraPosition - fPosition);
+  vec3 H = normalize(L + V);
+  float lambertian = max(dot(N, L), 0.0);
+  float specular = lambertian > 0.0 ? pow(max(dot(N, H), 0.0), material.shininess) : 0.0;
+  float shadow = shadowFactor(fPosition);
+  vec3 color = light.ambient * material.kAmbient +
+               shadow * (light.diffuse * material.kDiffuse * lambertian +
+                         light.specular * material.kSpecular * specular);
+  color *= mix(vec3(1.0), shadowCascadeColor(fPosition), showCascades);
+  fragColor = vec4(color, 1.0);
+}
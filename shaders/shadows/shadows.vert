@@ -0,0 +1,23 @@
+#version 440 core
+layout(location = 0) in vec3 vPosition;
+layout(location = 1) in vec3 vNormal;
+layout(location = 2) in vec2 texcoord;
+
+out vec3 fNormal;
+out vec3 fPosition;
+out vec2 fUV;
+
+layout(location = 11) uniform mat4 model;
+#include "../include/frame.glsl"
+#include "../include/vertex_format.glsl"
+#include "../include/instancing.glsl"
+
+void main() {
+  vec3 position = decodePosition(vPosition);
+  vec3 normal = decodeNormal(vNormal);
+  mat4 m = instanceModel(model);
+  fPosition = vec3(m * vec4(position, 1.0));
+  gl_Position = projection * view * vec4(fPosition, 1.0);
+  fNormal = mat3(transpose(inverse(m))) * normal;
+  fUV = texcoord;
+}
@@ -3,27 +3,10 @@ layout(location = 0) out vec4 fragColor;
 
 in vec3 fNormal;
 in vec3 fPosition;
-in vec3 fUV;
+in vec2 fUV;
 
-struct Light {
-  vec3 direction; // directional light direction
-  vec3 point; // point light position
-  vec3 ambient;
-  vec3 diffuse;
-  vec3 specular;
-};
-
-struct Material {
-  vec3 kAmbient;
-  vec3 kDiffuse;
-  vec3 kSpecular;
-  float shininess;
-};
-
-layout(location = 1) uniform Light light;
-layout(location = 6) uniform Material material;
-layout(location = 10) uniform vec3 cameraPosition;
-layout(location = 14) uniform vec2 screenResolution;
+#include "../include/scene.glsl"
+#include "../include/frame.glsl"
 
 void main() {
   vec3 N = normalize(fNormal);
@@ -1,6 +1,6 @@
 #version 440 core
-layout(location = 0) in vec3 position;
-layout(location = 1) in vec3 normal;
+layout(location = 0) in vec3 vPosition;
+layout(location = 1) in vec3 vNormal;
 layout(location = 2) in vec2 texcoord;
 
 out vec3 fNormal;
@@ -8,10 +8,12 @@ out vec3 fPosition;
 out vec2 fUV;
 
 layout(location = 11) uniform mat4 model;
-layout(location = 12) uniform mat4 view;
-layout(location = 13) uniform mat4 projection;
+#include "../include/frame.glsl"
+#include "../include/vertex_format.glsl"
 
 void main() {
+  vec3 position = decodePosition(vPosition);
+  vec3 normal = decodeNormal(vNormal);
   gl_Position = projection * view * model * vec4(position, 1.0);
   fPosition = vec3(model * vec4(position, 1.0));
   fNormal = mat3(transpose(inverse(model))) * normal;
@@ -5,25 +5,8 @@ in vec3 fNormal;
 in vec3 fPosition;
 in vec2 fUV;
 
-struct Light {
-  vec3 direction; // directional light direction
-  vec3 point; // point light position
-  vec3 ambient;
-  vec3 diffuse;
-  vec3 specular;
-};
-
-struct Material {
-  vec3 kAmbient;
-  vec3 kDiffuse;
-  vec3 kSpecular;
-  float shininess;
-};
-
-layout(location = 1) uniform Light light;
-layout(location = 6) uniform Material material;
-layout(location = 10) uniform vec3 cameraPosition;
-layout(location = 14) uniform vec2 screenResolution;
+#include "../include/scene.glsl"
+#include "../include/frame.glsl"
 
 const int levelCount = 10;
 const float maxHeight = 1.0;
@@ -43,33 +26,7 @@ float map3(in float value, in float start1, in float stop1, in float start2, in
   return r;
 }
 
-vec4 hsv_to_rgb(float h, float s, float v, float a)
-{
-	float c = v * s;
-	h = mod((h * 6.0), 6.0);
-	float x = c * (1.0 - abs(mod(h, 2.0) - 1.0));
-	vec4 color;
-
-	if (0.0 <= h && h < 1.0) {
-		color = vec4(c, x, 0.0, a);
-	} else if (1.0 <= h && h < 2.0) {
-		color = vec4(x, c, 0.0, a);
-	} else if (2.0 <= h && h < 3.0) {
-		color = vec4(0.0, c, x, a);
-	} else if (3.0 <= h && h < 4.0) {
-		color = vec4(0.0, x, c, a);
-	} else if (4.0 <= h && h < 5.0) {
-		color = vec4(x, 0.0, c, a);
-	} else if (5.0 <= h && h < 6.0) {
-		color = vec4(c, 0.0, x, a);
-	} else {
-		color = vec4(0.0, 0.0, 0.0, a);
-	}
-
-	color.rgb += v - c;
-
-	return color;
-}
+#include "../include/color.glsl"
 
 vec3 hsbValueScale(in float hue, in float i) {
   vec3 scale = vec3(0.0);
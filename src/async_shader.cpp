@@ -0,0 +1,122 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file async_shader.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "async_shader.h"
+
+#include <cstring>
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace {
+
+bool parallel_compile = false;
+
+}
+
+bool enableParallelShaderCompile(GLADloadproc get_proc_address) {
+  const char *thread_function = nullptr;
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i = 0; i < count && !thread_function; ++i) {
+    auto *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+    if (!name)
+      continue;
+    // both share GL_COMPLETION_STATUS
+    if (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0)
+      thread_function = "glMaxShaderCompilerThreadsKHR";
+    else if (std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0)
+      thread_function = "glMaxShaderCompilerThreadsARB";
+  }
+  parallel_compile = thread_function != nullptr;
+  if (parallel_compile && get_proc_address) {
+    using MaxThreadsFunction = void (*)(GLuint);
+    auto max_threads = reinterpret_cast<MaxThreadsFunction>(get_proc_address(thread_function));
+    // 0xFFFFFFFF lets the driver pick
+    if (max_threads)
+      max_threads(0xFFFFFFFF);
+  }
+  return parallel_compile;
+}
+
+bool parallelShaderCompileEnabled() {
+  return parallel_compile;
+}
+
+bool compileCompleted(GLuint object, bool program) {
+  if (!parallel_compile || !object)
+    return true;
+  GLint completed = GL_FALSE;
+  if (program)
+    glGetProgramiv(object, GL_COMPLETION_STATUS_KHR, &completed);
+  else
+    glGetShaderiv(object, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed == GL_TRUE;
+}
+
+AsyncShader::~AsyncShader() {
+  destroy();
+}
+
+void AsyncShader::compile(const std::string &source, GLenum type) {
+  destroy();
+  id_ = glCreateShader(type);
+  const char *text = source.c_str();
+  glShaderSource(id_, 1, &text, nullptr);
+  glCompileShader(id_);
+}
+
+bool AsyncShader::ready() const {
+  return finished_ || compileCompleted(id_, false);
+}
+
+bool AsyncShader::finish() {
+  if (finished_ || !id_)
+    return compiled_;
+  finished_ = true;
+  GLint status = GL_FALSE;
+  glGetShaderiv(id_, GL_COMPILE_STATUS, &status);
+  compiled_ = status == GL_TRUE;
+  err.clear();
+  if (!compiled_) {
+    GLint length = 0;
+    glGetShaderiv(id_, GL_INFO_LOG_LENGTH, &length);
+    err.resize(length);
+    if (length)
+      glGetShaderInfoLog(id_, length, nullptr, &err[0]);
+  }
+  return compiled_;
+}
+
+void AsyncShader::destroy() {
+  if (id_)
+    glDeleteShader(id_);
+  id_ = 0;
+  finished_ = compiled_ = false;
+  err.clear();
+}
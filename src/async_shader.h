@@ -0,0 +1,84 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file async_shader.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Shader compilation that does not wait for the driver (parallel shader compile).
+
+#ifndef GLSL_EXPERIMENTS_ASYNC_SHADER_H
+#define GLSL_EXPERIMENTS_ASYNC_SHADER_H
+
+#include <circe/circe.h>
+
+/// Lets the driver compile and link on its own threads
+/// (GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile), asking
+/// for as many threads as it wants. Requires a current context.
+/// \param get_proc_address **[in | optional]** loader of the context, used to
+/// set the thread count (the driver default is kept without it)
+/// \return false if the driver has neither extension. Compiles and links then
+/// complete synchronously, when their status is first queried.
+bool enableParallelShaderCompile(GLADloadproc get_proc_address = nullptr);
+/// \return true if enableParallelShaderCompile found the extension
+bool parallelShaderCompileEnabled();
+/// \param object **[in]** shader or program object
+/// \param program **[in]** true if **object** is a program
+/// \return true if querying the compile/link status of **object** does not
+/// wait for the driver (always true without parallel compile)
+bool compileCompleted(GLuint object, bool program);
+
+/// Shader object compiled without waiting for the driver. Unlike
+/// circe::gl::Shader, compile() returns as soon as the commands are issued,
+/// and the status is only queried by finish().
+///
+/// Usage:
+///   shader.compile(source, GL_VERTEX_SHADER);
+///   // later frames
+///   if (shader.ready() && !shader.finish())
+///     log(shader.err);
+class AsyncShader {
+public:
+  AsyncShader() = default;
+  AsyncShader(const AsyncShader &) = delete;
+  AsyncShader &operator=(const AsyncShader &) = delete;
+  ~AsyncShader();
+  /// Issues the compilation of **source**, replacing the previous shader
+  /// \param source **[in]**
+  /// \param type **[in]** GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...
+  void compile(const std::string &source, GLenum type);
+  /// \return true if finish() will not block
+  [[nodiscard]] bool ready() const;
+  /// Waits for the compilation if it is still running.
+  /// \return true if the shader compiled (**err** holds the log otherwise)
+  bool finish();
+  void destroy();
+  [[nodiscard]] GLuint id() const { return id_; }
+  [[nodiscard]] bool compiled() const { return compiled_; }
+
+  std::string err;
+private:
+  GLuint id_{0};
+  bool finished_{false};
+  bool compiled_{false};
+};
+
+#endif //GLSL_EXPERIMENTS_ASYNC_SHADER_H
@@ -0,0 +1,604 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file environment.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "environment.h"
+#include "hash.h"
+#include "mapped_file.h"
+#include "vertex_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr f32 pi = 3.14159265358979f;
+/// SH basis constants, bands 0 to 2
+constexpr f32 sh_c0 = 0.282095f;
+constexpr f32 sh_c1 = 0.488603f;
+constexpr f32 sh_c2 = 1.092548f;
+constexpr f32 sh_c3 = 0.315392f;
+constexpr f32 sh_c4 = 0.546274f;
+/// Cosine lobe convolution (A_l / pi) of each coefficient
+constexpr f32 sh_cosine[9] = {1, 2.f / 3, 2.f / 3, 2.f / 3, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f};
+
+void shBasis(f32 x, f32 y, f32 z, f32 *basis) {
+  basis[0] = sh_c0;
+  basis[1] = sh_c1 * y;
+  basis[2] = sh_c1 * z;
+  basis[3] = sh_c1 * x;
+  basis[4] = sh_c2 * x * y;
+  basis[5] = sh_c2 * y * z;
+  basis[6] = sh_c3 * (3 * z * z - 1);
+  basis[7] = sh_c2 * x * z;
+  basis[8] = sh_c4 * (x * x - y * y);
+}
+
+/// \return log2 of the largest power of two <= **value**
+u32 floorLog2(u32 value) {
+  u32 log = 0;
+  while (value >>= 1)
+    log++;
+  return log;
+}
+
+/// Cube map with rgb float texels, one entry per mip
+struct CubeLevel {
+  u32 size{0};
+  std::vector<f32> rgb; //!< 6 faces, GL order
+};
+
+/// \param face **[in]** GL order (+x, -x, +y, -y, +z, -z)
+/// \param s **[in]** [-1, 1]
+/// \param t **[in]** [-1, 1], grows with the texel row
+/// \param d **[out]** normalized direction
+void faceDirection(u32 face, f32 s, f32 t, f32 *d) {
+  switch (face) {
+  case 0: d[0] = 1, d[1] = -t, d[2] = -s;
+    break;
+  case 1: d[0] = -1, d[1] = -t, d[2] = s;
+    break;
+  case 2: d[0] = s, d[1] = 1, d[2] = t;
+    break;
+  case 3: d[0] = s, d[1] = -1, d[2] = -t;
+    break;
+  case 4: d[0] = s, d[1] = -t, d[2] = 1;
+    break;
+  default: d[0] = -s, d[1] = -t, d[2] = -1;
+  }
+  f32 inv_length = 1 / std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+  for (int i = 0; i < 3; ++i)
+    d[i] *= inv_length;
+}
+
+/// Inverse of faceDirection, with s and t in [0, 1] (GL cube map selection rules)
+void faceCoordinates(const f32 *d, u32 &face, f32 &s, f32 &t) {
+  f32 ax = std::abs(d[0]), ay = std::abs(d[1]), az = std::abs(d[2]);
+  f32 sc, tc, ma;
+  if (ax >= ay && ax >= az) {
+    face = d[0] > 0 ? 0 : 1;
+    ma = ax;
+    sc = d[0] > 0 ? -d[2] : d[2];
+    tc = -d[1];
+  } else if (ay >= az) {
+    face = d[1] > 0 ? 2 : 3;
+    ma = ay;
+    sc = d[0];
+    tc = d[1] > 0 ? d[2] : -d[2];
+  } else {
+    face = d[2] > 0 ? 4 : 5;
+    ma = az;
+    sc = d[2] > 0 ? d[0] : -d[0];
+    tc = -d[1];
+  }
+  s = 0.5f * (sc / ma + 1);
+  t = 0.5f * (tc / ma + 1);
+}
+
+/// Bilinear, clamped to the face edges
+void sampleCube(const CubeLevel &level, const f32 *d, f32 *rgb) {
+  u32 face;
+  f32 s, t;
+  faceCoordinates(d, face, s, t);
+  i32 last = static_cast<i32>(level.size) - 1;
+  f32 fx = std::min(std::max(s * level.size - 0.5f, 0.f), static_cast<f32>(last));
+  f32 fy = std::min(std::max(t * level.size - 0.5f, 0.f), static_cast<f32>(last));
+  i32 x0 = static_cast<i32>(fx), y0 = static_cast<i32>(fy);
+  i32 x1 = std::min(x0 + 1, last), y1 = std::min(y0 + 1, last);
+  f32 wx = fx - x0, wy = fy - y0;
+  const f32 *texels = level.rgb.data() + size_t(face) * level.size * level.size * 3;
+  auto at = [&](i32 x, i32 y) { return texels + (size_t(y) * level.size + x) * 3; };
+  const f32 *a = at(x0, y0), *b = at(x1, y0), *c = at(x0, y1), *e = at(x1, y1);
+  for (int i = 0; i < 3; ++i)
+    rgb[i] = (a[i] * (1 - wx) + b[i] * wx) * (1 - wy) + (c[i] * (1 - wx) + e[i] * wx) * wy;
+}
+
+/// Trilinear
+void sampleCube(const std::vector<CubeLevel> &chain, const f32 *d, f32 lod, f32 *rgb) {
+  lod = std::min(std::max(lod, 0.f), static_cast<f32>(chain.size() - 1));
+  u32 l0 = static_cast<u32>(lod);
+  f32 w = lod - l0;
+  sampleCube(chain[l0], d, rgb);
+  if (w > 0 && l0 + 1 < chain.size()) {
+    f32 next[3];
+    sampleCube(chain[l0 + 1], d, next);
+    for (int i = 0; i < 3; ++i)
+      rgb[i] += (next[i] - rgb[i]) * w;
+  }
+}
+
+/// Bilinear, u wraps around, v is clamped at the poles
+void sampleEquirect(const HdrImage &image, const f32 *d, f32 *rgb) {
+  f32 u = std::atan2(d[2], d[0]) / (2 * pi) + 0.5f;
+  f32 v = std::acos(std::min(std::max(d[1], -1.f), 1.f)) / pi;
+  f32 fx = u * image.width - 0.5f;
+  f32 fy = std::min(std::max(v * image.height - 0.5f, 0.f), static_cast<f32>(image.height - 1));
+  f32 x_floor = std::floor(fx);
+  i32 x0 = static_cast<i32>(x_floor), y0 = static_cast<i32>(fy);
+  f32 wx = fx - x_floor, wy = fy - y0;
+  i32 w = static_cast<i32>(image.width);
+  x0 = (x0 % w + w) % w;
+  i32 x1 = (x0 + 1) % w, y1 = std::min(y0 + 1, static_cast<i32>(image.height) - 1);
+  auto at = [&](i32 x, i32 y) { return image.data.data() + (size_t(y) * image.width + x) * 3; };
+  const f32 *a = at(x0, y0), *b = at(x1, y0), *c = at(x0, y1), *e = at(x1, y1);
+  for (int i = 0; i < 3; ++i)
+    rgb[i] = (a[i] * (1 - wx) + b[i] * wx) * (1 - wy) + (c[i] * (1 - wx) + e[i] * wx) * wy;
+}
+
+/// Resamples the equirectangular image into a cube map mip chain, the
+/// source of the specular prefilter.
+std::vector<CubeLevel> buildSourceCube(const HdrImage &image, ThreadPool &pool) {
+  // about one face texel per source pixel
+  u32 size = 1u << std::min(std::max(floorLog2(image.width / 4), 4u), 9u);
+  // larger sources are supersampled
+  u32 samples = image.width / 4 > size ? 2 : 1;
+  f32 inv_samples = 1.f / (samples * samples);
+  std::vector<CubeLevel> chain;
+  chain.push_back({size, std::vector<f32>(size_t(size) * size * 6 * 3)});
+  pool.parallelFor(size_t(size) * 6, [&](size_t begin, size_t end) {
+    for (size_t row = begin; row < end; ++row) {
+      u32 face = static_cast<u32>(row / size), y = static_cast<u32>(row % size);
+      f32 *out = chain[0].rgb.data() + row * size * 3;
+      for (u32 x = 0; x < size; ++x, out += 3) {
+        out[0] = out[1] = out[2] = 0;
+        for (u32 k = 0; k < samples * samples; ++k) {
+          f32 d[3], rgb[3];
+          faceDirection(face, 2 * (x + (k % samples + 0.5f) / samples) / size - 1,
+                        2 * (y + (k / samples + 0.5f) / samples) / size - 1, d);
+          sampleEquirect(image, d, rgb);
+          for (int i = 0; i < 3; ++i)
+            out[i] += rgb[i] * inv_samples;
+        }
+      }
+    }
+  }, 16);
+  while (chain.back().size > 1) {
+    const auto &parent = chain.back();
+    CubeLevel level{parent.size / 2, std::vector<f32>(size_t(parent.size / 2) * parent.size / 2 * 6 * 3)};
+    for (u32 face = 0; face < 6; ++face) {
+      const f32 *src = parent.rgb.data() + size_t(face) * parent.size * parent.size * 3;
+      f32 *dst = level.rgb.data() + size_t(face) * level.size * level.size * 3;
+      for (u32 y = 0; y < level.size; ++y)
+        for (u32 x = 0; x < level.size; ++x)
+          for (int i = 0; i < 3; ++i) {
+            auto at = [&](u32 px, u32 py) { return src[(size_t(py) * parent.size + px) * 3 + i]; };
+            dst[(size_t(y) * level.size + x) * 3 + i] =
+                0.25f * (at(2 * x, 2 * y) + at(2 * x + 1, 2 * y) + at(2 * x, 2 * y + 1) + at(2 * x + 1, 2 * y + 1));
+          }
+    }
+    chain.emplace_back(std::move(level));
+  }
+  return chain;
+}
+
+/// Van der Corput sequence, second coordinate of the Hammersley set
+f32 radicalInverse(u32 bits) {
+  bits = (bits << 16u) | (bits >> 16u);
+  bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+  bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+  bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+  bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+  return static_cast<f32>(bits) * 2.3283064365386963e-10f;
+}
+
+/// GGX importance sampled half vector, tangent space (z is the normal)
+void ggxHalfVector(u32 i, u32 count, f32 alpha, f32 *h) {
+  f32 phi = 2 * pi * i / count;
+  f32 u = radicalInverse(i);
+  f32 cos_theta = std::sqrt((1 - u) / (1 + (alpha * alpha - 1) * u));
+  f32 sin_theta = std::sqrt(std::max(1 - cos_theta * cos_theta, 0.f));
+  h[0] = sin_theta * std::cos(phi);
+  h[1] = sin_theta * std::sin(phi);
+  h[2] = cos_theta;
+}
+
+/// Prefilter samples of one roughness. With n = v = r the light direction of
+/// a sample is a * tangent + b * bitangent + c * n, and c = n.l is both the
+/// weight and independent of the texel.
+struct PrefilterSamples {
+  std::vector<f32> a, b, c, lod; //!< padded to a multiple of 4 with zero weights
+  f32 inv_weight{0};
+};
+
+/// \param roughness **[in]**
+/// \param count **[in]** importance samples
+/// \param source_size **[in]** base size of the source cube map
+PrefilterSamples prefilterSamples(f32 roughness, u32 count, u32 source_size) {
+  PrefilterSamples samples;
+  f32 alpha = roughness * roughness;
+  // solid angle of a source texel
+  f32 texel_angle = 4 * pi / (6.f * source_size * source_size);
+  f32 weight = 0;
+  for (u32 i = 0; i < count; ++i) {
+    f32 h[3];
+    ggxHalfVector(i, count, alpha, h);
+    f32 n_dot_l = 2 * h[2] * h[2] - 1;
+    if (n_dot_l <= 0)
+      continue;
+    // filtered importance sampling (Krivanek and Colbert 2008): the lower the
+    // sample pdf, the wider the source footprint it stands for
+    f32 a2 = alpha * alpha;
+    f32 denominator = h[2] * h[2] * (a2 - 1) + 1;
+    f32 pdf = a2 / (pi * denominator * denominator) / 4;
+    f32 sample_angle = 1 / (count * pdf);
+    samples.a.emplace_back(2 * h[2] * h[0]);
+    samples.b.emplace_back(2 * h[2] * h[1]);
+    samples.c.emplace_back(n_dot_l);
+    samples.lod.emplace_back(std::max(0.5f * std::log2(sample_angle / texel_angle) + 1, 0.f));
+    weight += n_dot_l;
+  }
+  while (samples.c.size() % 4) {
+    samples.a.emplace_back(0);
+    samples.b.emplace_back(0);
+    samples.c.emplace_back(0);
+    samples.lod.emplace_back(0);
+  }
+  samples.inv_weight = weight > 0 ? 1 / weight : 0;
+  return samples;
+}
+
+/// \param chain **[in]** source cube map
+/// \param samples **[in]**
+/// \param n **[in]** texel direction
+/// \param rgb **[out]** prefiltered radiance
+void prefilterTexel(const std::vector<CubeLevel> &chain, const PrefilterSamples &samples, const f32 *n, f32 *rgb) {
+  f32 up[3] = {0, 0, 1};
+  if (std::abs(n[2]) > 0.999f)
+    up[0] = 1, up[2] = 0;
+  // tangent = normalize(up x n), bitangent = n x tangent
+  f32 t[3] = {up[1] * n[2] - up[2] * n[1], up[2] * n[0] - up[0] * n[2], up[0] * n[1] - up[1] * n[0]};
+  f32 inv_length = 1 / std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+  for (auto &v : t)
+    v *= inv_length;
+  f32 b[3] = {n[1] * t[2] - n[2] * t[1], n[2] * t[0] - n[0] * t[2], n[0] * t[1] - n[1] * t[0]};
+  rgb[0] = rgb[1] = rgb[2] = 0;
+  alignas(16) f32 l[3][4];
+  for (size_t i = 0; i < samples.c.size(); i += 4) {
+#ifdef __SSE2__
+    __m128 a = _mm_loadu_ps(&samples.a[i]);
+    __m128 bb = _mm_loadu_ps(&samples.b[i]);
+    __m128 c = _mm_loadu_ps(&samples.c[i]);
+    for (int d = 0; d < 3; ++d)
+      _mm_store_ps(l[d], _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(t[d])), _mm_mul_ps(bb, _mm_set1_ps(b[d]))),
+                                    _mm_mul_ps(c, _mm_set1_ps(n[d]))));
+#else
+    for (int d = 0; d < 3; ++d)
+      for (size_t k = 0; k < 4; ++k)
+        l[d][k] = samples.a[i + k] * t[d] + samples.b[i + k] * b[d] + samples.c[i + k] * n[d];
+#endif
+    for (size_t k = 0; k < 4; ++k) {
+      f32 weight = samples.c[i + k];
+      if (weight <= 0)
+        continue;
+      f32 direction[3] = {l[0][k], l[1][k], l[2][k]}, radiance[3];
+      sampleCube(chain, direction, samples.lod[i + k], radiance);
+      for (int d = 0; d < 3; ++d)
+        rgb[d] += radiance[d] * weight;
+    }
+  }
+  for (int d = 0; d < 3; ++d)
+    rgb[d] *= samples.inv_weight;
+}
+
+void prefilterSpecular(const std::vector<CubeLevel> &chain, const EnvironmentParams &params, Environment &environment,
+                       ThreadPool &pool) {
+  u32 size = 1u << floorLog2(std::max(params.specular_size, 4u));
+  environment.specular_size = size;
+  // the last level is 4x4, smaller ones add little over the irradiance
+  environment.specular_levels = std::max(floorLog2(size), 2u) - 1;
+  environment.specular.resize(environment.specularOffset(environment.specular_levels));
+  u32 source_size = chain[0].size;
+  for (u32 level = 0; level < environment.specular_levels; ++level) {
+    u32 level_size = size >> level;
+    f32 roughness = environment.specular_levels > 1 ? static_cast<f32>(level) / (environment.specular_levels - 1) : 0;
+    auto samples = prefilterSamples(roughness, params.specular_samples, source_size);
+    // a mirror only resamples the source
+    f32 mirror_lod = std::log2(static_cast<f32>(source_size) / level_size);
+    u16 *texels = environment.specular.data() + environment.specularOffset(level);
+    pool.parallelFor(size_t(level_size) * 6, [&](size_t begin, size_t end) {
+      for (size_t row = begin; row < end; ++row) {
+        u32 face = static_cast<u32>(row / level_size), y = static_cast<u32>(row % level_size);
+        u16 *out = texels + row * level_size * 4;
+        for (u32 x = 0; x < level_size; ++x, out += 4) {
+          f32 n[3], rgb[3];
+          faceDirection(face, 2 * (x + 0.5f) / level_size - 1, 2 * (y + 0.5f) / level_size - 1, n);
+          if (level == 0)
+            sampleCube(chain, n, mirror_lod, rgb);
+          else
+            prefilterTexel(chain, samples, n, rgb);
+          for (int d = 0; d < 3; ++d)
+            out[d] = floatToHalf(rgb[d]);
+          out[3] = floatToHalf(1);
+        }
+      }
+    }, 4);
+  }
+}
+
+/// Split sum of Karis 2013, integrated for n = (0, 0, 1)
+void integrateBrdf(const EnvironmentParams &params, Environment &environment, ThreadPool &pool) {
+  u32 size = std::max(params.brdf_size, 2u);
+  u32 count = std::max(params.brdf_samples, 1u);
+  environment.brdf_size = size;
+  environment.brdf_lut.resize(size_t(size) * size * 2);
+  pool.parallelFor(size, [&](size_t begin, size_t end) {
+    for (size_t y = begin; y < end; ++y) {
+      f32 roughness = (y + 0.5f) / size;
+      f32 alpha = roughness * roughness;
+      // Schlick-GGX k for image based lighting
+      f32 k = alpha / 2;
+      for (u32 x = 0; x < size; ++x) {
+        f32 n_dot_v = (x + 0.5f) / size;
+        f32 v[3] = {std::sqrt(1 - n_dot_v * n_dot_v), 0, n_dot_v};
+        f32 scale = 0, bias = 0;
+        for (u32 i = 0; i < count; ++i) {
+          f32 h[3];
+          ggxHalfVector(i, count, alpha, h);
+          f32 v_dot_h = v[0] * h[0] + v[1] * h[1] + v[2] * h[2];
+          f32 n_dot_l = 2 * v_dot_h * h[2] - v[2];
+          if (n_dot_l <= 0)
+            continue;
+          f32 g = n_dot_v / (n_dot_v * (1 - k) + k) * n_dot_l / (n_dot_l * (1 - k) + k);
+          f32 g_visibility = g * std::max(v_dot_h, 0.f) / (h[2] * n_dot_v);
+          f32 fresnel = std::pow(1 - std::max(v_dot_h, 0.f), 5.f);
+          scale += (1 - fresnel) * g_visibility;
+          bias += fresnel * g_visibility;
+        }
+        u16 *out = environment.brdf_lut.data() + (y * size + x) * 2;
+        out[0] = floatToHalf(scale / count);
+        out[1] = floatToHalf(bias / count);
+      }
+    }
+  });
+}
+
+u64 alignUp(u64 offset) {
+  return (offset + environment_file_alignment - 1) / environment_file_alignment * environment_file_alignment;
+}
+
+}
+
+size_t Environment::specularOffset(u32 level) const {
+  size_t offset = 0;
+  for (u32 l = 0; l < level; ++l)
+    offset += size_t(specular_size >> l) * (specular_size >> l) * 6 * 4;
+  return offset;
+}
+
+void projectIrradiance(const HdrImage &equirect, f32 sh[9][3], ThreadPool &pool) {
+  f64 sum[9][3] = {};
+  std::mutex mutex;
+  u32 width = equirect.width, height = equirect.height;
+  // the direction of a column only depends on its longitude
+  std::vector<f32> cos_phi(width), sin_phi(width);
+  for (u32 x = 0; x < width; ++x) {
+    f32 phi = ((x + 0.5f) / width - 0.5f) * 2 * pi;
+    cos_phi[x] = std::cos(phi);
+    sin_phi[x] = std::sin(phi);
+  }
+  pool.parallelFor(height, [&](size_t begin, size_t end) {
+    f64 local[9][3] = {};
+    for (size_t y = begin; y < end; ++y) {
+      f32 theta = (y + 0.5f) / height * pi;
+      f32 sin_theta = std::sin(theta), cos_theta = std::cos(theta);
+      // every pixel of a row covers the same solid angle
+      f32 solid_angle = (2 * pi / width) * (pi / height) * sin_theta;
+      const f32 *row = equirect.data.data() + y * width * 3;
+      f32 row_sum[9][3] = {};
+      u32 x = 0;
+#ifdef __SSE2__
+      __m128 acc[9][3];
+      for (auto &basis : acc)
+        for (auto &channel : basis)
+          channel = _mm_setzero_ps();
+      __m128 dy = _mm_set1_ps(cos_theta);
+      for (; x + 4 <= width; x += 4) {
+        __m128 dx = _mm_mul_ps(_mm_loadu_ps(&cos_phi[x]), _mm_set1_ps(sin_theta));
+        __m128 dz = _mm_mul_ps(_mm_loadu_ps(&sin_phi[x]), _mm_set1_ps(sin_theta));
+        __m128 basis[9];
+        basis[0] = _mm_set1_ps(sh_c0);
+        basis[1] = _mm_mul_ps(_mm_set1_ps(sh_c1), dy);
+        basis[2] = _mm_mul_ps(_mm_set1_ps(sh_c1), dz);
+        basis[3] = _mm_mul_ps(_mm_set1_ps(sh_c1), dx);
+        basis[4] = _mm_mul_ps(_mm_set1_ps(sh_c2), _mm_mul_ps(dx, dy));
+        basis[5] = _mm_mul_ps(_mm_set1_ps(sh_c2), _mm_mul_ps(dy, dz));
+        basis[6] = _mm_mul_ps(_mm_set1_ps(sh_c3),
+                              _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(3), _mm_mul_ps(dz, dz)), _mm_set1_ps(1)));
+        basis[7] = _mm_mul_ps(_mm_set1_ps(sh_c2), _mm_mul_ps(dx, dz));
+        basis[8] = _mm_mul_ps(_mm_set1_ps(sh_c4), _mm_sub_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        const f32 *p = row + x * 3;
+        __m128 rgb[3] = {_mm_set_ps(p[9], p[6], p[3], p[0]), _mm_set_ps(p[10], p[7], p[4], p[1]),
+                         _mm_set_ps(p[11], p[8], p[5], p[2])};
+        for (int k = 0; k < 9; ++k)
+          for (int c = 0; c < 3; ++c)
+            acc[k][c] = _mm_add_ps(acc[k][c], _mm_mul_ps(basis[k], rgb[c]));
+      }
+      for (int k = 0; k < 9; ++k)
+        for (int c = 0; c < 3; ++c) {
+          alignas(16) f32 lanes[4];
+          _mm_store_ps(lanes, acc[k][c]);
+          row_sum[k][c] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        }
+#endif
+      for (; x < width; ++x) {
+        f32 basis[9];
+        shBasis(sin_theta * cos_phi[x], cos_theta, sin_theta * sin_phi[x], basis);
+        for (int k = 0; k < 9; ++k)
+          for (int c = 0; c < 3; ++c)
+            row_sum[k][c] += basis[k] * row[x * 3 + c];
+      }
+      for (int k = 0; k < 9; ++k)
+        for (int c = 0; c < 3; ++c)
+          local[k][c] += static_cast<f64>(row_sum[k][c]) * solid_angle;
+    }
+    std::lock_guard<std::mutex> guard(mutex);
+    for (int k = 0; k < 9; ++k)
+      for (int c = 0; c < 3; ++c)
+        sum[k][c] += local[k][c];
+  }, 8);
+  for (int k = 0; k < 9; ++k)
+    for (int c = 0; c < 3; ++c)
+      sh[k][c] = static_cast<f32>(sum[k][c]) * sh_cosine[k];
+}
+
+void precomputeEnvironment(const HdrImage &equirect, const EnvironmentParams &params, Environment &environment,
+                           ThreadPool &pool) {
+  projectIrradiance(equirect, environment.irradiance_sh, pool);
+  prefilterSpecular(buildSourceCube(equirect, pool), params, environment, pool);
+  integrateBrdf(params, environment, pool);
+}
+
+bool writeEnvironmentFile(const std::string &path, const Environment &environment, u64 source_hash) {
+  EnvironmentFileHeader header;
+  header.version = environment_file_version;
+  header.source_hash = source_hash;
+  std::memcpy(header.irradiance_sh, environment.irradiance_sh, sizeof(header.irradiance_sh));
+  header.specular_size = environment.specular_size;
+  header.specular_levels = environment.specular_levels;
+  header.brdf_size = environment.brdf_size;
+  header.specular_offset = alignUp(sizeof(EnvironmentFileHeader));
+  header.specular_bytes = environment.specular.size() * sizeof(u16);
+  header.brdf_offset = alignUp(header.specular_offset + header.specular_bytes);
+  header.brdf_bytes = environment.brdf_lut.size() * sizeof(u16);
+  // several processes may compute the same environment, each one writes its own file
+  auto tmp_path = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+  FILE *file = fopen(tmp_path.c_str(), "wb");
+  if (!file)
+    return false;
+  const u8 padding[environment_file_alignment] = {};
+  u64 specular_padding = header.specular_offset - sizeof(header);
+  u64 brdf_padding = header.brdf_offset - header.specular_offset - header.specular_bytes;
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+      && fwrite(padding, 1, specular_padding, file) == specular_padding
+      && fwrite(environment.specular.data(), 1, header.specular_bytes, file) == header.specular_bytes
+      && fwrite(padding, 1, brdf_padding, file) == brdf_padding
+      && fwrite(environment.brdf_lut.data(), 1, header.brdf_bytes, file) == header.brdf_bytes;
+  ok = fclose(file) == 0 && ok;
+  std::error_code ec;
+  if (ok)
+    std::filesystem::rename(tmp_path, path, ec);
+  else
+    std::filesystem::remove(tmp_path, ec);
+  return ok && !ec;
+}
+
+bool readEnvironmentFile(const std::string &path, Environment &environment, u64 &source_hash) {
+  MappedFile file;
+  if (!file.open(path) || file.size() < sizeof(EnvironmentFileHeader))
+    return false;
+  EnvironmentFileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, "GENV", 4) != 0 || header.version != environment_file_version
+      || !header.specular_size || header.specular_levels > 16)
+    return false;
+  environment.specular_size = header.specular_size;
+  environment.specular_levels = header.specular_levels;
+  environment.brdf_size = header.brdf_size;
+  if (header.specular_bytes != environment.specularOffset(header.specular_levels) * sizeof(u16)
+      || header.brdf_bytes != size_t(header.brdf_size) * header.brdf_size * 2 * sizeof(u16)
+      || header.specular_offset + header.specular_bytes > file.size()
+      || header.brdf_offset + header.brdf_bytes > file.size())
+    return false;
+  std::memcpy(environment.irradiance_sh, header.irradiance_sh, sizeof(header.irradiance_sh));
+  environment.specular.resize(header.specular_bytes / sizeof(u16));
+  std::memcpy(environment.specular.data(), file.data() + header.specular_offset, header.specular_bytes);
+  environment.brdf_lut.resize(header.brdf_bytes / sizeof(u16));
+  std::memcpy(environment.brdf_lut.data(), file.data() + header.brdf_offset, header.brdf_bytes);
+  source_hash = header.source_hash;
+  return true;
+}
+
+EnvironmentCache::EnvironmentCache(std::string directory) : directory_(std::move(directory)) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+}
+
+std::string EnvironmentCache::filename(const std::string &path, u64 *source_hash) const {
+  MappedFile source;
+  if (!source.open(path))
+    return "";
+  u64 h = hash_bytes(source.data(), source.size());
+  h = hash_combine(h, params.specular_size);
+  h = hash_combine(h, params.specular_samples);
+  h = hash_combine(h, params.brdf_size);
+  h = hash_combine(h, params.brdf_samples);
+  if (source_hash)
+    *source_hash = h;
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.env", static_cast<unsigned long long>(h));
+  return directory_ + "/" + name;
+}
+
+bool EnvironmentCache::load(const std::string &path, Environment &environment, std::string &err, ThreadPool &pool) {
+  u64 source_hash = 0;
+  auto cache_path = filename(path, &source_hash);
+  if (cache_path.empty()) {
+    err = path + ": could not read file";
+    return false;
+  }
+  u64 cached_hash = 0;
+  if (readEnvironmentFile(cache_path, environment, cached_hash) && cached_hash == source_hash) {
+    hits++;
+    return true;
+  }
+  misses++;
+  HdrImage equirect;
+  if (!decodeHdrImage(path, equirect, err))
+    return false;
+  precomputeEnvironment(equirect, params, environment, pool);
+  // a failed write only means the next load computes again
+  writeEnvironmentFile(cache_path, environment, source_hash);
+  return true;
+}
@@ -0,0 +1,134 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file environment.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Image based lighting precompute: irradiance SH, GGX prefiltered cube map and BRDF lut, with a disk cache.
+
+#ifndef GLSL_EXPERIMENTS_ENVIRONMENT_H
+#define GLSL_EXPERIMENTS_ENVIRONMENT_H
+
+#include "image.h"
+#include "thread_pool.h"
+
+#include <atomic>
+
+struct EnvironmentParams {
+  u32 specular_size{128};   //!< base level of the prefiltered cube map (power of two)
+  u32 specular_samples{64}; //!< GGX samples per texel
+  u32 brdf_size{64};
+  u32 brdf_samples{256};
+};
+
+/// Image based lighting of one environment, split as:
+///   - irradiance: 9 RGB spherical harmonics coefficients, already convolved
+///     with the cosine lobe and divided by pi, so the diffuse term is
+///     albedo * sum(irradiance_sh[i] * Y_i(n))
+///   - specular: GGX prefiltered radiance cube map, level l holds roughness
+///     l / (specular_levels - 1)
+///   - brdf lut: split sum scale and bias of F0, indexed by (n.v, roughness)
+struct Environment {
+  f32 irradiance_sh[9][3]{};
+  u32 specular_size{0};
+  u32 specular_levels{0};
+  /// RGBA half floats, level after level, each level holding its 6 faces in
+  /// GL order (+x, -x, +y, -y, +z, -z)
+  std::vector<u16> specular;
+  u32 brdf_size{0};
+  std::vector<u16> brdf_lut; //!< RG half floats, row r is roughness (r + 0.5) / brdf_size
+  /// \param level **[in]**
+  /// \return index in specular of the first half of **level**
+  [[nodiscard]] size_t specularOffset(u32 level) const;
+};
+
+/// Projects an equirectangular environment onto the first 3 bands of
+/// spherical harmonics and convolves it with the cosine lobe.
+/// \param equirect **[in]**
+/// \param sh **[out]** see Environment::irradiance_sh
+/// \param pool **[in]** rows are split between its threads
+void projectIrradiance(const HdrImage &equirect, f32 sh[9][3], ThreadPool &pool);
+/// Computes every part of the environment lighting of **equirect**.
+/// \param equirect **[in]**
+/// \param params **[in]**
+/// \param environment **[out]**
+/// \param pool **[in]** faces and rows are split between its threads
+void precomputeEnvironment(const HdrImage &equirect, const EnvironmentParams &params, Environment &environment,
+                           ThreadPool &pool);
+
+/// File layout:
+///   EnvironmentFileHeader
+///   specular blob
+///   brdf lut blob (each aligned to environment_file_alignment)
+struct EnvironmentFileHeader {
+  char magic[4]{'G', 'E', 'N', 'V'};
+  u32 version{0};
+  u64 source_hash{0}; //!< hash of the source file content and params
+  f32 irradiance_sh[9][3]{};
+  u32 specular_size{0};
+  u32 specular_levels{0};
+  u32 brdf_size{0};
+  u64 specular_offset{0}; //!< from the beginning of the file
+  u64 specular_bytes{0};
+  u64 brdf_offset{0};
+  u64 brdf_bytes{0};
+};
+
+constexpr u32 environment_file_version = 1;
+constexpr u64 environment_file_alignment = 64;
+
+/// \param path **[in]** output file
+/// \param environment **[in]**
+/// \param source_hash **[in]**
+/// \return false if the file could not be written
+bool writeEnvironmentFile(const std::string &path, const Environment &environment, u64 source_hash);
+/// \param path **[in]** .env file
+/// \param environment **[out]**
+/// \param source_hash **[out]**
+/// \return false if missing, truncated or from another format version
+bool readEnvironmentFile(const std::string &path, Environment &environment, u64 &source_hash);
+
+/// Stores the precomputed lighting of environment images in a directory,
+/// keyed by the hash of the image file content and the params. A miss
+/// decodes the image and runs precomputeEnvironment.
+class EnvironmentCache {
+public:
+  /// \param directory **[in]** cache directory (created if missing)
+  explicit EnvironmentCache(std::string directory);
+  /// \param path **[in]** equirectangular image (.hdr)
+  /// \param environment **[out]**
+  /// \param err **[out]**
+  /// \param pool **[in]** used to precompute on a miss
+  /// \return false if the environment could neither be read from the cache nor computed
+  bool load(const std::string &path, Environment &environment, std::string &err, ThreadPool &pool);
+  /// \param path **[in]** image file
+  /// \return cache file path for the current content of **path**, empty if unreadable
+  [[nodiscard]] std::string filename(const std::string &path, u64 *source_hash = nullptr) const;
+
+  EnvironmentParams params;
+  std::atomic<u32> hits{0};
+  std::atomic<u32> misses{0};
+private:
+  std::string directory_;
+};
+
+#endif //GLSL_EXPERIMENTS_ENVIRONMENT_H
@@ -0,0 +1,91 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file environment_map.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "environment_map.h"
+
+#include <cstring>
+
+EnvironmentMap::~EnvironmentMap() {
+  destroy();
+}
+
+void EnvironmentMap::upload(const Environment &environment) {
+  destroy();
+  levels_ = environment.specular_levels;
+  std::memcpy(irradiance_sh_, environment.irradiance_sh, sizeof(irradiance_sh_));
+  // RGBA16F rows are always 4 byte aligned
+  glGenTextures(1, &cube_map_);
+  glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map_);
+  glTexStorage2D(GL_TEXTURE_CUBE_MAP, levels_, GL_RGBA16F, environment.specular_size, environment.specular_size);
+  for (u32 level = 0; level < levels_; ++level) {
+    GLsizei size = environment.specular_size >> level;
+    const u16 *texels = environment.specular.data() + environment.specularOffset(level);
+    for (u32 face = 0; face < 6; ++face)
+      glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, 0, 0, size, size, GL_RGBA, GL_HALF_FLOAT,
+                      texels + size_t(face) * size * size * 4);
+  }
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels_) - 1);
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+  // the prefilter does not blend across faces, the sampler does
+  glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+  glGenTextures(1, &brdf_lut_);
+  glBindTexture(GL_TEXTURE_2D, brdf_lut_);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_RG16F, environment.brdf_size, environment.brdf_size);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, environment.brdf_size, environment.brdf_size, GL_RG, GL_HALF_FLOAT,
+                  environment.brdf_lut.data());
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void EnvironmentMap::bind(GLenum specular_unit, GLenum brdf_unit) const {
+  glActiveTexture(specular_unit);
+  glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map_);
+  glActiveTexture(brdf_unit);
+  glBindTexture(GL_TEXTURE_2D, brdf_lut_);
+}
+
+void EnvironmentMap::blockData(EnvironmentBlockData &data) const {
+  for (int k = 0; k < 9; ++k)
+    for (int c = 0; c < 3; ++c)
+      data.irradiance_sh[k][c] = irradiance_sh_[k][c];
+  data.levels = static_cast<f32>(levels_);
+}
+
+void EnvironmentMap::destroy() {
+  if (cube_map_)
+    glDeleteTextures(1, &cube_map_);
+  if (brdf_lut_)
+    glDeleteTextures(1, &brdf_lut_);
+  cube_map_ = brdf_lut_ = 0;
+  levels_ = 0;
+}
@@ -0,0 +1,66 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file environment_map.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief GPU textures of a precomputed environment.
+
+#ifndef GLSL_EXPERIMENTS_ENVIRONMENT_MAP_H
+#define GLSL_EXPERIMENTS_ENVIRONMENT_MAP_H
+
+#include "environment.h"
+#include "uniform_blocks.h"
+
+/// GPU side of an Environment: the prefiltered cube map (GL_RGBA16F, one
+/// mip per roughness), the BRDF lut (GL_RG16F) and the irradiance
+/// coefficients for the EnvironmentBlock.
+///
+/// Usage:
+///   EnvironmentMap map;
+///   map.upload(environment);
+///   map.bind(GL_TEXTURE2, GL_TEXTURE3);
+class EnvironmentMap {
+public:
+  EnvironmentMap() = default;
+  EnvironmentMap(const EnvironmentMap &) = delete;
+  EnvironmentMap &operator=(const EnvironmentMap &) = delete;
+  ~EnvironmentMap();
+  /// Replaces the textures. Requires a current GL context.
+  /// \param environment **[in]**
+  void upload(const Environment &environment);
+  /// \param specular_unit **[in]** receives the cube map (samplerCube environmentMap)
+  /// \param brdf_unit **[in]** receives the lut (sampler2D brdfLut)
+  void bind(GLenum specular_unit, GLenum brdf_unit) const;
+  /// \param data **[out]** irradiance and levels, intensity and enabled are left untouched
+  void blockData(EnvironmentBlockData &data) const;
+  void destroy();
+  [[nodiscard]] bool loaded() const { return cube_map_ != 0; }
+
+private:
+  GLuint cube_map_{0};
+  GLuint brdf_lut_{0};
+  f32 irradiance_sh_[9][3]{};
+  u32 levels_{0};
+};
+
+#endif //GLSL_EXPERIMENTS_ENVIRONMENT_MAP_H
@@ -0,0 +1,156 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file file_watcher.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "file_watcher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+
+/// written and closed, or moved in place (atomic saves)
+constexpr u32 watch_mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+/// upper bound of the time stop() waits for the thread if waking it failed
+constexpr int stop_check_ms = 100;
+
+}
+
+FileWatcher::~FileWatcher() {
+  stop();
+}
+
+bool FileWatcher::start(std::string &err) {
+  if (running())
+    return true;
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (inotify_fd_ < 0 || wake_fd_ < 0) {
+    err = std::string("inotify: ") + strerror(errno);
+    stop();
+    return false;
+  }
+  stop_ = false;
+  thread_ = std::thread(&FileWatcher::run, this);
+  return true;
+}
+
+void FileWatcher::stop() {
+  if (thread_.joinable()) {
+    stop_ = true;
+    // wakes the thread right away, otherwise it sees stop_ on its next timeout
+    u64 one = 1;
+    [[maybe_unused]] auto written = write(wake_fd_, &one, sizeof(one));
+    thread_.join();
+  }
+  if (inotify_fd_ >= 0)
+    close(inotify_fd_);
+  if (wake_fd_ >= 0)
+    close(wake_fd_);
+  inotify_fd_ = wake_fd_ = -1;
+  std::lock_guard<std::mutex> guard(mutex_);
+  directories_.clear();
+  watch_descriptors_.clear();
+  files_.clear();
+  changed_.clear();
+}
+
+bool FileWatcher::watch(const std::string &path, std::string &err) {
+  if (inotify_fd_ < 0) {
+    err = "file watcher not started";
+    return false;
+  }
+  auto file = key(path);
+  auto directory = std::filesystem::path(file).parent_path().string();
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (!watch_descriptors_.count(directory)) {
+    int wd = inotify_add_watch(inotify_fd_, directory.c_str(), watch_mask);
+    if (wd < 0) {
+      err = directory + ": " + strerror(errno);
+      return false;
+    }
+    directories_[wd] = directory;
+    watch_descriptors_[directory] = wd;
+  }
+  files_.insert(file);
+  return true;
+}
+
+void FileWatcher::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  files_.clear();
+  changed_.clear();
+}
+
+std::vector<std::string> FileWatcher::poll() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::vector<std::string> changed;
+  changed.swap(changed_);
+  return changed;
+}
+
+std::string FileWatcher::key(const std::string &path) {
+  std::error_code ec;
+  auto absolute = std::filesystem::weakly_canonical(path, ec);
+  return ec ? std::filesystem::path(path).lexically_normal().string() : absolute.string();
+}
+
+void FileWatcher::run() {
+  alignas(inotify_event) char buffer[4096];
+  pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+  while (!stop_) {
+    int ready = ::poll(fds, 2, stop_check_ms);
+    if (ready < 0) {
+      if (errno == EINTR)
+        continue;
+      return;
+    }
+    if (!ready)
+      continue;
+    if (fds[1].revents)
+      return;
+    ssize_t length;
+    while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      for (char *ptr = buffer; ptr < buffer + length;) {
+        auto *event = reinterpret_cast<inotify_event *>(ptr);
+        ptr += sizeof(inotify_event) + event->len;
+        auto it = directories_.find(event->wd);
+        if (!event->len || it == directories_.end())
+          continue;
+        auto file = it->second + "/" + event->name;
+        if (files_.count(file) && std::find(changed_.begin(), changed_.end(), file) == changed_.end())
+          changed_.emplace_back(file);
+      }
+    }
+  }
+}
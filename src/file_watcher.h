@@ -0,0 +1,92 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file file_watcher.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief inotify based file change notifications.
+
+#ifndef GLSL_EXPERIMENTS_FILE_WATCHER_H
+#define GLSL_EXPERIMENTS_FILE_WATCHER_H
+
+#include <ponos/ponos.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// Reports files modified by other programs (inotify). A thread blocks on the
+/// kernel notifications and queues the changed files, the render loop takes
+/// them with poll(), so nothing is done until a file is actually written.
+///
+/// The directories of the files are watched rather than the files, since
+/// editors often save by writing a new file and renaming it over the old one.
+///
+/// Usage:
+///   FileWatcher watcher;
+///   watcher.start(err);
+///   watcher.watch("shaders/foo/foo.frag", err);
+///   // every frame
+///   for (const auto &path : watcher.poll()) ...
+class FileWatcher {
+public:
+  FileWatcher() = default;
+  ~FileWatcher();
+  FileWatcher(const FileWatcher &) = delete;
+  FileWatcher &operator=(const FileWatcher &) = delete;
+  /// Starts the watcher thread
+  /// \param err **[out]**
+  /// \return false if inotify is not available
+  bool start(std::string &err);
+  /// Joins the watcher thread and drops every watch
+  void stop();
+  /// Adds **path** to the watched files. Thread safe, watching a file twice is a no-op.
+  /// \param path **[in]** file, it does not need to exist yet
+  /// \param err **[out]**
+  /// \return false if its directory can not be watched
+  bool watch(const std::string &path, std::string &err);
+  /// Stops reporting the watched files (directories stay watched)
+  void clear();
+  /// \return paths (as key() gives them) written since the last call, each once
+  std::vector<std::string> poll();
+  [[nodiscard]] bool running() const { return thread_.joinable(); }
+  /// \return absolute normalized path, paths are compared in this form
+  static std::string key(const std::string &path);
+
+private:
+  void run();
+
+  int inotify_fd_{-1};
+  int wake_fd_{-1}; //!< signaled by stop()
+  /// set by stop(), checked by the thread on a timeout in case the wake write failed
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+  std::mutex mutex_;
+  std::unordered_map<int, std::string> directories_;      //!< by watch descriptor
+  std::unordered_map<std::string, int> watch_descriptors_; //!< by directory
+  std::set<std::string> files_;
+  std::vector<std::string> changed_;
+};
+
+#endif //GLSL_EXPERIMENTS_FILE_WATCHER_H
@@ -0,0 +1,215 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file frame_capture.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "frame_capture.h"
+#include "image.h"
+
+#include <cstring>
+
+FrameCapture::FrameCapture(u32 ring_size, u32 max_encodes, ThreadPool &pool)
+    : pool_(pool), slots_(new Slot[std::max(ring_size, 1u)]), ring_size_(std::max(ring_size, 1u)),
+      max_encodes_(std::max(max_encodes, 1u)) {}
+
+FrameCapture::~FrameCapture() {
+  destroy();
+}
+
+void FrameCapture::capture(GLuint framebuffer, u32 width, u32 height, const std::string &path, int format) {
+  if (!width || !height)
+    return;
+  // bounds the memory held by frames waiting for the encoders
+  collect(false);
+  while (encodes_.size() >= max_encodes_) {
+    stalls++;
+    encodes_.front().done.wait();
+    collect(false);
+  }
+  auto &slot = acquireSlot();
+  size_t bytes = size_t(width) * height * (format == CaptureFormat::HDR ? 3 * sizeof(f32) : 4);
+  if (slot.capacity < bytes) {
+    if (slot.buffer)
+      glDeleteBuffers(1, &slot.buffer);
+    // persistent and coherent: the workers read the mapped memory directly
+    // once the fence signaled
+    const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &slot.buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glBufferStorage(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, flags);
+    slot.mapped = static_cast<const u8 *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                                           flags));
+    slot.capacity = bytes;
+  } else
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  if (!slot.mapped) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    err = "could not map the read back buffer";
+    failed++;
+    return;
+  }
+  GLint saved_framebuffer = 0, saved_read_buffer = 0, saved_alignment = 0;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &saved_framebuffer);
+  glGetIntegerv(GL_READ_BUFFER, &saved_read_buffer);
+  glGetIntegerv(GL_PACK_ALIGNMENT, &saved_alignment);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+  glReadBuffer(framebuffer ? GL_COLOR_ATTACHMENT0 : GL_BACK);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  // returns immediately, the copy happens when the GPU gets there
+  if (format == CaptureFormat::HDR)
+    glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGB, GL_FLOAT, nullptr);
+  else
+    glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, saved_alignment);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(saved_framebuffer));
+  glReadBuffer(static_cast<GLenum>(saved_read_buffer));
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  slot.state = State::READING;
+  slot.width = width;
+  slot.height = height;
+  slot.format = format;
+  slot.path = path;
+  next_ = (next_ + 1) % ring_size_;
+  captured++;
+}
+
+void FrameCapture::poll() {
+  for (u32 i = 0; i < ring_size_; ++i) {
+    auto &slot = slots_[(next_ + i) % ring_size_];
+    if (slot.state == State::READING) {
+      GLenum status = glClientWaitSync(slot.fence, 0, 0);
+      if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        encode(slot);
+    } else if (slot.state == State::COPYING && !slot.copying.load(std::memory_order_acquire))
+      slot.state = State::FREE;
+  }
+  collect(false);
+}
+
+void FrameCapture::finish() {
+  for (u32 i = 0; i < ring_size_; ++i) {
+    auto &slot = slots_[(next_ + i) % ring_size_];
+    if (slot.state == State::READING) {
+      glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(-1));
+      encode(slot);
+    }
+  }
+  collect(true);
+  for (u32 i = 0; i < ring_size_; ++i)
+    if (slots_[i].state == State::COPYING)
+      slots_[i].state = State::FREE;
+}
+
+void FrameCapture::destroy() {
+  // the workers may still be reading the mapped buffers
+  finish();
+  for (u32 i = 0; i < ring_size_; ++i) {
+    auto &slot = slots_[i];
+    if (slot.buffer) {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+      glDeleteBuffers(1, &slot.buffer);
+    }
+    slot.buffer = 0;
+    slot.capacity = 0;
+    slot.mapped = nullptr;
+  }
+}
+
+u32 FrameCapture::pending() const {
+  u32 count = static_cast<u32>(encodes_.size());
+  for (u32 i = 0; i < ring_size_; ++i)
+    if (slots_[i].state == State::READING)
+      count++;
+  return count;
+}
+
+FrameCapture::Slot &FrameCapture::acquireSlot() {
+  // slots are used in order, so next_ is the oldest one still in flight
+  auto &slot = slots_[next_];
+  if (slot.state == State::FREE)
+    return slot;
+  stalls++;
+  if (slot.state == State::READING) {
+    glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(-1));
+    encode(slot);
+  }
+  // the copy out of the mapped buffer is short compared to the encoding
+  while (slot.copying.load(std::memory_order_acquire))
+    std::this_thread::yield();
+  slot.state = State::FREE;
+  return slot;
+}
+
+void FrameCapture::encode(Slot &slot) {
+  glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+  slot.state = State::COPYING;
+  slot.copying.store(true, std::memory_order_release);
+  auto result = std::make_shared<std::string>();
+  auto *source = &slot;
+  encodes_.push_back({pool_.submit([source, result] {
+    u32 width = source->width, height = source->height;
+    auto path = source->path;
+    // GL rows go bottom up, files top down
+    if (source->format == CaptureFormat::HDR) {
+      HdrImage image;
+      image.width = width;
+      image.height = height;
+      image.data.resize(size_t(width) * height * 3);
+      size_t row = size_t(width) * 3;
+      auto *pixels = reinterpret_cast<const f32 *>(source->mapped);
+      for (u32 y = 0; y < height; ++y)
+        std::memcpy(&image.data[(height - 1 - y) * row], pixels + y * row, row * sizeof(f32));
+      source->copying.store(false, std::memory_order_release);
+      encodeHdrImage(path, image, *result);
+    } else {
+      size_t row = size_t(width) * 4;
+      std::vector<u8> pixels(row * height);
+      for (u32 y = 0; y < height; ++y)
+        std::memcpy(&pixels[(height - 1 - y) * row], source->mapped + y * row, row);
+      source->copying.store(false, std::memory_order_release);
+      encodePng(path, width, height, pixels.data(), *result);
+    }
+  }), result});
+}
+
+void FrameCapture::collect(bool wait) {
+  while (!encodes_.empty()) {
+    auto &front = encodes_.front();
+    if (!wait && front.done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      break;
+    front.done.wait();
+    if (front.err->empty())
+      written++;
+    else {
+      failed++;
+      err = *front.err;
+    }
+    encodes_.pop_front();
+  }
+}
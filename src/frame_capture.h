@@ -0,0 +1,128 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file frame_capture.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Asynchronous frame read back through a ring of fenced pixel buffers, encoded on the thread pool.
+
+#ifndef GLSL_EXPERIMENTS_FRAME_CAPTURE_H
+#define GLSL_EXPERIMENTS_FRAME_CAPTURE_H
+
+#include "thread_pool.h"
+
+#include <circe/circe.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+
+struct CaptureFormat {
+  enum : int {
+    PNG = 0, //!< RGBA8
+    HDR = 1  //!< float RGB Radiance file, for float targets
+  };
+};
+
+/// Reads frames back without stalling the pipeline. glReadPixels writes into
+/// a ring of persistently mapped pixel buffers, each followed by a fence, and
+/// a read back is only consumed frames later, once its fence signaled. Copying
+/// out of the ring and encoding run on the thread pool.
+///
+/// Usage:
+///   // after drawing the frame
+///   capture.capture(0, width, height, "captures/frame_00001.png");
+///   // once per frame
+///   capture.poll();
+///   // before exiting, waits for every file
+///   capture.finish();
+class FrameCapture {
+public:
+  /// \param ring_size **[in]** read backs in flight (frames of latency)
+  /// \param max_encodes **[in]** frames copied out of the ring and waiting to be
+  ///                             encoded before capture() waits for the oldest
+  /// \param pool **[in]** encoding threads
+  explicit FrameCapture(u32 ring_size = 3, u32 max_encodes = 16, ThreadPool &pool = ThreadPool::global());
+  FrameCapture(const FrameCapture &) = delete;
+  FrameCapture &operator=(const FrameCapture &) = delete;
+  ~FrameCapture();
+  /// Queues the read back of the current content of **framebuffer**. Waits
+  /// only if every slot of the ring (or the encode queue) is still busy.
+  /// \param framebuffer **[in]** 0 reads the back buffer of the default framebuffer,
+  ///                             otherwise its color attachment 0
+  /// \param width **[in]**
+  /// \param height **[in]**
+  /// \param path **[in]** output file
+  /// \param format **[in]** CaptureFormat
+  void capture(GLuint framebuffer, u32 width, u32 height, const std::string &path,
+               int format = CaptureFormat::PNG);
+  /// Hands the read backs whose fence signaled to the thread pool, and
+  /// collects finished files. Never waits.
+  void poll();
+  /// Waits for every read back and file.
+  void finish();
+  void destroy();
+  /// \return read backs and encodes not finished yet
+  [[nodiscard]] u32 pending() const;
+
+  u32 captured{0}; //!< frames queued by capture()
+  u32 written{0};  //!< files written
+  u32 failed{0};   //!< files that could not be written
+  u32 stalls{0};   //!< times capture() had to wait for a busy ring or encode queue
+  std::string err; //!< last failure
+
+private:
+  struct State {
+    enum : int { FREE = 0, READING, COPYING };
+  };
+  struct Slot {
+    GLuint buffer{0};
+    size_t capacity{0};
+    const u8 *mapped{nullptr};
+    GLsync fence{nullptr};
+    int state{State::FREE};
+    /// cleared by the worker once the pixels are out of the mapped buffer
+    std::atomic<bool> copying{false};
+    u32 width{0};
+    u32 height{0};
+    int format{CaptureFormat::PNG};
+    std::string path;
+  };
+  struct Encode {
+    std::future<void> done;
+    std::shared_ptr<std::string> err; //!< empty on success
+  };
+  /// \return a free slot, waiting for the oldest read back if none
+  Slot &acquireSlot();
+  /// Starts the copy and encoding of **slot**, whose fence signaled
+  void encode(Slot &slot);
+  /// Collects finished encodes, all of them if **wait**
+  void collect(bool wait);
+
+  ThreadPool &pool_;
+  std::unique_ptr<Slot[]> slots_;
+  u32 ring_size_{0};
+  u32 next_{0}; //!< next slot to use, also the oldest in flight
+  u32 max_encodes_{0};
+  std::deque<Encode> encodes_;
+};
+
+#endif //GLSL_EXPERIMENTS_FRAME_CAPTURE_H
@@ -0,0 +1,108 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file gpu_mesh.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "gpu_mesh.h"
+
+GpuMesh::~GpuMesh() {
+  destroy();
+}
+
+void GpuMesh::upload(const MeshAttribute *attributes, u32 attribute_count, u32 stride,
+                     const void *vertices, size_t vertex_data_size, const u32 *indices, size_t index_count) {
+  if (!vao_) {
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glGenBuffers(1, &ibo_);
+  }
+  glBindVertexArray(vao_);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+  glBufferData(GL_ARRAY_BUFFER, vertex_data_size, vertices, GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_count * sizeof(u32), indices, GL_STATIC_DRAW);
+  for (u32 i = 0; i < MeshFileHeader::max_attributes; ++i)
+    glDisableVertexAttribArray(i);
+  for (u32 i = 0; i < attribute_count; ++i) {
+    const auto &a = attributes[i];
+    glEnableVertexAttribArray(i);
+    if (a.type == GL_FLOAT || a.type == GL_HALF_FLOAT || a.normalized)
+      glVertexAttribPointer(i, a.component_count, a.type, a.normalized ? GL_TRUE : GL_FALSE, stride,
+                            reinterpret_cast<const void *>(static_cast<uintptr_t>(a.offset)));
+    else
+      glVertexAttribIPointer(i, a.component_count, a.type, stride,
+                             reinterpret_cast<const void *>(static_cast<uintptr_t>(a.offset)));
+  }
+  glBindVertexArray(0);
+  lods_ = {MeshLod{0, static_cast<u32>(index_count), 0}};
+}
+
+void GpuMesh::upload(const MeshFile &file) {
+  const auto &header = file.header();
+  upload(header.attributes, header.attribute_count, header.vertex_stride,
+         file.vertexData(), file.vertexDataSize(), file.indexData(), header.index_count);
+}
+
+void GpuMesh::uploadLods(const LodChain &chain) {
+  if (!vao_ || chain.lods.empty())
+    return;
+  // the element buffer binding belongs to the vertex array
+  glBindVertexArray(vao_);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, chain.indices.size() * sizeof(u32), chain.indices.data(), GL_STATIC_DRAW);
+  glBindVertexArray(0);
+  lods_ = chain.lods;
+}
+
+void GpuMesh::destroy() {
+  if (vao_) {
+    glDeleteVertexArrays(1, &vao_);
+    glDeleteBuffers(1, &vbo_);
+    glDeleteBuffers(1, &ibo_);
+  }
+  vao_ = vbo_ = ibo_ = 0;
+  lods_.clear();
+}
+
+void GpuMesh::draw(u32 lod) const {
+  if (!vao_ || lods_.empty())
+    return;
+  const auto &range = level(lod);
+  glBindVertexArray(vao_);
+  glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(range.count), GL_UNSIGNED_INT,
+                 reinterpret_cast<const void *>(static_cast<uintptr_t>(range.first) * sizeof(u32)));
+  glBindVertexArray(0);
+}
+
+void GpuMesh::drawInstanced(u32 instance_count, u32 lod) const {
+  if (!vao_ || lods_.empty() || !instance_count)
+    return;
+  const auto &range = level(lod);
+  glBindVertexArray(vao_);
+  glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(range.count), GL_UNSIGNED_INT,
+                          reinterpret_cast<const void *>(static_cast<uintptr_t>(range.first) * sizeof(u32)),
+                          static_cast<GLsizei>(instance_count));
+  glBindVertexArray(0);
+}
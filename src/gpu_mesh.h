@@ -0,0 +1,83 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file gpu_mesh.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Indexed mesh uploaded from raw memory.
+
+#ifndef GLSL_EXPERIMENTS_GPU_MESH_H
+#define GLSL_EXPERIMENTS_GPU_MESH_H
+
+#include "mesh_file.h"
+#include "mesh_simplifier.h"
+
+#include <circe/circe.h>
+#include <algorithm>
+
+/// Vertex array with one interleaved vertex buffer and a u32 index buffer.
+/// Unlike circe::gl::VertexBuffer, data is uploaded directly from a pointer
+/// (ex: a memory mapped MeshFile), without going through a std::vector.
+///
+/// The index buffer may hold a LOD chain, one index range per level.
+class GpuMesh {
+public:
+  GpuMesh() = default;
+  GpuMesh(const GpuMesh &) = delete;
+  GpuMesh &operator=(const GpuMesh &) = delete;
+  ~GpuMesh();
+  /// \param attributes **[in]** attribute i is bound to location i
+  /// \param attribute_count **[in]**
+  /// \param stride **[in]** vertex size in bytes
+  /// \param vertices **[in]** interleaved vertex data
+  /// \param vertex_data_size **[in]** in bytes
+  /// \param indices **[in]** triangle list
+  /// \param index_count **[in]**
+  void upload(const MeshAttribute *attributes, u32 attribute_count, u32 stride,
+              const void *vertices, size_t vertex_data_size, const u32 *indices, size_t index_count);
+  /// \param file **[in]** opened mesh file
+  void upload(const MeshFile &file);
+  /// Replaces the index buffer, keeping the vertices
+  /// \param chain **[in]** levels of detail of the uploaded vertices
+  void uploadLods(const LodChain &chain);
+  void destroy();
+  /// \param lod **[in | optional]** level of detail, clamped to the available ones
+  void draw(u32 lod = 0) const;
+  /// Draws **instance_count** copies in a single call, shaders tell them apart
+  /// with gl_InstanceID
+  /// \param instance_count **[in]**
+  /// \param lod **[in | optional]**
+  void drawInstanced(u32 instance_count, u32 lod = 0) const;
+  /// \param lod **[in | optional]**
+  [[nodiscard]] size_t indexCount(u32 lod = 0) const { return lods_.empty() ? 0 : level(lod).count; }
+  [[nodiscard]] const std::vector<MeshLod> &lods() const { return lods_; }
+  /// \param lod **[in]** clamped to the available levels, requires an uploaded mesh
+  [[nodiscard]] const MeshLod &level(u32 lod) const { return lods_[std::min<size_t>(lod, lods_.size() - 1)]; }
+
+private:
+  GLuint vao_{0};
+  GLuint vbo_{0};
+  GLuint ibo_{0};
+  std::vector<MeshLod> lods_; //!< a single level unless uploadLods was called
+};
+
+#endif //GLSL_EXPERIMENTS_GPU_MESH_H
@@ -0,0 +1,102 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file gpu_timer.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "gpu_timer.h"
+
+#include <algorithm>
+#include <cstring>
+
+GpuTimer::GpuTimer(u32 ring_size) : queries_(std::max(ring_size, 1u), 0) {}
+
+GpuTimer::~GpuTimer() {
+  if (queries_[0])
+    glDeleteQueries(static_cast<GLsizei>(queries_.size()), queries_.data());
+}
+
+bool GpuTimer::supported() {
+  GLint major = 0, minor = 0;
+  glGetIntegerv(GL_MAJOR_VERSION, &major);
+  glGetIntegerv(GL_MINOR_VERSION, &minor);
+  if (major > 3 || (major == 3 && minor >= 3))
+    return true;
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i = 0; i < count; ++i) {
+    auto *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+    if (name && std::strcmp(name, "GL_ARB_timer_query") == 0)
+      return true;
+  }
+  return false;
+}
+
+void GpuTimer::begin() {
+  if (!queries_[0]) {
+    glGenQueries(static_cast<GLsizei>(queries_.size()), queries_.data());
+    free_.assign(queries_.rbegin(), queries_.rend());
+  }
+  if (free_.empty()) {
+    // the whole ring is in flight, the oldest result has to be waited for
+    GLuint oldest = in_flight_.front();
+    in_flight_.pop_front();
+    completed_.emplace_back(read(oldest));
+    free_.emplace_back(oldest);
+  }
+  active_ = free_.back();
+  free_.pop_back();
+  glBeginQuery(GL_TIME_ELAPSED, active_);
+}
+
+void GpuTimer::end() {
+  if (!active_)
+    return;
+  glEndQuery(GL_TIME_ELAPSED);
+  in_flight_.emplace_back(active_);
+  active_ = 0;
+}
+
+void GpuTimer::collect(std::vector<f64> &ms, bool wait) {
+  ms.insert(ms.end(), completed_.begin(), completed_.end());
+  completed_.clear();
+  while (!in_flight_.empty()) {
+    GLuint query = in_flight_.front();
+    GLint available = GL_FALSE;
+    if (!wait)
+      glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    // queries complete in order
+    if (!wait && !available)
+      break;
+    ms.emplace_back(read(query));
+    in_flight_.pop_front();
+    free_.emplace_back(query);
+  }
+}
+
+f64 GpuTimer::read(GLuint query) const {
+  GLuint64 ns = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+  return static_cast<f64>(ns) / 1e6;
+}
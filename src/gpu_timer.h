@@ -0,0 +1,73 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file gpu_timer.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#ifndef GLSL_EXPERIMENTS_GPU_TIMER_H
+#define GLSL_EXPERIMENTS_GPU_TIMER_H
+
+#include <circe/circe.h>
+#include <deque>
+
+/// Measures the GPU time spent between begin() and end() with
+/// GL_TIME_ELAPSED queries. Every measurement takes a query from a ring and
+/// results are only read once the driver has them, so the CPU does not wait
+/// for the GPU unless the whole ring is in flight.
+///
+/// Usage:
+///   GpuTimer timer;
+///   // every frame
+///   timer.begin(); draw(); timer.end();
+///   timer.collect(frame_times);
+class GpuTimer {
+public:
+  /// \param ring_size **[in | optional]** measurements in flight
+  explicit GpuTimer(u32 ring_size = 4);
+  ~GpuTimer();
+  GpuTimer(const GpuTimer &) = delete;
+  GpuTimer &operator=(const GpuTimer &) = delete;
+  /// \return true if the current context has timer queries (GL 3.3 or ARB_timer_query)
+  static bool supported();
+  void begin();
+  void end();
+  /// Appends the measurements that completed, oldest first.
+  /// \param ms **[out]**
+  /// \param wait **[in | optional]** blocks until every ended measurement is available
+  void collect(std::vector<f64> &ms, bool wait = false);
+  /// \return measurements ended but not collected yet
+  [[nodiscard]] size_t pending() const { return in_flight_.size() + completed_.size(); }
+
+private:
+  /// \return query result in ms
+  f64 read(GLuint query) const;
+
+  std::vector<GLuint> queries_;
+  std::deque<GLuint> in_flight_;
+  std::vector<GLuint> free_;
+  std::vector<f64> completed_; //!< read early because the ring was full
+  GLuint active_{0};
+};
+
+#endif //GLSL_EXPERIMENTS_GPU_TIMER_H
@@ -0,0 +1,61 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file hash.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2020-26-08
+///
+///\brief Content hashing used to detect source changes.
+
+#ifndef GLSL_EXPERIMENTS_HASH_H
+#define GLSL_EXPERIMENTS_HASH_H
+
+#include <ponos/ponos.h>
+#include <string>
+
+/// 64-bit FNV-1a offset basis
+constexpr u64 hash_seed = 14695981039346656037ull;
+
+/// 64-bit FNV-1a. Unlike std::hash its value is stable between runs, so it
+/// can be used to key data that outlives the process.
+/// \param data **[in]**
+/// \param size **[in]** in bytes
+/// \param seed **[in | optional]** previous hash value, to chain calls
+/// \return hash value
+inline u64 hash_bytes(const void *data, size_t size, u64 seed = hash_seed) {
+  auto *bytes = reinterpret_cast<const u8 *>(data);
+  u64 h = seed;
+  for (size_t i = 0; i < size; ++i) {
+    h ^= bytes[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+inline u64 hash_string(const std::string &s, u64 seed = hash_seed) {
+  return hash_bytes(s.data(), s.size(), seed);
+}
+
+inline u64 hash_combine(u64 a, u64 b) {
+  return hash_bytes(&b, sizeof(b), a);
+}
+
+#endif //GLSL_EXPERIMENTS_HASH_H
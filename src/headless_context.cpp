@@ -0,0 +1,124 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file headless_context.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "headless_context.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace {
+
+EGLDisplay surfacelessDisplay() {
+  auto get_platform_display =
+      reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+  if (!get_platform_display)
+    return EGL_NO_DISPLAY;
+  return get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+}
+
+}
+
+HeadlessContext::~HeadlessContext() {
+  destroy();
+}
+
+bool HeadlessContext::create(std::string &err, int major, int minor) {
+  destroy();
+  EGLDisplay display = surfacelessDisplay();
+  EGLint egl_major = 0, egl_minor = 0;
+  if (display == EGL_NO_DISPLAY || !eglInitialize(display, &egl_major, &egl_minor)) {
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &egl_major, &egl_minor)) {
+      err = "no EGL display";
+      return false;
+    }
+  }
+  display_ = display;
+  if (!eglBindAPI(EGL_OPENGL_API)) {
+    err = "EGL cannot bind the OpenGL API";
+    destroy();
+    return false;
+  }
+  const EGLint config_attributes[] = {
+      EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+      EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+      EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_DEPTH_SIZE, 24,
+      EGL_NONE};
+  EGLConfig config = nullptr;
+  EGLint config_count = 0;
+  if (!eglChooseConfig(display, config_attributes, &config, 1, &config_count) || config_count == 0) {
+    err = "no EGL config supports OpenGL";
+    destroy();
+    return false;
+  }
+  const EGLint context_attributes[] = {
+      EGL_CONTEXT_MAJOR_VERSION, major,
+      EGL_CONTEXT_MINOR_VERSION, minor,
+      EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+      EGL_NONE};
+  context_ = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+  if (context_ == EGL_NO_CONTEXT) {
+    context_ = nullptr;
+    err = "could not create an OpenGL " + std::to_string(major) + "." + std::to_string(minor) + " core context";
+    destroy();
+    return false;
+  }
+  // EGL_KHR_surfaceless_context lets the context be current without a surface
+  if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context_)) {
+    const EGLint pbuffer_attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    surface_ = eglCreatePbufferSurface(display, config, pbuffer_attributes);
+    if (surface_ == EGL_NO_SURFACE || !eglMakeCurrent(display, surface_, surface_, context_)) {
+      err = "could not make the EGL context current";
+      destroy();
+      return false;
+    }
+  }
+  if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+    err = "could not load the OpenGL entry points";
+    destroy();
+    return false;
+  }
+  return true;
+}
+
+void HeadlessContext::destroy() {
+  if (!display_)
+    return;
+  eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  if (surface_ && surface_ != EGL_NO_SURFACE)
+    eglDestroySurface(display_, surface_);
+  if (context_)
+    eglDestroyContext(display_, context_);
+  // the display is shared by every context of the process (one per worker
+  // thread in the validator), so it is not terminated here
+  display_ = context_ = surface_ = nullptr;
+}
+
+std::string HeadlessContext::renderer() const {
+  auto *name = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+  return name ? name : "";
+}
@@ -0,0 +1,59 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file headless_context.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Windowless OpenGL context.
+
+#ifndef GLSL_EXPERIMENTS_HEADLESS_CONTEXT_H
+#define GLSL_EXPERIMENTS_HEADLESS_CONTEXT_H
+
+#include <circe/circe.h>
+
+/// OpenGL context without a window, created through EGL. It prefers the
+/// surfaceless platform (Mesa: works on llvmpipe without a GPU or a display
+/// server) and falls back to the default display with a 1x1 pbuffer.
+/// Rendering is meant to go to framebuffer objects.
+class HeadlessContext {
+public:
+  HeadlessContext() = default;
+  HeadlessContext(const HeadlessContext &) = delete;
+  HeadlessContext &operator=(const HeadlessContext &) = delete;
+  ~HeadlessContext();
+  /// Creates the context, makes it current and loads the GL entry points.
+  /// \param major **[in | optional]** core profile version
+  /// \param minor **[in | optional]**
+  /// \param err **[out]**
+  /// \return false if no display/config/context fits the request
+  bool create(std::string &err, int major = 4, int minor = 4);
+  void destroy();
+  /// \return GL_RENDERER of the current context
+  [[nodiscard]] std::string renderer() const;
+
+private:
+  void *display_{nullptr};
+  void *context_{nullptr};
+  void *surface_{nullptr};
+};
+
+#endif //GLSL_EXPERIMENTS_HEADLESS_CONTEXT_H
@@ -0,0 +1,90 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file image.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "image.h"
+
+#include <cstring>
+
+// keep stb symbols local, circe may link its own copy
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+bool decodeImage(const std::string &path, Image &image, std::string &err) {
+  int width = 0, height = 0, channels = 0;
+  stbi_uc *pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+  if (!pixels) {
+    err = path + ": " + stbi_failure_reason();
+    return false;
+  }
+  ImageLevel level;
+  level.width = width;
+  level.height = height;
+  level.size = size_t(width) * height * 4;
+  image.format = PixelFormat::RGBA8;
+  image.levels = {level};
+  image.data.resize(level.size);
+  std::memcpy(image.data.data(), pixels, level.size);
+  image.generate_mipmaps = true;
+  stbi_image_free(pixels);
+  return true;
+}
+
+bool decodeHdrImage(const std::string &path, HdrImage &image, std::string &err) {
+  int width = 0, height = 0, channels = 0;
+  f32 *pixels = stbi_loadf(path.c_str(), &width, &height, &channels, 3);
+  if (!pixels) {
+    err = path + ": " + stbi_failure_reason();
+    return false;
+  }
+  image.width = width;
+  image.height = height;
+  image.data.assign(pixels, pixels + size_t(width) * height * 3);
+  stbi_image_free(pixels);
+  return true;
+}
+
+bool encodePng(const std::string &path, u32 width, u32 height, const u8 *rgba, std::string &err) {
+  if (!stbi_write_png(path.c_str(), static_cast<int>(width), static_cast<int>(height), 4, rgba,
+                      static_cast<int>(width * 4))) {
+    err = "could not write " + path;
+    return false;
+  }
+  return true;
+}
+
+bool encodeHdrImage(const std::string &path, const HdrImage &image, std::string &err) {
+  if (!stbi_write_hdr(path.c_str(), static_cast<int>(image.width), static_cast<int>(image.height), 3,
+                      image.data.data())) {
+    err = "could not write " + path;
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,114 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file image.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief CPU side images.
+
+#ifndef GLSL_EXPERIMENTS_IMAGE_H
+#define GLSL_EXPERIMENTS_IMAGE_H
+
+#include <ponos/ponos.h>
+#include <vector>
+
+enum class PixelFormat : u32 {
+  RGBA8 = 0,
+  BC1 = 1, //!< rgb, 8 bytes per 4x4 block
+  BC3 = 2, //!< rgba, 16 bytes per 4x4 block
+  BC5 = 3  //!< two channels (normal maps), 16 bytes per 4x4 block
+};
+
+inline const char *pixelFormatName(PixelFormat format) {
+  static const char *names[] = {"RGBA8", "BC1", "BC3", "BC5"};
+  return names[static_cast<u32>(format)];
+}
+/// \return true for block compressed formats
+inline bool isCompressed(PixelFormat format) { return format != PixelFormat::RGBA8; }
+/// \return pixel rows covered by one row of data (4 for block formats)
+inline u32 rowHeight(PixelFormat format) { return isCompressed(format) ? 4 : 1; }
+/// \return bytes in one row of data of an image **width** pixels wide
+inline size_t rowBytes(PixelFormat format, u32 width) {
+  switch (format) {
+  case PixelFormat::RGBA8: return size_t(width) * 4;
+  case PixelFormat::BC1: return size_t((width + 3) / 4) * 8;
+  default: return size_t((width + 3) / 4) * 16;
+  }
+}
+
+struct ImageLevel {
+  u32 width{0};
+  u32 height{0};
+  size_t offset{0}; //!< in Image::data
+  size_t size{0};   //!< in bytes
+};
+
+/// Image with one or more mip levels, stored contiguously in data.
+struct Image {
+  PixelFormat format{PixelFormat::RGBA8};
+  std::vector<ImageLevel> levels;
+  std::vector<u8> data;
+  /// Tells the uploader to generate the missing mip levels
+  bool generate_mipmaps{true};
+  [[nodiscard]] u32 width() const { return levels.empty() ? 0 : levels[0].width; }
+  [[nodiscard]] u32 height() const { return levels.empty() ? 0 : levels[0].height; }
+};
+
+/// Decodes a jpg/png/tga/bmp/... file into a single RGBA8 level.
+/// Thread safe.
+/// \param path **[in]** image file
+/// \param image **[out]**
+/// \param err **[out]** error description on failure
+/// \return false on failure
+bool decodeImage(const std::string &path, Image &image, std::string &err);
+
+/// Linear RGB float image (ex: an equirectangular HDR environment)
+struct HdrImage {
+  u32 width{0};
+  u32 height{0};
+  std::vector<f32> data; //!< rgb, first row on top
+};
+
+/// Decodes a Radiance .hdr file (or any format stb reads, converted to
+/// linear). Thread safe.
+/// \param path **[in]** image file
+/// \param image **[out]**
+/// \param err **[out]** error description on failure
+/// \return false on failure
+bool decodeHdrImage(const std::string &path, HdrImage &image, std::string &err);
+
+/// Encodes RGBA8 pixels as a png file. Thread safe.
+/// \param path **[in]** output file
+/// \param width **[in]**
+/// \param height **[in]**
+/// \param rgba **[in]** width * height pixels, first row on top
+/// \param err **[out]** error description on failure
+/// \return false if the file could not be written
+bool encodePng(const std::string &path, u32 width, u32 height, const u8 *rgba, std::string &err);
+/// Encodes **image** as a Radiance .hdr file. Thread safe.
+/// \param path **[in]** output file
+/// \param image **[in]**
+/// \param err **[out]** error description on failure
+/// \return false if the file could not be written
+bool encodeHdrImage(const std::string &path, const HdrImage &image, std::string &err);
+
+#endif //GLSL_EXPERIMENTS_IMAGE_H
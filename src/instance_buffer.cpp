@@ -0,0 +1,110 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file instance_buffer.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "instance_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// \return uniform value in [0, 1) for (**index**, **stream**), stable between runs
+f32 random01(u32 seed, u32 index, u32 stream) {
+  // splitmix64 finalizer
+  u64 z = (static_cast<u64>(seed) << 32 | index) * 0x9e3779b97f4a7c15ull + stream * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  z ^= z >> 31;
+  return static_cast<f32>(z >> 40) / static_cast<f32>(1u << 24);
+}
+
+}
+
+void generateInstances(const InstanceParams &params, std::vector<InstanceData> &instances, ThreadPool &pool) {
+  instances.resize(params.count);
+  const u32 side = std::max(1u, static_cast<u32>(std::ceil(std::cbrt(static_cast<f64>(params.count)))));
+  const f32 extent = side * params.spacing;
+  const f32 origin = -0.5f * (side - 1) * params.spacing;
+  pool.parallelFor(params.count, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const u32 index = static_cast<u32>(i);
+      f32 position[3], angle = 0, scale = params.scale;
+      if (params.layout == InstanceLayout::GRID) {
+        position[0] = origin + (index % side) * params.spacing;
+        position[1] = origin + (index / side % side) * params.spacing;
+        position[2] = origin + (index / (side * side)) * params.spacing;
+      } else {
+        for (u32 d = 0; d < 3; ++d)
+          position[d] = (random01(params.seed, index, d) - 0.5f) * extent;
+        angle = random01(params.seed, index, 3) * 6.2831853f;
+        scale *= 0.5f + random01(params.seed, index, 4);
+      }
+      // T * Ry * S
+      auto &instance = instances[i];
+      const f32 c = std::cos(angle) * scale, s = std::sin(angle) * scale;
+      const f32 model[16] = {c, 0, -s, 0,
+                             0, scale, 0, 0,
+                             s, 0, c, 0,
+                             position[0], position[1], position[2], 1};
+      std::copy(model, model + 16, instance.model);
+      for (u32 d = 0; d < 3; ++d)
+        instance.color[d] = 0.25f + 0.75f * random01(params.seed, index, 5 + d);
+      instance.color[3] = 1;
+    }
+  }, 1024);
+}
+
+InstanceBuffer::~InstanceBuffer() {
+  destroy();
+}
+
+void InstanceBuffer::upload(const std::vector<InstanceData> &instances) {
+  if (!buffer_)
+    glGenBuffers(1, &buffer_);
+  const size_t size = instances.size() * sizeof(InstanceData);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer_);
+  if (size > capacity_) {
+    glBufferData(GL_SHADER_STORAGE_BUFFER, size, instances.data(), GL_STATIC_DRAW);
+    capacity_ = size;
+  } else if (size) {
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, instances.data());
+  }
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  count_ = static_cast<u32>(instances.size());
+}
+
+void InstanceBuffer::bind() const {
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer_);
+}
+
+void InstanceBuffer::destroy() {
+  if (buffer_)
+    glDeleteBuffers(1, &buffer_);
+  buffer_ = 0;
+  capacity_ = 0;
+  count_ = 0;
+}
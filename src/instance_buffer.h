@@ -0,0 +1,99 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file instance_buffer.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Per instance data of instanced draws.
+
+#ifndef GLSL_EXPERIMENTS_INSTANCE_BUFFER_H
+#define GLSL_EXPERIMENTS_INSTANCE_BUFFER_H
+
+#include "thread_pool.h"
+
+#include <circe/circe.h>
+
+/// GLSL (std430):
+///   struct Instance {
+///     mat4 model;
+///     vec4 color;
+///   };
+///   layout(std430, binding = 2) readonly buffer InstanceBlock {
+///     Instance instances[];
+///   };
+struct InstanceData {
+  f32 model[16]{}; //!< column major
+  f32 color[4]{};
+};
+static_assert(sizeof(InstanceData) == 80, "InstanceData does not match the std430 layout");
+
+struct InstanceLayout {
+  enum : int { GRID = 0, RANDOM, COUNT };
+};
+
+struct InstanceParams {
+  u32 count{1000};
+  int layout{InstanceLayout::GRID};
+  f32 spacing{2.5f}; //!< distance between grid cells, random instances fill the same volume
+  f32 scale{1.f};
+  u32 seed{0};
+  bool operator==(const InstanceParams &other) const {
+    return count == other.count && layout == other.layout && spacing == other.spacing && scale == other.scale
+        && seed == other.seed;
+  }
+  bool operator!=(const InstanceParams &other) const { return !(*this == other); }
+};
+
+/// Computes the transforms and colors of **params.count** instances, centered
+/// at the origin. Grid instances fill a cube cell by cell, random instances
+/// get a random position, rotation around y and scale inside the same cube.
+/// Each instance only depends on its index, so ranges run in parallel and the
+/// output does not depend on the number of threads.
+/// \param params **[in]**
+/// \param instances **[out]**
+/// \param pool **[in | optional]**
+void generateInstances(const InstanceParams &params, std::vector<InstanceData> &instances,
+                       ThreadPool &pool = ThreadPool::global());
+
+/// Shader storage buffer holding the instances of an instanced draw.
+class InstanceBuffer {
+public:
+  static constexpr GLuint binding = 2;
+  InstanceBuffer() = default;
+  InstanceBuffer(const InstanceBuffer &) = delete;
+  InstanceBuffer &operator=(const InstanceBuffer &) = delete;
+  ~InstanceBuffer();
+  /// Replaces the buffer content, the storage only grows
+  /// \param instances **[in]**
+  void upload(const std::vector<InstanceData> &instances);
+  /// Binds the buffer to the InstanceBlock binding point
+  void bind() const;
+  void destroy();
+  [[nodiscard]] u32 count() const { return count_; }
+
+private:
+  GLuint buffer_{0};
+  size_t capacity_{0}; //!< in bytes
+  u32 count_{0};
+};
+
+#endif //GLSL_EXPERIMENTS_INSTANCE_BUFFER_H
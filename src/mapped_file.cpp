@@ -0,0 +1,111 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mapped_file.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "mapped_file.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#define MAPPED_FILE_NO_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &path) {
+  open(path);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    close();
+    fallback_ = std::move(other.fallback_);
+    data_ = fallback_.empty() ? other.data_ : fallback_.data();
+    size_ = other.size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+bool MappedFile::open(const std::string &path) {
+  close();
+#ifndef MAPPED_FILE_NO_MMAP
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st{};
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      data_ = static_cast<const u8 *>(p);
+      size_ = st.st_size;
+      // we read it once, front to back
+      madvise(p, size_, MADV_SEQUENTIAL);
+    }
+  }
+  ::close(fd);
+  return good();
+#else
+  FILE *file = fopen(path.c_str(), "rb");
+  if (!file)
+    return false;
+  fseek(file, 0, SEEK_END);
+  auto size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (size > 0) {
+    fallback_.resize(size);
+    if (fread(fallback_.data(), 1, size, file) == static_cast<size_t>(size)) {
+      data_ = fallback_.data();
+      size_ = size;
+    } else
+      fallback_.clear();
+  }
+  fclose(file);
+  return good();
+#endif
+}
+
+void MappedFile::close() {
+#ifndef MAPPED_FILE_NO_MMAP
+  if (data_ && fallback_.empty())
+    munmap(const_cast<u8 *>(data_), size_);
+#endif
+  fallback_.clear();
+  data_ = nullptr;
+  size_ = 0;
+}
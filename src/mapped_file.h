@@ -0,0 +1,60 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mapped_file.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Read-only memory mapped file.
+
+#ifndef GLSL_EXPERIMENTS_MAPPED_FILE_H
+#define GLSL_EXPERIMENTS_MAPPED_FILE_H
+
+#include <ponos/ponos.h>
+#include <vector>
+
+/// Maps a whole file into memory for reading. Platforms without mmap fall
+/// back to reading the file into an owned buffer.
+class MappedFile {
+public:
+  MappedFile() = default;
+  /// \param path **[in]** file path
+  explicit MappedFile(const std::string &path);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  ~MappedFile();
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  /// \param path **[in]** file path
+  /// \return false if the file could not be opened
+  bool open(const std::string &path);
+  void close();
+  [[nodiscard]] const u8 *data() const { return data_; }
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] bool good() const { return data_ != nullptr; }
+
+private:
+  const u8 *data_{nullptr};
+  size_t size_{0};
+  std::vector<u8> fallback_;
+};
+
+#endif //GLSL_EXPERIMENTS_MAPPED_FILE_H
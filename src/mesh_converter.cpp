@@ -0,0 +1,67 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_converter.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Converts OBJ assets into the editor binary mesh format.
+
+#include "mesh_file.h"
+#include "mesh_optimizer.h"
+
+#include <cstdio>
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    printf("usage: %s input.obj [output.mesh]\n", argv[0]);
+    return -1;
+  }
+  std::string input = argv[1];
+  std::string output = argc > 2 ? argv[2] : meshCachePath(input);
+  MeshSourceStamp stamp;
+  if (!stamp.read(input)) {
+    printf("could not read %s\n", input.c_str());
+    return -1;
+  }
+  ObjMesh mesh;
+  ObjLoadStats stats;
+  std::string err;
+  ponos::Timer timer;
+  if (!loadObj(input, mesh, err, ThreadPool::global(), &stats)) {
+    printf("%s: %s\n", input.c_str(), err.c_str());
+    return -1;
+  }
+  auto load_ms = timer.tack();
+  // same layout openMeshCached produces
+  auto report = optimizeMesh(mesh.vertex_data, ObjMesh::vertex_stride, mesh.index_data);
+  mesh.vertex_count = static_cast<u32>(mesh.vertex_data.size() / ObjMesh::vertex_stride);
+  timer.tick();
+  if (!writeMeshFile(output, mesh, stamp)) {
+    printf("could not write %s\n", output.c_str());
+    return -1;
+  }
+  printf("%s -> %s\n  %u vertices, %zu triangles\n  ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n"
+         "  import %.1f ms, optimize %.1f ms, write %.1f ms\n",
+         input.c_str(), output.c_str(), mesh.vertex_count, mesh.index_data.size() / 3, report.before.acmr,
+         report.after.acmr, report.before.atvr, report.after.atvr, load_ms, report.ms, timer.tack());
+  return 0;
+}
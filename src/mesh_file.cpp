@@ -0,0 +1,182 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_file.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "mesh_file.h"
+#include "mesh_optimizer.h"
+#include "vertex_format.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+/// GL_FLOAT, without pulling GL headers into GL free code
+constexpr u32 gl_float = 0x1406;
+
+u64 alignUp(u64 offset) {
+  return (offset + mesh_file_alignment - 1) / mesh_file_alignment * mesh_file_alignment;
+}
+
+MeshAttribute attribute(const char *name, u32 component_count, u32 offset) {
+  MeshAttribute a;
+  strncpy(a.name, name, sizeof(a.name) - 1);
+  a.component_count = component_count;
+  a.type = gl_float;
+  a.offset = offset;
+  return a;
+}
+
+MeshFileHeader meshFileHeader(const ObjMesh &mesh, const MeshSourceStamp &stamp) {
+  MeshFileHeader header;
+  header.version = mesh_file_version;
+  header.source_size = stamp.size;
+  header.source_mtime = stamp.mtime;
+  header.vertex_count = mesh.vertex_count;
+  header.index_count = static_cast<u32>(mesh.index_data.size());
+  header.vertex_stride = mesh_file_vertex_stride * sizeof(f32);
+  header.attribute_count = 5;
+  header.attributes[0] = attribute("position", 3, 0);
+  header.attributes[1] = attribute("normal", 3, 3 * sizeof(f32));
+  header.attributes[2] = attribute("uv", 2, 6 * sizeof(f32));
+  header.attributes[3] = attribute("tangent", 3, 8 * sizeof(f32));
+  header.attributes[4] = attribute("bitangent", 3, 11 * sizeof(f32));
+  for (int d = 0; d < 3; ++d) {
+    header.bounds_min[d] = mesh.bounds_min[d];
+    header.bounds_max[d] = mesh.bounds_max[d];
+  }
+  header.vertex_offset = alignUp(sizeof(MeshFileHeader));
+  header.index_offset = alignUp(header.vertex_offset + u64(header.vertex_count) * header.vertex_stride);
+  return header;
+}
+
+/// \return the vertices of **mesh** with their tangent frames, as stored in the file
+std::vector<f32> meshFileVertices(const ObjMesh &mesh) {
+  return addTangentFrames(mesh.vertex_data.data(), mesh.vertex_count, ObjMesh::vertex_stride, 3,
+                          mesh.has_uvs ? 6 : -1, mesh.index_data.data(), mesh.index_data.size());
+}
+
+}
+
+bool MeshSourceStamp::read(const std::string &path) {
+  std::error_code ec;
+  auto file_size = std::filesystem::file_size(path, ec);
+  if (ec)
+    return false;
+  auto time = std::filesystem::last_write_time(path, ec);
+  if (ec)
+    return false;
+  size = file_size;
+  mtime = static_cast<i64>(time.time_since_epoch().count());
+  return true;
+}
+
+std::string meshCachePath(const std::string &path) {
+  return std::filesystem::path(path).replace_extension(".mesh").string();
+}
+
+bool writeMeshFile(const std::string &path, const ObjMesh &mesh, const MeshSourceStamp &stamp) {
+  auto header = meshFileHeader(mesh, stamp);
+  auto vertices = meshFileVertices(mesh);
+  // write to a temporary file first so readers never map a partial file
+  auto tmp_path = path + ".tmp";
+  FILE *file = fopen(tmp_path.c_str(), "wb");
+  if (!file)
+    return false;
+  const u8 padding[mesh_file_alignment] = {};
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  ok = ok && fwrite(padding, 1, header.vertex_offset - sizeof(header), file) == header.vertex_offset - sizeof(header);
+  ok = ok && fwrite(vertices.data(), sizeof(f32), vertices.size(), file) == vertices.size();
+  auto vertex_end = header.vertex_offset + vertices.size() * sizeof(f32);
+  ok = ok && fwrite(padding, 1, header.index_offset - vertex_end, file) == header.index_offset - vertex_end;
+  ok = ok && fwrite(mesh.index_data.data(), sizeof(u32), mesh.index_data.size(), file) == mesh.index_data.size();
+  ok = fclose(file) == 0 && ok;
+  std::error_code ec;
+  if (ok)
+    std::filesystem::rename(tmp_path, path, ec);
+  else
+    std::filesystem::remove(tmp_path, ec);
+  return ok && !ec;
+}
+
+bool MeshFile::open(const std::string &path) {
+  header_ = nullptr;
+  vertices_ = std::vector<f32>();
+  indices_ = std::vector<u32>();
+  if (!file_.open(path) || file_.size() < sizeof(MeshFileHeader))
+    return false;
+  auto *header = reinterpret_cast<const MeshFileHeader *>(file_.data());
+  if (std::memcmp(header->magic, "GMSH", 4) != 0 || header->version != mesh_file_version
+      || header->attribute_count > MeshFileHeader::max_attributes
+      || header->vertex_offset + u64(header->vertex_count) * header->vertex_stride > file_.size()
+      || header->index_offset + u64(header->index_count) * sizeof(u32) > file_.size()
+      || header->index_offset % alignof(u32)) {
+    file_.close();
+    return false;
+  }
+  header_ = header;
+  return true;
+}
+
+void MeshFile::assign(ObjMesh &&mesh, const MeshSourceStamp &stamp) {
+  file_.close();
+  memory_header_ = meshFileHeader(mesh, stamp);
+  vertices_ = meshFileVertices(mesh);
+  indices_ = std::move(mesh.index_data);
+  header_ = &memory_header_;
+}
+
+bool MeshFile::matches(const MeshSourceStamp &stamp) const {
+  return header_ && header_->source_size == stamp.size && header_->source_mtime == stamp.mtime;
+}
+
+bool openMeshCached(const std::string &path, MeshFile &file, std::string &err, bool *from_cache,
+                    std::string *warning) {
+  MeshSourceStamp stamp;
+  if (!stamp.read(path)) {
+    err = "could not open " + path;
+    return false;
+  }
+  auto cache_path = meshCachePath(path);
+  bool cached = file.open(cache_path) && file.matches(stamp);
+  if (from_cache)
+    *from_cache = cached;
+  if (cached)
+    return true;
+  ObjMesh obj;
+  if (!loadObj(path, obj, err))
+    return false;
+  optimizeMesh(obj.vertex_data, ObjMesh::vertex_stride, obj.index_data);
+  obj.vertex_count = static_cast<u32>(obj.vertex_data.size() / ObjMesh::vertex_stride);
+  if (!writeMeshFile(cache_path, obj, stamp) || !file.open(cache_path)) {
+    // the mapping only saves the next import, the mesh is already here
+    if (warning)
+      *warning = "could not write " + cache_path + ", mesh kept in memory";
+    file.assign(std::move(obj), stamp);
+  }
+  return true;
+}
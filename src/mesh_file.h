@@ -0,0 +1,143 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_file.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Binary mesh cache format.
+
+#ifndef GLSL_EXPERIMENTS_MESH_FILE_H
+#define GLSL_EXPERIMENTS_MESH_FILE_H
+
+#include "mapped_file.h"
+#include "obj_loader.h"
+
+/// Vertex attribute description stored in the file, one entry per
+/// VertexBuffer::Attributes::push call (attribute i goes to location i).
+struct MeshAttribute {
+  char name[16]{};
+  u32 component_count{0};
+  u32 type{0};       //!< GL type enum (GL_FLOAT, GL_SHORT, ...)
+  u32 normalized{0}; //!< GL_TRUE if integer data is normalized
+  u32 offset{0};     //!< in bytes, inside a vertex
+};
+
+/// File layout:
+///   MeshFileHeader
+///   vertex blob (aligned to mesh_file_alignment)
+///   index blob (u32, aligned to mesh_file_alignment)
+struct MeshFileHeader {
+  static constexpr u32 max_attributes = 8;
+  char magic[4]{'G', 'M', 'S', 'H'};
+  u32 version{0};
+  // source asset this cache was produced from
+  u64 source_size{0};
+  i64 source_mtime{0};
+  u32 vertex_count{0};
+  u32 index_count{0};
+  u32 vertex_stride{0}; //!< in bytes
+  u32 attribute_count{0};
+  MeshAttribute attributes[max_attributes];
+  f32 bounds_min[3]{};
+  f32 bounds_max[3]{};
+  u64 vertex_offset{0};
+  u64 index_offset{0};
+};
+
+/// 2: vertices and indices are stored in the order optimizeMesh gives them
+/// 3: tangent and bitangent follow position, normal and uv
+constexpr u32 mesh_file_version = 3;
+/// position, normal, uv, tangent and bitangent
+constexpr u32 mesh_file_vertex_stride = ObjMesh::vertex_stride + 6;
+constexpr u64 mesh_file_alignment = 64;
+
+/// Identifies the version of a source asset
+struct MeshSourceStamp {
+  u64 size{0};
+  i64 mtime{0};
+  /// \param path **[in]** source file
+  /// \return false if the file does not exist
+  bool read(const std::string &path);
+};
+
+/// \param path **[in]** source asset path
+/// \return cache file path, next to the source (foo.obj -> foo.mesh)
+std::string meshCachePath(const std::string &path);
+
+/// \param path **[in]** output file
+/// \param mesh **[in]**
+/// \param stamp **[in]** version of the source asset
+/// \return false if the file could not be written
+bool writeMeshFile(const std::string &path, const ObjMesh &mesh, const MeshSourceStamp &stamp);
+
+/// Memory mapped mesh file. Vertex and index data point straight into the
+/// mapping, so they can be handed to the GL upload without copies. When the
+/// file could not be written, the mesh is held in memory instead (see assign).
+class MeshFile {
+public:
+  MeshFile() = default;
+  MeshFile(const MeshFile &) = delete;
+  MeshFile &operator=(const MeshFile &) = delete;
+  /// \param path **[in]** .mesh file
+  /// \return false if missing, truncated or from another format version
+  bool open(const std::string &path);
+  /// Holds **mesh** in memory, with the header a .mesh file of it would have.
+  /// \param mesh **[in]** moved into the file
+  /// \param stamp **[in]** version of the source asset
+  void assign(ObjMesh &&mesh, const MeshSourceStamp &stamp);
+  /// \return true if the data comes from a mapped .mesh file
+  [[nodiscard]] bool mapped() const { return file_.good(); }
+  /// \return true if the file was produced from the given source version
+  [[nodiscard]] bool matches(const MeshSourceStamp &stamp) const;
+  [[nodiscard]] const MeshFileHeader &header() const { return *header_; }
+  [[nodiscard]] const void *vertexData() const {
+    return mapped() ? static_cast<const void *>(file_.data() + header_->vertex_offset) : vertices_.data();
+  }
+  [[nodiscard]] const u32 *indexData() const {
+    return mapped() ? reinterpret_cast<const u32 *>(file_.data() + header_->index_offset) : indices_.data();
+  }
+  [[nodiscard]] size_t vertexDataSize() const { return size_t(header_->vertex_count) * header_->vertex_stride; }
+
+private:
+  MappedFile file_;
+  const MeshFileHeader *header_{nullptr};
+  // used instead of the mapping after assign
+  MeshFileHeader memory_header_;
+  std::vector<f32> vertices_;
+  std::vector<u32> indices_;
+};
+
+/// Opens the binary cache of an OBJ asset (foo.obj -> foo.mesh), which is
+/// (re)generated whenever it is missing or older than the source. Imported
+/// meshes go through optimizeMesh before being written. If the cache can not
+/// be written (read only directory, full disk), the imported mesh is kept in
+/// memory instead.
+/// \param path **[in]** OBJ file
+/// \param file **[out]**
+/// \param err **[out]**
+/// \param from_cache **[out | optional]** true if the cache was up to date
+/// \param warning **[out | optional]** set if the cache could not be written
+/// \return false if the asset could not be imported
+bool openMeshCached(const std::string &path, MeshFile &file, std::string &err, bool *from_cache = nullptr,
+                    std::string *warning = nullptr);
+
+#endif //GLSL_EXPERIMENTS_MESH_FILE_H
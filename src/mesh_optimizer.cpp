@@ -0,0 +1,266 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_optimizer.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+/// FIFO cache where a vertex is resident while fewer than size vertices
+/// entered after it, tracked with a timestamp per vertex
+struct CacheSimulator {
+  CacheSimulator(size_t vertex_count, u32 size) : timestamps(vertex_count, 0), time(size + 1), size(size) {}
+  /// \return true if **v** was missing (and is now the newest entry)
+  bool access(u32 v) {
+    if (time - timestamps[v] <= size)
+      return false;
+    timestamps[v] = time++;
+    return true;
+  }
+  /// \return number of vertices of triangle **t** that were missing
+  u32 triangle(const u32 *indices, size_t t) {
+    return access(indices[t * 3]) + access(indices[t * 3 + 1]) + access(indices[t * 3 + 2]);
+  }
+  /// Evicts every vertex
+  void flush() { time += size + 1; }
+  std::vector<u32> timestamps;
+  u32 time;
+  u32 size;
+};
+
+}
+
+VertexCacheStats analyzeVertexCache(const u32 *indices, size_t index_count, size_t vertex_count, u32 cache_size) {
+  VertexCacheStats stats;
+  const size_t triangle_count = index_count / 3;
+  if (!triangle_count)
+    return stats;
+  CacheSimulator cache(vertex_count, cache_size);
+  std::vector<u8> used(vertex_count, 0);
+  size_t misses = 0, used_count = 0;
+  for (size_t t = 0; t < triangle_count; ++t)
+    misses += cache.triangle(indices, t);
+  for (size_t i = 0; i < index_count; ++i)
+    if (!used[indices[i]]) {
+      used[indices[i]] = 1;
+      used_count++;
+    }
+  stats.acmr = static_cast<f32>(misses) / triangle_count;
+  stats.atvr = static_cast<f32>(misses) / used_count;
+  return stats;
+}
+
+void optimizeVertexCache(u32 *indices, size_t index_count, size_t vertex_count, u32 cache_size) {
+  const size_t triangle_count = index_count / 3;
+  if (!triangle_count)
+    return;
+  const std::vector<u32> input(indices, indices + triangle_count * 3);
+  // vertex -> triangles
+  std::vector<u32> live(vertex_count, 0);
+  for (auto v : input)
+    live[v]++;
+  std::vector<u32> offsets(vertex_count + 1, 0);
+  std::partial_sum(live.begin(), live.end(), offsets.begin() + 1);
+  std::vector<u32> adjacency(input.size());
+  std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < input.size(); ++i)
+    adjacency[fill[input[i]]++] = static_cast<u32>(i / 3);
+
+  CacheSimulator cache(vertex_count, cache_size);
+  std::vector<u8> emitted(triangle_count, 0);
+  std::vector<u32> dead_end, candidates;
+  dead_end.reserve(input.size());
+  size_t output = 0;
+  size_t cursor = 0; //!< next vertex checked when the dead end stack runs out
+  i64 fanning = input[0];
+  while (fanning >= 0) {
+    const auto f = static_cast<u32>(fanning);
+    candidates.clear();
+    for (u32 k = offsets[f]; k < offsets[f + 1]; ++k) {
+      const u32 t = adjacency[k];
+      if (emitted[t])
+        continue;
+      emitted[t] = 1;
+      for (u32 c = 0; c < 3; ++c) {
+        const u32 v = input[t * 3 + c];
+        indices[output++] = v;
+        dead_end.emplace_back(v);
+        candidates.emplace_back(v);
+        live[v]--;
+        cache.access(v);
+      }
+    }
+    // the candidate that stays the longest in the cache after its remaining
+    // triangles are emitted
+    fanning = -1;
+    u32 best_priority = 0;
+    for (auto v : candidates) {
+      if (!live[v])
+        continue;
+      const u32 age = cache.time - cache.timestamps[v];
+      if (age + 2 * live[v] <= cache_size && age > best_priority) {
+        best_priority = age;
+        fanning = v;
+      }
+    }
+    if (fanning >= 0)
+      continue;
+    // dead end: most recent vertex with triangles left, or any vertex
+    while (!dead_end.empty() && fanning < 0) {
+      const u32 v = dead_end.back();
+      dead_end.pop_back();
+      if (live[v])
+        fanning = v;
+    }
+    for (; fanning < 0 && cursor < vertex_count; ++cursor)
+      if (live[cursor])
+        fanning = static_cast<i64>(cursor);
+  }
+}
+
+void optimizeOverdraw(u32 *indices, size_t index_count, const f32 *vertices, size_t vertex_count, u32 vertex_stride,
+                      u32 cache_size, f32 threshold) {
+  const size_t triangle_count = index_count / 3;
+  if (triangle_count < 2)
+    return;
+  // hard boundaries: triangles missing every vertex restart the cache
+  std::vector<size_t> hard{0};
+  {
+    CacheSimulator cache(vertex_count, cache_size);
+    for (size_t t = 0; t < triangle_count; ++t)
+      if (cache.triangle(indices, t) == 3 && t)
+        hard.emplace_back(t);
+  }
+  hard.emplace_back(triangle_count);
+  // soft boundaries: split where the running miss ratio is already as good
+  // as the whole cluster one (within threshold)
+  std::vector<size_t> clusters;
+  CacheSimulator cache(vertex_count, cache_size);
+  for (size_t h = 0; h + 1 < hard.size(); ++h) {
+    const size_t begin = hard[h], end = hard[h + 1];
+    cache.flush();
+    size_t misses = 0;
+    for (size_t t = begin; t < end; ++t)
+      misses += cache.triangle(indices, t);
+    const f32 cluster_threshold = threshold * misses / (end - begin);
+    cache.flush();
+    size_t start = begin;
+    misses = 0;
+    clusters.emplace_back(begin);
+    for (size_t t = begin; t < end; ++t) {
+      misses += cache.triangle(indices, t);
+      if (t + 1 < end && static_cast<f32>(misses) / (t + 1 - start) <= cluster_threshold) {
+        clusters.emplace_back(t + 1);
+        start = t + 1;
+        misses = 0;
+        cache.flush();
+      }
+    }
+  }
+  clusters.emplace_back(triangle_count);
+  // area weighted centroid and normal of each cluster
+  const size_t cluster_count = clusters.size() - 1;
+  std::vector<f32> centroids(cluster_count * 3, 0), normals(cluster_count * 3, 0);
+  f64 mesh_centroid[3] = {0, 0, 0}, mesh_area = 0;
+  for (size_t c = 0; c < cluster_count; ++c) {
+    f64 area_sum = 0;
+    for (size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+      const f32 *p0 = vertices + size_t(indices[t * 3]) * vertex_stride;
+      const f32 *p1 = vertices + size_t(indices[t * 3 + 1]) * vertex_stride;
+      const f32 *p2 = vertices + size_t(indices[t * 3 + 2]) * vertex_stride;
+      const f32 e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const f32 e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      const f32 n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+      const f32 area = 0.5f * std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      for (u32 d = 0; d < 3; ++d) {
+        const f32 center = (p0[d] + p1[d] + p2[d]) / 3;
+        centroids[c * 3 + d] += center * area;
+        normals[c * 3 + d] += n[d];
+        mesh_centroid[d] += center * area;
+      }
+      area_sum += area;
+    }
+    mesh_area += area_sum;
+    for (u32 d = 0; d < 3; ++d)
+      centroids[c * 3 + d] = area_sum > 0 ? static_cast<f32>(centroids[c * 3 + d] / area_sum) : 0;
+  }
+  for (auto &d : mesh_centroid)
+    d = mesh_area > 0 ? d / mesh_area : 0;
+  std::vector<f32> sort_keys(cluster_count);
+  for (size_t c = 0; c < cluster_count; ++c) {
+    const f32 *n = &normals[c * 3];
+    const f32 length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    f32 key = 0;
+    for (u32 d = 0; d < 3; ++d)
+      key += static_cast<f32>(centroids[c * 3 + d] - mesh_centroid[d]) * (length > 0 ? n[d] / length : 0);
+    sort_keys[c] = key;
+  }
+  std::vector<u32> order(cluster_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) { return sort_keys[a] > sort_keys[b]; });
+  const std::vector<u32> input(indices, indices + triangle_count * 3);
+  size_t output = 0;
+  for (auto c : order)
+    for (size_t i = clusters[c] * 3; i < clusters[c + 1] * 3; ++i)
+      indices[output++] = input[i];
+}
+
+size_t optimizeVertexFetch(f32 *vertices, size_t vertex_count, u32 vertex_stride, u32 *indices, size_t index_count) {
+  constexpr u32 unused = ~0u;
+  std::vector<u32> remap(vertex_count, unused);
+  u32 next = 0;
+  for (size_t i = 0; i < index_count; ++i) {
+    auto &r = remap[indices[i]];
+    if (r == unused)
+      r = next++;
+    indices[i] = r;
+  }
+  const std::vector<f32> input(vertices, vertices + vertex_count * vertex_stride);
+  for (size_t v = 0; v < vertex_count; ++v)
+    if (remap[v] != unused)
+      std::copy_n(&input[v * vertex_stride], vertex_stride, vertices + size_t(remap[v]) * vertex_stride);
+  return next;
+}
+
+MeshOptimizationReport optimizeMesh(std::vector<f32> &vertex_data, u32 vertex_stride, std::vector<u32> &index_data,
+                                    u32 cache_size) {
+  MeshOptimizationReport report;
+  ponos::Timer timer;
+  size_t vertex_count = vertex_data.size() / vertex_stride;
+  report.before = analyzeVertexCache(index_data.data(), index_data.size(), vertex_count, cache_size);
+  optimizeVertexCache(index_data.data(), index_data.size(), vertex_count, cache_size);
+  optimizeOverdraw(index_data.data(), index_data.size(), vertex_data.data(), vertex_count, vertex_stride, cache_size);
+  vertex_count = optimizeVertexFetch(vertex_data.data(), vertex_count, vertex_stride, index_data.data(),
+                                     index_data.size());
+  vertex_data.resize(vertex_count * vertex_stride);
+  report.after = analyzeVertexCache(index_data.data(), index_data.size(), vertex_count, cache_size);
+  report.ms = timer.tack();
+  return report;
+}
@@ -0,0 +1,102 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_optimizer.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Index and vertex reordering for GPU vertex processing.
+
+#ifndef GLSL_EXPERIMENTS_MESH_OPTIMIZER_H
+#define GLSL_EXPERIMENTS_MESH_OPTIMIZER_H
+
+#include <ponos/ponos.h>
+#include <vector>
+
+/// Post-transform cache size assumed by the optimizations (FIFO entries)
+constexpr u32 default_vertex_cache_size = 16;
+
+/// Efficiency of an index buffer for a FIFO post-transform vertex cache
+struct VertexCacheStats {
+  f32 acmr{0}; //!< average cache miss ratio, transformed vertices per triangle (0.5 is ideal, 3 is worst)
+  f32 atvr{0}; //!< average transform to vertex ratio, transformed per referenced vertex (1 is ideal)
+};
+
+/// Simulates a FIFO cache of **cache_size** entries over a triangle list
+/// \param indices **[in]**
+/// \param index_count **[in]**
+/// \param vertex_count **[in]**
+/// \param cache_size **[in | optional]**
+/// \return stats
+VertexCacheStats analyzeVertexCache(const u32 *indices, size_t index_count, size_t vertex_count,
+                                    u32 cache_size = default_vertex_cache_size);
+
+/// Reorders triangles for post-transform cache locality (Tipsify, Sander et
+/// al. 2007): triangles are emitted as fans around vertices that are still
+/// in the cache, in linear time.
+/// \param indices **[in/out]** triangle list
+/// \param index_count **[in]**
+/// \param vertex_count **[in]**
+/// \param cache_size **[in | optional]**
+void optimizeVertexCache(u32 *indices, size_t index_count, size_t vertex_count,
+                         u32 cache_size = default_vertex_cache_size);
+
+/// Reorders clusters of a cache optimized triangle list so triangles likely
+/// to occlude others are drawn first (Sander et al. 2007). Clusters start at
+/// cache restarts and are split further while their miss ratio stays under
+/// **threshold** times the one of the cluster, then sorted by how much they
+/// face away from the mesh centroid.
+/// \param indices **[in/out]** triangle list, output of optimizeVertexCache
+/// \param index_count **[in]**
+/// \param vertices **[in]** interleaved vertex data, position first
+/// \param vertex_count **[in]**
+/// \param vertex_stride **[in]** in floats
+/// \param cache_size **[in | optional]**
+/// \param threshold **[in | optional]** allowed ACMR growth, 1.05 keeps ACMR within 5%
+void optimizeOverdraw(u32 *indices, size_t index_count, const f32 *vertices, size_t vertex_count,
+                      u32 vertex_stride, u32 cache_size = default_vertex_cache_size, f32 threshold = 1.05f);
+
+/// Renumbers vertices in the order the index buffer first uses them, so the
+/// vertex fetch reads memory sequentially. Unused vertices are dropped.
+/// \param vertices **[in/out]** interleaved vertex data
+/// \param vertex_count **[in]**
+/// \param vertex_stride **[in]** in floats
+/// \param indices **[in/out]**
+/// \param index_count **[in]**
+/// \return new vertex count
+size_t optimizeVertexFetch(f32 *vertices, size_t vertex_count, u32 vertex_stride, u32 *indices, size_t index_count);
+
+struct MeshOptimizationReport {
+  VertexCacheStats before;
+  VertexCacheStats after;
+  f64 ms{0};
+};
+
+/// Runs vertex cache, overdraw and vertex fetch optimizations in that order
+/// \param vertex_data **[in/out]** interleaved vertex data, position first
+/// \param vertex_stride **[in]** in floats
+/// \param index_data **[in/out]** triangle list
+/// \param cache_size **[in | optional]**
+/// \return cache stats before and after
+MeshOptimizationReport optimizeMesh(std::vector<f32> &vertex_data, u32 vertex_stride, std::vector<u32> &index_data,
+                                    u32 cache_size = default_vertex_cache_size);
+
+#endif //GLSL_EXPERIMENTS_MESH_OPTIMIZER_H
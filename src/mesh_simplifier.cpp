@@ -0,0 +1,435 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_simplifier.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+/// Sum of squared distances to a set of planes, as a symmetric 4x4 matrix
+struct Quadric {
+  /// \param n **[in]** unit plane normal
+  /// \param d **[in]** plane offset, n.p + d = 0
+  /// \param weight **[in]**
+  void addPlane(const f64 n[3], f64 d, f64 weight) {
+    const f64 p[4] = {n[0], n[1], n[2], d};
+    for (int i = 0, k = 0; i < 4; ++i)
+      for (int j = i; j < 4; ++j)
+        a[k++] += weight * p[i] * p[j];
+    w += weight;
+  }
+  void add(const Quadric &q) {
+    for (int i = 0; i < 10; ++i)
+      a[i] += q.a[i];
+    w += q.w;
+  }
+  /// \return mean squared distance of **p** to the planes
+  [[nodiscard]] f64 error(const f32 p[3]) const {
+    const f64 x = p[0], y = p[1], z = p[2];
+    const f64 e = a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x
+        + a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y
+        + a[7] * z * z + 2 * a[8] * z + a[9];
+    return w > 0 ? std::abs(e) / w : 0;
+  }
+  f64 a[10]{}; //!< upper triangle, row major
+  f64 w{0};
+};
+
+void cross(const f64 a[3], const f64 b[3], f64 c[3]) {
+  c[0] = a[1] * b[2] - a[2] * b[1];
+  c[1] = a[2] * b[0] - a[0] * b[2];
+  c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+f64 normalize(f64 v[3]) {
+  const f64 length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  if (length > 0)
+    for (int d = 0; d < 3; ++d)
+      v[d] /= length;
+  return length;
+}
+
+/// \return unnormalized normal of the triangle (a, b, c)
+void triangleNormal(const f32 *a, const f32 *b, const f32 *c, f64 n[3]) {
+  const f64 ab[3] = {f64(b[0]) - a[0], f64(b[1]) - a[1], f64(b[2]) - a[2]};
+  const f64 ac[3] = {f64(c[0]) - a[0], f64(c[1]) - a[1], f64(c[2]) - a[2]};
+  cross(ab, ac, n);
+}
+
+u64 edgeKey(u32 a, u32 b) {
+  return a < b ? (u64(a) << 32 | b) : (u64(b) << 32 | a);
+}
+
+struct Collapse {
+  u32 from;
+  u32 to;
+  f64 cost;
+};
+
+/// Edge collapse state, in terms of position groups (vertices sharing a
+/// position) while triangles keep the actual vertices of their corners
+class Simplifier {
+public:
+  Simplifier(const u32 *indices, size_t index_count, const f32 *vertices, size_t vertex_count, u32 vertex_stride)
+      : vertices_(vertices), stride_(vertex_stride), group_(vertex_count) {
+    // group vertices by position
+    std::unordered_map<u64, std::vector<u32>> buckets;
+    auto position_hash = [&](u32 v) {
+      u32 bits[3];
+      memcpy(bits, position(v), sizeof(bits));
+      return (bits[0] * 73856093ull) ^ (bits[1] * 19349663ull) ^ (bits[2] * 83492791ull);
+    };
+    for (u32 v = 0; v < vertex_count; ++v) {
+      auto &bucket = buckets[position_hash(v)];
+      u32 group = ~0u;
+      for (auto g : bucket)
+        if (!memcmp(position(group_vertices_[g][0]), position(v), 3 * sizeof(f32)))
+          group = g;
+      if (group == ~0u) {
+        group = static_cast<u32>(group_vertices_.size());
+        group_vertices_.emplace_back();
+        bucket.emplace_back(group);
+      }
+      group_vertices_[group].emplace_back(v);
+      group_[v] = group;
+    }
+    const size_t group_count = group_vertices_.size();
+    group_triangles_.resize(group_count);
+    quadrics_.resize(group_count);
+    alive_.assign(group_count, true);
+    locked_.assign(group_count, false);
+    // triangles, degenerate ones are dropped
+    for (size_t t = 0; t + 2 < index_count; t += 3) {
+      const u32 a = indices[t], b = indices[t + 1], c = indices[t + 2];
+      if (group_[a] == group_[b] || group_[b] == group_[c] || group_[a] == group_[c])
+        continue;
+      const u32 triangle = static_cast<u32>(corners_.size() / 3);
+      corners_.insert(corners_.end(), {a, b, c});
+      for (auto v : {a, b, c})
+        group_triangles_[group_[v]].emplace_back(triangle);
+    }
+    triangle_alive_.assign(corners_.size() / 3, true);
+    triangle_count_ = triangle_alive_.size();
+    // plane quadrics, weighted by area
+    std::unordered_map<u64, u32> edge_count;
+    for (size_t t = 0; t < triangle_alive_.size(); ++t) {
+      const u32 *c = &corners_[t * 3];
+      f64 n[3];
+      triangleNormal(position(c[0]), position(c[1]), position(c[2]), n);
+      const f64 area = normalize(n) * 0.5;
+      const f32 *p = position(c[0]);
+      const f64 d = -(n[0] * p[0] + n[1] * p[1] + n[2] * p[2]);
+      for (int i = 0; i < 3; ++i) {
+        quadrics_[group_[c[i]]].addPlane(n, d, area);
+        edge_count[edgeKey(group_[c[i]], group_[c[(i + 1) % 3]])]++;
+      }
+    }
+    // borders are held by planes perpendicular to their triangles, and
+    // non-manifold edges are not touched at all
+    for (size_t t = 0; t < triangle_alive_.size(); ++t) {
+      const u32 *c = &corners_[t * 3];
+      for (int i = 0; i < 3; ++i) {
+        const u32 g0 = group_[c[i]], g1 = group_[c[(i + 1) % 3]];
+        const u32 count = edge_count[edgeKey(g0, g1)];
+        if (count > 2) {
+          locked_[g0] = locked_[g1] = true;
+          continue;
+        }
+        if (count != 1)
+          continue;
+        f64 n[3];
+        triangleNormal(position(c[0]), position(c[1]), position(c[2]), n);
+        const f32 *p0 = position(c[i]), *p1 = position(c[(i + 1) % 3]);
+        f64 edge[3] = {f64(p1[0]) - p0[0], f64(p1[1]) - p0[1], f64(p1[2]) - p0[2]};
+        const f64 length = normalize(edge);
+        f64 border[3];
+        cross(edge, n, border);
+        if (normalize(border) <= 0)
+          continue;
+        const f64 d = -(border[0] * p0[0] + border[1] * p0[1] + border[2] * p0[2]);
+        quadrics_[g0].addPlane(border, d, 10 * length * length);
+        quadrics_[g1].addPlane(border, d, 10 * length * length);
+      }
+    }
+  }
+
+  /// Collapses edges in passes of increasing cost until **target_triangles** remain
+  /// \return worst collapse cost (mean squared distance)
+  f64 run(size_t target_triangles) {
+    f64 max_cost = 0;
+    std::vector<Collapse> collapses;
+    std::vector<bool> touched(alive_.size());
+    while (triangle_count_ > target_triangles) {
+      gatherCollapses(collapses);
+      if (collapses.empty())
+        break;
+      // every collapse removes about two triangles
+      const size_t limit = std::max<size_t>(1, (triangle_count_ - target_triangles + 1) / 2);
+      // only the cheapest ones can be reached, neighbors of a collapse wait for the next pass
+      auto by_cost = [](const Collapse &a, const Collapse &b) { return a.cost < b.cost; };
+      auto sorted_end = collapses.begin() + std::min(collapses.size(), limit * 4);
+      std::nth_element(collapses.begin(), sorted_end, collapses.end(), by_cost);
+      std::sort(collapses.begin(), sorted_end, by_cost);
+      collapses.erase(sorted_end, collapses.end());
+      size_t done = 0;
+      std::fill(touched.begin(), touched.end(), false);
+      for (const auto &c : collapses) {
+        if (done >= limit || triangle_count_ <= target_triangles)
+          break;
+        if (touched[c.from] || touched[c.to] || !canCollapse(c.from, c.to))
+          continue;
+        collapse(c.from, c.to);
+        touched[c.from] = touched[c.to] = true;
+        max_cost = std::max(max_cost, c.cost);
+        done++;
+      }
+      if (!done)
+        break;
+    }
+    return max_cost;
+  }
+
+  void output(std::vector<u32> &indices) const {
+    indices.clear();
+    for (size_t t = 0; t < triangle_alive_.size(); ++t)
+      if (triangle_alive_[t])
+        indices.insert(indices.end(), corners_.begin() + t * 3, corners_.begin() + t * 3 + 3);
+  }
+
+private:
+  [[nodiscard]] const f32 *position(u32 v) const { return vertices_ + size_t(v) * stride_; }
+
+  /// \return squared distance between the non position attributes of two vertices
+  [[nodiscard]] f32 attributeDistance(u32 a, u32 b) const {
+    f32 d = 0;
+    for (u32 i = 3; i < stride_; ++i) {
+      const f32 x = vertices_[size_t(a) * stride_ + i] - vertices_[size_t(b) * stride_ + i];
+      d += x * x;
+    }
+    return d;
+  }
+
+  void gatherCollapses(std::vector<Collapse> &collapses) {
+    collapses.clear();
+    for (size_t t = 0; t < triangle_alive_.size(); ++t) {
+      if (!triangle_alive_[t])
+        continue;
+      for (int i = 0; i < 3; ++i) {
+        const u32 a = group_[corners_[t * 3 + i]], b = group_[corners_[t * 3 + (i + 1) % 3]];
+        // each interior edge is seen from both triangles, keep one
+        if (a > b && !isBorder(a, b))
+          continue;
+        Collapse best{a, b, -1};
+        for (auto [from, to] : {std::pair<u32, u32>{a, b}, std::pair<u32, u32>{b, a}}) {
+          if (locked_[from] || group_vertices_[from].size() > group_vertices_[to].size())
+            continue;
+          Quadric q = quadrics_[from];
+          q.add(quadrics_[to]);
+          const f64 cost = q.error(position(group_vertices_[to][0]));
+          if (best.cost < 0 || cost < best.cost)
+            best = {from, to, cost};
+        }
+        if (best.cost >= 0)
+          collapses.emplace_back(best);
+      }
+    }
+  }
+
+  /// \return true if only one triangle uses the edge
+  [[nodiscard]] bool isBorder(u32 a, u32 b) const {
+    u32 count = 0;
+    for (auto t : group_triangles_[a]) {
+      if (!triangle_alive_[t])
+        continue;
+      for (int i = 0; i < 3; ++i)
+        if (group_[corners_[t * 3 + i]] == b)
+          count++;
+    }
+    return count == 1;
+  }
+
+  /// Rejects collapses that flip triangles or pinch the surface
+  [[nodiscard]] bool canCollapse(u32 from, u32 to) {
+    const f32 *target = position(group_vertices_[to][0]);
+    auto &from_neighbors = from_neighbors_, &to_neighbors = to_neighbors_;
+    from_neighbors.clear();
+    to_neighbors.clear();
+    for (auto t : group_triangles_[to]) {
+      if (!triangle_alive_[t])
+        continue;
+      for (int i = 0; i < 3; ++i)
+        to_neighbors.emplace_back(group_[corners_[t * 3 + i]]);
+    }
+    for (auto t : group_triangles_[from]) {
+      if (!triangle_alive_[t])
+        continue;
+      const u32 *c = &corners_[t * 3];
+      bool has_to = false;
+      const f32 *p[3];
+      for (int i = 0; i < 3; ++i) {
+        const u32 g = group_[c[i]];
+        from_neighbors.emplace_back(g);
+        has_to = has_to || g == to;
+        p[i] = g == from ? target : position(c[i]);
+      }
+      if (has_to)
+        continue;
+      f64 before[3], after[3];
+      triangleNormal(position(c[0]), position(c[1]), position(c[2]), before);
+      triangleNormal(p[0], p[1], p[2], after);
+      normalize(before);
+      if (normalize(after) <= 0 || before[0] * after[0] + before[1] * after[1] + before[2] * after[2] < 0.2)
+        return false;
+    }
+    // link condition: the edge may share at most two neighbors
+    auto unique = [](std::vector<u32> &v) {
+      std::sort(v.begin(), v.end());
+      v.erase(std::unique(v.begin(), v.end()), v.end());
+    };
+    unique(from_neighbors);
+    unique(to_neighbors);
+    u32 shared = 0;
+    for (auto g : from_neighbors)
+      if (g != from && g != to && std::binary_search(to_neighbors.begin(), to_neighbors.end(), g))
+        shared++;
+    return shared <= 2;
+  }
+
+  void collapse(u32 from, u32 to) {
+    // each wedge of from continues as the wedge of to with the closest attributes
+    auto wedge = [&](u32 v) {
+      u32 best = group_vertices_[to][0];
+      for (auto w : group_vertices_[to])
+        if (attributeDistance(v, w) < attributeDistance(v, best))
+          best = w;
+      return best;
+    };
+    for (auto t : group_triangles_[from]) {
+      if (!triangle_alive_[t])
+        continue;
+      u32 *c = &corners_[t * 3];
+      bool has_to = false;
+      for (int i = 0; i < 3; ++i)
+        has_to = has_to || group_[c[i]] == to;
+      if (has_to) {
+        triangle_alive_[t] = false;
+        triangle_count_--;
+        continue;
+      }
+      for (int i = 0; i < 3; ++i)
+        if (group_[c[i]] == from)
+          c[i] = wedge(c[i]);
+      group_triangles_[to].emplace_back(t);
+    }
+    group_triangles_[from].clear();
+    quadrics_[to].add(quadrics_[from]);
+    alive_[from] = false;
+    // drop dead triangles so the lists do not keep growing
+    auto &list = group_triangles_[to];
+    list.erase(std::remove_if(list.begin(), list.end(), [&](u32 t) { return !triangle_alive_[t]; }), list.end());
+  }
+
+  const f32 *vertices_;
+  u32 stride_;
+  std::vector<u32> group_;                       //!< position group of each vertex
+  std::vector<std::vector<u32>> group_vertices_; //!< vertices of each group (wedges)
+  std::vector<std::vector<u32>> group_triangles_;
+  std::vector<Quadric> quadrics_;
+  std::vector<bool> alive_;
+  std::vector<bool> locked_;
+  std::vector<u32> corners_; //!< 3 vertices per triangle
+  std::vector<bool> triangle_alive_;
+  size_t triangle_count_{0};
+  // canCollapse scratch
+  std::vector<u32> from_neighbors_;
+  std::vector<u32> to_neighbors_;
+};
+
+}
+
+f32 simplifyMesh(const u32 *indices, size_t index_count, const f32 *vertices, size_t vertex_count,
+                 u32 vertex_stride, size_t target_index_count, std::vector<u32> &output) {
+  if (!vertex_count || vertex_stride < 3) {
+    output.assign(indices, indices + index_count);
+    return 0;
+  }
+  Simplifier simplifier(indices, index_count, vertices, vertex_count, vertex_stride);
+  const f64 error = simplifier.run(target_index_count / 3);
+  simplifier.output(output);
+  // relative to the largest dimension of the bounds
+  f32 bounds_min[3], bounds_max[3];
+  for (int d = 0; d < 3; ++d)
+    bounds_min[d] = bounds_max[d] = vertices[d];
+  for (size_t v = 1; v < vertex_count; ++v)
+    for (int d = 0; d < 3; ++d) {
+      bounds_min[d] = std::min(bounds_min[d], vertices[v * vertex_stride + d]);
+      bounds_max[d] = std::max(bounds_max[d], vertices[v * vertex_stride + d]);
+    }
+  f32 extent = 0;
+  for (int d = 0; d < 3; ++d)
+    extent = std::max(extent, bounds_max[d] - bounds_min[d]);
+  return extent > 0 ? static_cast<f32>(std::sqrt(error)) / extent : 0;
+}
+
+LodChain buildLodChain(const u32 *indices, size_t index_count, const f32 *vertices, size_t vertex_count,
+                       u32 vertex_stride, const std::vector<f32> &ratios) {
+  ponos::Timer timer;
+  LodChain chain;
+  chain.indices.assign(indices, indices + index_count);
+  chain.lods.push_back({0, static_cast<u32>(index_count), 0});
+  std::vector<u32> level;
+  for (size_t i = 1; i < ratios.size(); ++i) {
+    const auto &previous = chain.lods.back();
+    const size_t target = static_cast<size_t>(index_count / 3 * ratios[i]) * 3;
+    if (target >= previous.count || target / 3 < min_lod_triangles)
+      break;
+    const f32 error = simplifyMesh(chain.indices.data() + previous.first, previous.count, vertices, vertex_count,
+                                   vertex_stride, target, level);
+    if (level.empty() || level.size() > previous.count * 9 / 10)
+      break;
+    MeshLod lod;
+    lod.first = static_cast<u32>(chain.indices.size());
+    lod.count = static_cast<u32>(level.size());
+    // levels are simplified from each other, errors add up
+    lod.error = previous.error + error;
+    chain.indices.insert(chain.indices.end(), level.begin(), level.end());
+    chain.lods.emplace_back(lod);
+  }
+  chain.ms = timer.tack();
+  return chain;
+}
+
+u32 selectLod(const std::vector<MeshLod> &lods, f32 screen_size, f32 max_error_pixels) {
+  for (size_t i = lods.size(); i-- > 1;)
+    if (lods[i].error * screen_size <= max_error_pixels)
+      return static_cast<u32>(i);
+  return 0;
+}
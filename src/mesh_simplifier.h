@@ -0,0 +1,92 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file mesh_simplifier.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Quadric error mesh simplification and LOD chains.
+
+#ifndef GLSL_EXPERIMENTS_MESH_SIMPLIFIER_H
+#define GLSL_EXPERIMENTS_MESH_SIMPLIFIER_H
+
+#include <ponos/ponos.h>
+#include <vector>
+
+/// Triangle count of each level relative to the original mesh
+constexpr f32 default_lod_ratios[] = {1.f, 0.5f, 0.25f, 0.125f};
+/// Coarser levels are not worth a draw call of their own
+constexpr u32 min_lod_triangles = 64;
+
+/// Index range of one level of detail. Every level indexes the same vertices.
+struct MeshLod {
+  u32 first{0}; //!< first index
+  u32 count{0}; //!< index count
+  f32 error{0}; //!< distance to the original surface, relative to the mesh extent
+};
+
+/// Levels of detail stored back to back in a single index buffer, finest first
+struct LodChain {
+  std::vector<u32> indices;
+  std::vector<MeshLod> lods;
+  f64 ms{0}; //!< time spent simplifying
+};
+
+/// Quadric error edge collapse (Garland and Heckbert 1997). Vertices are
+/// collapsed into one of their neighbors, so the result indexes the input
+/// vertex buffer. Vertices sharing a position collapse together, matching
+/// the wedges of the target vertex with the closest attributes, and borders
+/// are kept in place by perpendicular planes.
+/// \param indices **[in]** triangle list
+/// \param index_count **[in]**
+/// \param vertices **[in]** interleaved vertex data, position first
+/// \param vertex_count **[in]**
+/// \param vertex_stride **[in]** in floats
+/// \param target_index_count **[in]** stops once the output has this many indices or less
+/// \param output **[out]** triangle list
+/// \return error of the worst collapse, relative to the mesh extent
+f32 simplifyMesh(const u32 *indices, size_t index_count, const f32 *vertices, size_t vertex_count,
+                 u32 vertex_stride, size_t target_index_count, std::vector<u32> &output);
+
+/// Simplifies each level from the previous one. Levels under
+/// min_lod_triangles, or that would not drop at least 10% of the triangles
+/// of the previous one, are left out.
+/// \param indices **[in]** triangle list, level 0
+/// \param index_count **[in]**
+/// \param vertices **[in]** interleaved vertex data, position first
+/// \param vertex_count **[in]**
+/// \param vertex_stride **[in]** in floats
+/// \param ratios **[in | optional]** triangle count of each level relative to level 0
+/// \return chain
+LodChain buildLodChain(const u32 *indices, size_t index_count, const f32 *vertices, size_t vertex_count,
+                       u32 vertex_stride,
+                       const std::vector<f32> &ratios = {std::begin(default_lod_ratios),
+                                                         std::end(default_lod_ratios)});
+
+/// Picks the coarsest level whose error stays under **max_error_pixels**
+/// once the mesh is projected on the screen.
+/// \param lods **[in]**
+/// \param screen_size **[in]** projected mesh extent, in pixels
+/// \param max_error_pixels **[in | optional]**
+/// \return level index
+u32 selectLod(const std::vector<MeshLod> &lods, f32 screen_size, f32 max_error_pixels = 1);
+
+#endif //GLSL_EXPERIMENTS_MESH_SIMPLIFIER_H
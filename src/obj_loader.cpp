@@ -0,0 +1,539 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file obj_loader.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "obj_loader.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// face corner indices are stored as:
+//   >= 0           absolute (0-based) index
+//   INT32_MAX      component not present
+//   other < 0      index relative to the chunk's element count (negative OBJ
+//                  index), resolved once the chunk offsets are known
+constexpr i32 missing_index = std::numeric_limits<i32>::max();
+constexpr i64 relative_bias = i64(1) << 30;
+constexpr u32 missing_key = std::numeric_limits<u32>::max();
+
+struct Chunk {
+  const char *begin{nullptr};
+  const char *end{nullptr};
+  std::vector<f32> positions; // 3 per element
+  std::vector<f32> uvs;       // 2 per element
+  std::vector<f32> normals;   // 3 per element
+  std::vector<i32> corners;   // 3 (v, vt, vn) per triangle corner
+  bool uses_uvs{false};
+  bool uses_normals{false};
+  const char *error{nullptr};
+  size_t position_offset{0}, uv_offset{0}, normal_offset{0}, corner_offset{0};
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char *skipBlanks(const char *p, const char *end) {
+  while (p < end && isBlank(*p))
+    ++p;
+  return p;
+}
+
+inline const char *nextLine(const char *p, const char *end) {
+  while (p < end && *p != '\n')
+    ++p;
+  return p < end ? p + 1 : end;
+}
+
+struct Pow10Table {
+  Pow10Table() {
+    for (int i = 0; i < 2 * range + 1; ++i)
+      values[i] = std::pow(10.0, i - range);
+  }
+  static constexpr int range = 308;
+  f64 values[2 * range + 1]{};
+};
+
+const Pow10Table pow10_table;
+
+inline f64 pow10(int e) {
+  e = std::max(-Pow10Table::range, std::min(Pow10Table::range, e));
+  return pow10_table.values[e + Pow10Table::range];
+}
+
+/// \return pointer past the number, or nullptr if there is no number at p
+const char *parseFloat(const char *p, const char *end, f32 &value) {
+  p = skipBlanks(p, end);
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  u64 mantissa = 0;
+  int exponent = 0, digit_count = 0;
+  for (; p < end && *p >= '0' && *p <= '9'; ++p, ++digit_count) {
+    if (mantissa < 100000000000000000ull)
+      mantissa = mantissa * 10 + (*p - '0');
+    else
+      exponent++;
+  }
+  if (p < end && *p == '.')
+    for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++digit_count)
+      if (mantissa < 100000000000000000ull) {
+        mantissa = mantissa * 10 + (*p - '0');
+        exponent--;
+      }
+  if (!digit_count)
+    return nullptr;
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negative_exponent = false;
+    if (p < end && (*p == '-' || *p == '+'))
+      negative_exponent = *p++ == '-';
+    int e = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p)
+      e = std::min(e * 10 + (*p - '0'), 10000);
+    exponent += negative_exponent ? -e : e;
+  }
+  auto v = static_cast<f64>(mantissa) * pow10(exponent);
+  value = static_cast<f32>(negative ? -v : v);
+  return p;
+}
+
+/// \return pointer past the number, or nullptr if there is no number at p
+inline const char *parseInt(const char *p, const char *end, i64 &value) {
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  if (p == end || *p < '0' || *p > '9')
+    return nullptr;
+  i64 v = 0;
+  for (; p < end && *p >= '0' && *p <= '9'; ++p)
+    v = std::min<i64>(v * 10 + (*p - '0'), relative_bias);
+  value = negative ? -v : v;
+  return p;
+}
+
+inline i32 encodeIndex(i64 index, size_t local_count) {
+  if (index > 0)
+    return static_cast<i32>(std::min<i64>(index - 1, missing_index - 1));
+  // negative: relative to the elements seen so far
+  i64 relative = static_cast<i64>(local_count) + index;
+  return static_cast<i32>(std::max<i64>(relative, -relative_bias + 1) - relative_bias);
+}
+
+/// \return false if a component (0, 1 or 2) is malformed
+const char *parseCorner(const char *p, const char *end, const Chunk &chunk, i32 corner[3]) {
+  size_t counts[3] = {chunk.positions.size() / 3, chunk.uvs.size() / 2, chunk.normals.size() / 3};
+  corner[0] = corner[1] = corner[2] = missing_index;
+  for (int c = 0; c < 3; ++c) {
+    i64 index = 0;
+    if (auto *q = parseInt(p, end, index)) {
+      if (!index)
+        return nullptr;
+      corner[c] = encodeIndex(index, counts[c]);
+      p = q;
+    } else if (c == 0)
+      return nullptr;
+    if (c == 2 || p == end || *p != '/')
+      break;
+    ++p;
+  }
+  return p;
+}
+
+void parseChunk(Chunk &chunk) {
+  const char *end = chunk.end;
+  for (const char *p = chunk.begin; p < end && !chunk.error; p = nextLine(p, end)) {
+    const char *line = p;
+    p = skipBlanks(p, end);
+    if (p + 1 >= end)
+      continue;
+    if (p[0] == 'v' && isBlank(p[1])) {
+      f32 v[3];
+      const char *q = p + 1;
+      for (auto &c : v)
+        if (!q || !(q = parseFloat(q, end, c)))
+          break;
+      if (!q) {
+        chunk.error = line;
+        break;
+      }
+      chunk.positions.insert(chunk.positions.end(), v, v + 3);
+    } else if (p[0] == 'v' && p[1] == 't') {
+      f32 v[2] = {0, 0};
+      const char *q = parseFloat(p + 2, end, v[0]);
+      if (q)
+        parseFloat(q, end, v[1]);
+      if (!q) {
+        chunk.error = line;
+        break;
+      }
+      chunk.uvs.insert(chunk.uvs.end(), v, v + 2);
+    } else if (p[0] == 'v' && p[1] == 'n') {
+      f32 v[3];
+      const char *q = p + 2;
+      for (auto &c : v)
+        if (!q || !(q = parseFloat(q, end, c)))
+          break;
+      if (!q) {
+        chunk.error = line;
+        break;
+      }
+      chunk.normals.insert(chunk.normals.end(), v, v + 3);
+    } else if (p[0] == 'f' && isBlank(p[1])) {
+      // triangulate as a fan around the first corner
+      i32 first[3], previous[3], current[3];
+      u32 corner_count = 0;
+      const char *q = skipBlanks(p + 1, end);
+      while (q < end && *q != '\n' && *q != '#') {
+        q = parseCorner(q, end, chunk, current);
+        if (!q)
+          break;
+        q = skipBlanks(q, end);
+        if (corner_count == 0)
+          std::copy(current, current + 3, first);
+        else if (corner_count >= 2) {
+          chunk.corners.insert(chunk.corners.end(), first, first + 3);
+          chunk.corners.insert(chunk.corners.end(), previous, previous + 3);
+          chunk.corners.insert(chunk.corners.end(), current, current + 3);
+        }
+        chunk.uses_uvs |= current[1] != missing_index;
+        chunk.uses_normals |= current[2] != missing_index;
+        std::copy(current, current + 3, previous);
+        corner_count++;
+      }
+      if (!q || corner_count < 3) {
+        chunk.error = line;
+        break;
+      }
+    }
+  }
+}
+
+inline u32 hashKey(const u32 *key) {
+  u32 h = key[0] * 0x9E3779B1u ^ key[1] * 0x85EBCA77u ^ key[2] * 0xC2B2AE3Du;
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  h *= 0x846CA68Bu;
+  h ^= h >> 16;
+  return h;
+}
+
+/// Open addressing table from corner key to the position of its first
+/// occurrence.
+class CornerTable {
+public:
+  explicit CornerTable(size_t expected) {
+    size_t capacity = 16;
+    while (capacity < expected * 2)
+      capacity <<= 1;
+    slots_.resize(capacity);
+  }
+  /// \return position of the first occurrence of **key**
+  u32 insert(const u32 *key, u32 hash, u32 position) {
+    if ((count_ + 1) * 2 > slots_.size())
+      grow();
+    size_t mask = slots_.size() - 1;
+    for (size_t i = (hash >> 8) & mask;; i = (i + 1) & mask) {
+      auto &slot = slots_[i];
+      if (slot.position == missing_key) {
+        slot = {{key[0], key[1], key[2]}, position};
+        count_++;
+        return position;
+      }
+      if (slot.key[0] == key[0] && slot.key[1] == key[1] && slot.key[2] == key[2])
+        return slot.position;
+    }
+  }
+
+private:
+  struct Slot {
+    u32 key[3]{};
+    u32 position{missing_key};
+  };
+  void grow() {
+    std::vector<Slot> old(slots_.size() * 2);
+    old.swap(slots_);
+    count_ = 0;
+    for (const auto &slot : old)
+      if (slot.position != missing_key)
+        insert(slot.key, hashKey(slot.key), slot.position);
+  }
+  std::vector<Slot> slots_;
+  size_t count_{0};
+};
+
+}
+
+bool parseObj(const char *text, size_t size, ObjMesh &mesh, std::string &err, ThreadPool &pool,
+              ObjLoadStats *stats) {
+  ObjLoadStats local_stats;
+  if (!stats)
+    stats = &local_stats;
+  stats->file_size = size;
+  ponos::Timer timer;
+  // split at line boundaries, a few chunks per worker to balance the load
+  const size_t min_chunk_size = 1 << 20;
+  size_t chunk_count = std::max<size_t>(1, std::min<size_t>(pool.size() * 4, size / min_chunk_size));
+  std::vector<Chunk> chunks(chunk_count);
+  const char *end = text + size;
+  const char *p = text;
+  for (size_t i = 0; i < chunk_count; ++i) {
+    chunks[i].begin = p;
+    p = i + 1 == chunk_count ? end : nextLine(std::min(end, text + size * (i + 1) / chunk_count), end);
+    p = std::max(p, chunks[i].begin);
+    chunks[i].end = p;
+  }
+  pool.parallelFor(chunk_count, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i)
+      parseChunk(chunks[i]);
+  });
+  stats->parse_ms = timer.tack();
+  timer.tick();
+  // global offsets of every chunk
+  size_t position_count = 0, uv_count = 0, normal_count = 0, corner_count = 0;
+  bool uses_uvs = false, uses_normals = false;
+  for (auto &chunk : chunks) {
+    if (chunk.error) {
+      auto line_end = nextLine(chunk.error, end);
+      err = "invalid line: " + std::string(chunk.error, line_end);
+      return false;
+    }
+    chunk.position_offset = position_count;
+    chunk.uv_offset = uv_count;
+    chunk.normal_offset = normal_count;
+    chunk.corner_offset = corner_count;
+    position_count += chunk.positions.size() / 3;
+    uv_count += chunk.uvs.size() / 2;
+    normal_count += chunk.normals.size() / 3;
+    corner_count += chunk.corners.size() / 3;
+    uses_uvs |= chunk.uses_uvs;
+    uses_normals |= chunk.uses_normals;
+  }
+  if (!corner_count) {
+    err = "no faces";
+    return false;
+  }
+  if (corner_count >= missing_key) {
+    err = "too many faces";
+    return false;
+  }
+  // gather elements and resolve corner indices into global keys (in place).
+  // Each key is hashed once here, and counted in the dedup shard owning it.
+  std::vector<f32> positions(position_count * 3), uvs(uv_count * 2), normals(normal_count * 3);
+  std::vector<u32> corner_hash(corner_count);
+  const u32 shard_count = pool.size();
+  std::vector<u32> shard_sizes(chunk_count * shard_count, 0); //!< [chunk][shard]
+  std::atomic<bool> invalid_index{false};
+  pool.parallelFor(chunk_count, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      auto &chunk = chunks[i];
+      std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + chunk.position_offset * 3);
+      std::copy(chunk.uvs.begin(), chunk.uvs.end(), uvs.begin() + chunk.uv_offset * 2);
+      std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + chunk.normal_offset * 3);
+      size_t offsets[3] = {chunk.position_offset, chunk.uv_offset, chunk.normal_offset};
+      size_t counts[3] = {position_count, uv_count, normal_count};
+      for (size_t c = 0; c < chunk.corners.size(); ++c) {
+        auto component = c % 3;
+        i64 index = chunk.corners[c];
+        if (index == missing_index) {
+          // tuples must stay distinguishable when some corners lack a component
+          chunk.corners[c] = static_cast<i32>(missing_key);
+          continue;
+        }
+        if (index < 0)
+          index += relative_bias + static_cast<i64>(offsets[component]);
+        if (index < 0 || static_cast<size_t>(index) >= counts[component]) {
+          invalid_index = true;
+          index = 0;
+        }
+        chunk.corners[c] = static_cast<i32>(index);
+      }
+      auto *keys = reinterpret_cast<const u32 *>(chunk.corners.data());
+      auto *sizes = &shard_sizes[i * shard_count];
+      for (size_t c = 0; c < chunk.corners.size() / 3; ++c) {
+        auto h = hashKey(keys + c * 3);
+        corner_hash[chunk.corner_offset + c] = h;
+        sizes[h % shard_count]++;
+      }
+      chunk.positions = std::vector<f32>();
+      chunk.uvs = std::vector<f32>();
+      chunk.normals = std::vector<f32>();
+    }
+  });
+  if (invalid_index) {
+    err = "face index out of range";
+    return false;
+  }
+  stats->resolve_ms = timer.tack();
+  timer.tick();
+  // deduplicate v/vt/vn tuples. Keys are sharded by hash over the workers, each
+  // one records where every key it owns first appears; vertices are then
+  // numbered in order of first appearance, which keeps the result deterministic
+  // and independent of the number of workers.
+  // Corners are first bucketed by shard (shard major, then chunk, keeping the
+  // corner order inside each bucket), so each shard only visits its own keys.
+  struct ShardCorner {
+    const u32 *key;
+    u32 corner;
+    u32 hash;
+  };
+  std::vector<size_t> shard_begin(shard_count + 1, 0);
+  std::vector<size_t> bucket_offsets(chunk_count * shard_count); //!< [chunk][shard]
+  for (u32 shard = 0, offset = 0; shard < shard_count; ++shard) {
+    shard_begin[shard] = offset;
+    for (size_t i = 0; i < chunk_count; ++i) {
+      bucket_offsets[i * shard_count + shard] = offset;
+      offset += shard_sizes[i * shard_count + shard];
+    }
+    shard_begin[shard + 1] = offset;
+  }
+  std::vector<ShardCorner> shard_corners(corner_count);
+  pool.parallelFor(chunk_count, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      const auto &chunk = chunks[i];
+      auto *keys = reinterpret_cast<const u32 *>(chunk.corners.data());
+      auto *offsets = &bucket_offsets[i * shard_count];
+      for (size_t c = 0; c < chunk.corners.size() / 3; ++c) {
+        auto corner = static_cast<u32>(chunk.corner_offset + c);
+        auto h = corner_hash[corner];
+        shard_corners[offsets[h % shard_count]++] = {keys + c * 3, corner, h};
+      }
+    }
+  });
+  std::vector<u32> first_occurrence(corner_count);
+  pool.parallelFor(shard_count, [&](size_t first_shard, size_t last_shard) {
+    for (size_t shard = first_shard; shard < last_shard; ++shard) {
+      CornerTable table((shard_begin[shard + 1] - shard_begin[shard]) / 2);
+      for (size_t s = shard_begin[shard]; s < shard_begin[shard + 1]; ++s) {
+        const auto &entry = shard_corners[s];
+        first_occurrence[entry.corner] = table.insert(entry.key, entry.hash, entry.corner);
+      }
+    }
+  }, 1);
+  // number first occurrences with a parallel prefix sum
+  std::vector<u32> vertex_id(corner_count);
+  const size_t block_count = std::max<size_t>(1, std::min<size_t>(pool.size() * 4, corner_count / 4096));
+  const size_t block_size = (corner_count + block_count - 1) / block_count;
+  std::vector<u32> block_offsets(block_count + 1, 0);
+  pool.parallelFor(block_count, [&](size_t first, size_t last) {
+    for (size_t b = first; b < last; ++b) {
+      u32 n = 0;
+      for (size_t c = b * block_size; c < std::min(corner_count, (b + 1) * block_size); ++c)
+        n += first_occurrence[c] == c;
+      block_offsets[b + 1] = n;
+    }
+  });
+  for (size_t b = 0; b < block_count; ++b)
+    block_offsets[b + 1] += block_offsets[b];
+  pool.parallelFor(block_count, [&](size_t first, size_t last) {
+    for (size_t b = first; b < last; ++b) {
+      u32 id = block_offsets[b];
+      for (size_t c = b * block_size; c < std::min(corner_count, (b + 1) * block_size); ++c)
+        if (first_occurrence[c] == c)
+          vertex_id[c] = id++;
+    }
+  });
+  stats->deduplicate_ms = timer.tack();
+  timer.tick();
+  // build interleaved vertices and indices
+  mesh.vertex_count = block_offsets[block_count];
+  mesh.has_uvs = uses_uvs;
+  mesh.has_normals = uses_normals;
+  mesh.index_data.resize(corner_count);
+  mesh.vertex_data.assign(static_cast<size_t>(mesh.vertex_count) * ObjMesh::vertex_stride, 0.f);
+  std::vector<u32> vertex_position(uses_normals ? 0 : mesh.vertex_count);
+  pool.parallelFor(chunk_count, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      const auto &chunk = chunks[i];
+      auto *keys = reinterpret_cast<const u32 *>(chunk.corners.data());
+      size_t n = chunk.corners.size() / 3;
+      for (size_t c = 0; c < n; ++c) {
+        size_t corner = chunk.corner_offset + c;
+        auto id = vertex_id[first_occurrence[corner]];
+        mesh.index_data[corner] = id;
+        if (first_occurrence[corner] != corner)
+          continue;
+        const u32 *key = keys + c * 3;
+        f32 *v = &mesh.vertex_data[static_cast<size_t>(id) * ObjMesh::vertex_stride];
+        std::copy(&positions[key[0] * 3], &positions[key[0] * 3] + 3, v);
+        if (key[2] != missing_key)
+          std::copy(&normals[key[2] * 3], &normals[key[2] * 3] + 3, v + 3);
+        if (key[1] != missing_key)
+          std::copy(&uvs[key[1] * 2], &uvs[key[1] * 2] + 2, v + 6);
+        if (!uses_normals)
+          vertex_position[id] = key[0];
+      }
+    }
+  });
+  if (!uses_normals) {
+    // smooth normals, accumulated per position so uv seams are not visible
+    std::vector<f32> accumulated(position_count * 3, 0.f);
+    for (size_t t = 0; t < corner_count; t += 3) {
+      const f32 *a = &positions[vertex_position[mesh.index_data[t]] * 3];
+      const f32 *b = &positions[vertex_position[mesh.index_data[t + 1]] * 3];
+      const f32 *c = &positions[vertex_position[mesh.index_data[t + 2]] * 3];
+      f32 e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      f32 e1[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+      f32 n[3] = {e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0]};
+      for (size_t k = 0; k < 3; ++k)
+        for (int d = 0; d < 3; ++d)
+          accumulated[vertex_position[mesh.index_data[t + k]] * 3 + d] += n[d];
+    }
+    pool.parallelFor(mesh.vertex_count, [&](size_t first, size_t last) {
+      for (size_t v = first; v < last; ++v) {
+        const f32 *n = &accumulated[vertex_position[v] * 3];
+        f32 length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for (int d = 0; d < 3 && length > 0; ++d)
+          mesh.vertex_data[v * ObjMesh::vertex_stride + 3 + d] = n[d] / length;
+      }
+    });
+  }
+  // bounds
+  for (int d = 0; d < 3; ++d) {
+    mesh.bounds_min[d] = position_count ? std::numeric_limits<f32>::max() : 0;
+    mesh.bounds_max[d] = position_count ? std::numeric_limits<f32>::lowest() : 0;
+  }
+  for (size_t i = 0; i < position_count; ++i)
+    for (int d = 0; d < 3; ++d) {
+      mesh.bounds_min[d] = std::min(mesh.bounds_min[d], positions[i * 3 + d]);
+      mesh.bounds_max[d] = std::max(mesh.bounds_max[d], positions[i * 3 + d]);
+    }
+  stats->build_ms = timer.tack();
+  return true;
+}
+
+bool loadObj(const std::string &path, ObjMesh &mesh, std::string &err, ThreadPool &pool, ObjLoadStats *stats) {
+  MappedFile file(path);
+  if (!file.good()) {
+    err = "could not open " + path;
+    return false;
+  }
+  return parseObj(reinterpret_cast<const char *>(file.data()), file.size(), mesh, err, pool, stats);
+}
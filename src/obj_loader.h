@@ -0,0 +1,74 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file obj_loader.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Wavefront OBJ importer.
+
+#ifndef GLSL_EXPERIMENTS_OBJ_LOADER_H
+#define GLSL_EXPERIMENTS_OBJ_LOADER_H
+
+#include "thread_pool.h"
+
+/// Indexed triangle mesh ready for upload. Vertices are interleaved as
+/// position (3 floats), normal (3 floats) and uv (2 floats), matching the
+/// attribute order the editor shaders expect.
+struct ObjMesh {
+  static constexpr u32 vertex_stride = 8;
+  std::vector<f32> vertex_data;
+  std::vector<u32> index_data;
+  u32 vertex_count{0};
+  bool has_normals{false}; //!< false if normals were generated
+  bool has_uvs{false};     //!< false if uvs were filled with zeros
+  f32 bounds_min[3]{0, 0, 0};
+  f32 bounds_max[3]{0, 0, 0};
+};
+
+/// Time spent in each loading phase (ms)
+struct ObjLoadStats {
+  f64 parse_ms{0};
+  f64 resolve_ms{0};
+  f64 deduplicate_ms{0};
+  f64 build_ms{0};
+  size_t file_size{0};
+};
+
+/// Loads a Wavefront OBJ file. The file is memory mapped and split into
+/// chunks at line boundaries, which are parsed concurrently without iostreams
+/// or per-line allocations. Polygons are triangulated as fans and every
+/// distinct v/vt/vn tuple becomes one vertex of the output.
+/// Missing normals are generated (smooth, area weighted), missing uvs are 0.
+/// \param path **[in]** .obj file
+/// \param mesh **[out]**
+/// \param err **[out]** error description on failure
+/// \param pool **[in | optional]** workers used for parsing
+/// \param stats **[out | optional]** per phase timings
+/// \return false on failure
+bool loadObj(const std::string &path, ObjMesh &mesh, std::string &err,
+             ThreadPool &pool = ThreadPool::global(), ObjLoadStats *stats = nullptr);
+
+/// Same as loadObj, from OBJ text in memory.
+bool parseObj(const char *text, size_t size, ObjMesh &mesh, std::string &err,
+              ThreadPool &pool = ThreadPool::global(), ObjLoadStats *stats = nullptr);
+
+#endif //GLSL_EXPERIMENTS_OBJ_LOADER_H
@@ -0,0 +1,209 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file profiler.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "profiler.h"
+#include "gpu_timer.h"
+
+#include <json11.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+f64 microseconds(std::chrono::steady_clock::duration d) {
+  return std::chrono::duration<f64, std::micro>(d).count();
+}
+
+}
+
+void Profiler::History::push(f32 ms) {
+  values[head] = ms;
+  head = (head + 1) % history_size;
+  count = std::min(count + 1, history_size);
+}
+
+std::vector<f32> Profiler::History::ordered() const {
+  std::vector<f32> samples(count);
+  for (u32 i = 0; i < count; ++i)
+    samples[i] = values[(head + history_size - count + i) % history_size];
+  return samples;
+}
+
+Profiler::Percentiles Profiler::History::percentiles() const {
+  Percentiles p;
+  if (!count)
+    return p;
+  std::vector<f32> samples(values, values + count);
+  std::sort(samples.begin(), samples.end());
+  auto at = [&](f32 q) { return samples[std::min(count - 1, static_cast<u32>(q * count))]; };
+  p.p50 = at(0.5f);
+  p.p95 = at(0.95f);
+  p.p99 = at(0.99f);
+  p.max = samples.back();
+  return p;
+}
+
+Profiler::Scope::Scope(Profiler &profiler, u32 section) : profiler_(profiler), record_(profiler.begin(section)) {}
+
+Profiler::Scope::~Scope() {
+  profiler_.end(record_);
+}
+
+Profiler::Profiler(std::vector<std::string> section_names, u32 latency) : frames_(std::max(latency, 1u)) {
+  for (auto &name : section_names) {
+    sections_.emplace_back();
+    sections_.back().name = std::move(name);
+  }
+}
+
+Profiler::~Profiler() {
+  if (!all_queries_.empty())
+    glDeleteQueries(static_cast<GLsizei>(all_queries_.size()), all_queries_.data());
+}
+
+void Profiler::beginFrame() {
+  if (timer_queries_ < 0)
+    timer_queries_ = GpuTimer::supported() ? 1 : 0;
+  if (frame_open_)
+    end(0);
+  current_ = (current_ + 1) % frames_.size();
+  // the oldest frame in the ring
+  resolve(frames_[current_]);
+  use_gpu_ = gpu_enabled && timer_queries_;
+  frame_open_ = true;
+  begin(0);
+}
+
+u32 Profiler::begin(u32 section) {
+  auto &frame = frames_[current_];
+  frame.emplace_back();
+  auto &record = frame.back();
+  record.section = section;
+  if (use_gpu_) {
+    record.queries[0] = acquireQuery();
+    glQueryCounter(record.queries[0], GL_TIMESTAMP);
+  }
+  record.cpu_begin = Clock::now();
+  return static_cast<u32>(frame.size() - 1);
+}
+
+void Profiler::end(u32 record_index) {
+  auto &record = frames_[current_][record_index];
+  record.cpu_end = Clock::now();
+  if (record.queries[0]) {
+    record.queries[1] = acquireQuery();
+    glQueryCounter(record.queries[1], GL_TIMESTAMP);
+  }
+  auto cpu_us = microseconds(record.cpu_end - record.cpu_begin);
+  sections_[record.section].cpu.push(static_cast<f32>(cpu_us / 1000));
+  if (capturing_ && record.cpu_begin >= capture_start_)
+    events_.push_back({record.section, false, microseconds(record.cpu_begin - capture_start_), cpu_us});
+}
+
+void Profiler::resolve(std::vector<Record> &frame) {
+  bool available = true;
+  for (const auto &record : frame) {
+    if (!record.queries[1])
+      continue;
+    GLint ready = GL_FALSE;
+    glGetQueryObjectiv(record.queries[1], GL_QUERY_RESULT_AVAILABLE, &ready);
+    available = available && ready;
+  }
+  bool has_queries = false;
+  for (const auto &record : frame) {
+    if (!record.queries[0])
+      continue;
+    has_queries = true;
+    if (available && record.queries[1]) {
+      GLuint64 begin = 0, end = 0;
+      glGetQueryObjectui64v(record.queries[0], GL_QUERY_RESULT, &begin);
+      glGetQueryObjectui64v(record.queries[1], GL_QUERY_RESULT, &end);
+      f64 gpu_us = static_cast<f64>(end - begin) / 1000;
+      sections_[record.section].gpu.push(static_cast<f32>(gpu_us / 1000));
+      f64 begin_us = static_cast<f64>(begin) / 1000 + gpu_offset_us_;
+      if (capturing_ && begin_us >= 0)
+        events_.push_back({record.section, true, begin_us, gpu_us});
+    }
+    for (auto query : record.queries)
+      if (query)
+        free_queries_.emplace_back(query);
+  }
+  if (has_queries && !available)
+    dropped_frames_++;
+  frame.clear();
+}
+
+GLuint Profiler::acquireQuery() {
+  if (free_queries_.empty()) {
+    GLuint queries[16];
+    glGenQueries(16, queries);
+    free_queries_.insert(free_queries_.end(), queries, queries + 16);
+    all_queries_.insert(all_queries_.end(), queries, queries + 16);
+  }
+  GLuint query = free_queries_.back();
+  free_queries_.pop_back();
+  return query;
+}
+
+void Profiler::startCapture() {
+  events_.clear();
+  capturing_ = true;
+  capture_start_ = Clock::now();
+  gpu_offset_us_ = 0;
+  if (use_gpu_) {
+    // maps the GPU clock into the capture time line
+    GLint64 timestamp = 0;
+    glGetInteger64v(GL_TIMESTAMP, &timestamp);
+    gpu_offset_us_ = microseconds(Clock::now() - capture_start_) - static_cast<f64>(timestamp) / 1000;
+  }
+}
+
+bool Profiler::stopCapture(const std::string &path, std::string &err) {
+  capturing_ = false;
+  json11::Json::array trace_events;
+  trace_events.emplace_back(json11::Json::object{
+      {"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", 1}, {"args", json11::Json::object{{"name", "CPU"}}}});
+  trace_events.emplace_back(json11::Json::object{
+      {"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", 2}, {"args", json11::Json::object{{"name", "GPU"}}}});
+  for (const auto &event : events_)
+    trace_events.emplace_back(json11::Json::object{
+        {"name", sections_[event.section].name}, {"cat", event.gpu ? "gpu" : "cpu"}, {"ph", "X"},
+        {"ts", event.begin_us}, {"dur", event.duration_us}, {"pid", 1}, {"tid", event.gpu ? 2 : 1}});
+  events_.clear();
+  std::error_code ec;
+  auto directory = std::filesystem::path(path).parent_path();
+  if (!directory.empty())
+    std::filesystem::create_directories(directory, ec);
+  std::ofstream out(path);
+  out << json11::Json(json11::Json::object{{"traceEvents", trace_events}, {"displayTimeUnit", "ms"}}).dump();
+  if (!out) {
+    err = "could not write " + path;
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,146 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file profiler.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Per section CPU/GPU frame profiler.
+
+#ifndef GLSL_EXPERIMENTS_PROFILER_H
+#define GLSL_EXPERIMENTS_PROFILER_H
+
+#include <circe/circe.h>
+#include <chrono>
+
+/// Per section CPU and GPU timings of the frame. CPU time comes from a
+/// steady clock, GPU time from GL_TIMESTAMP queries issued at the same
+/// points. Queries of a frame are only read latency frames later (and
+/// dropped if still not available), so profiling never stalls the pipeline.
+///
+/// Section 0 measures whole frames, from one beginFrame() to the next,
+/// everything that happens outside of render() included.
+///
+/// Usage:
+///   Profiler profiler({"frame", "draw"});
+///   // every frame
+///   profiler.beginFrame();
+///   {
+///     Profiler::Scope scope(profiler, 1);
+///     draw();
+///   }
+class Profiler {
+public:
+  static constexpr u32 history_size = 256;
+  struct Percentiles {
+    f32 p50{0};
+    f32 p95{0};
+    f32 p99{0};
+    f32 max{0};
+  };
+  /// Rolling window of the last history_size samples
+  struct History {
+    void push(f32 ms);
+    /// \return values[i] is the i-th oldest sample
+    [[nodiscard]] std::vector<f32> ordered() const;
+    [[nodiscard]] Percentiles percentiles() const;
+    [[nodiscard]] f32 last() const { return count ? values[(head + history_size - 1) % history_size] : 0; }
+    f32 values[history_size]{};
+    u32 head{0};  //!< next write
+    u32 count{0}; //!< valid samples
+  };
+  struct Section {
+    std::string name;
+    History cpu;
+    History gpu;
+  };
+  /// Measures the enclosing block
+  class Scope {
+  public:
+    Scope(Profiler &profiler, u32 section);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  private:
+    Profiler &profiler_;
+    u32 record_;
+  };
+  /// \param section_names **[in]** section 0 is the frame
+  /// \param latency **[in | optional]** frames before GPU queries are read
+  explicit Profiler(std::vector<std::string> section_names, u32 latency = 3);
+  ~Profiler();
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+  /// Closes the previous frame and collects the GPU results of the oldest
+  /// one. Requires a current GL context.
+  void beginFrame();
+  /// Starts recording every measured interval for trace export
+  void startCapture();
+  /// Writes the captured intervals in the Chrome trace event format
+  /// (chrome://tracing, Perfetto) and stops capturing.
+  /// \param path **[in]** output json
+  /// \param err **[out]**
+  /// \return false if the file could not be written
+  bool stopCapture(const std::string &path, std::string &err);
+  [[nodiscard]] bool capturing() const { return capturing_; }
+  [[nodiscard]] size_t capturedEvents() const { return events_.size(); }
+  [[nodiscard]] const std::vector<Section> &sections() const { return sections_; }
+  /// \return frames whose GPU queries were not ready in time
+  [[nodiscard]] u32 droppedFrames() const { return dropped_frames_; }
+  /// GPU timestamps are taken only if enabled (and supported)
+  bool gpu_enabled{true};
+
+private:
+  using Clock = std::chrono::steady_clock;
+  struct Record {
+    u32 section{0};
+    GLuint queries[2]{0, 0};
+    Clock::time_point cpu_begin;
+    Clock::time_point cpu_end;
+  };
+  struct Event {
+    u32 section{0};
+    bool gpu{false};
+    f64 begin_us{0};
+    f64 duration_us{0};
+  };
+  u32 begin(u32 section);
+  void end(u32 record);
+  void resolve(std::vector<Record> &frame);
+  GLuint acquireQuery();
+
+  std::vector<Section> sections_;
+  std::vector<std::vector<Record>> frames_; //!< ring of in flight frames
+  u32 current_{0};
+  bool frame_open_{false};
+  int timer_queries_{-1}; //!< support of the context, -1 until checked
+  bool use_gpu_{false};   //!< for the current frame
+  std::vector<GLuint> free_queries_;
+  std::vector<GLuint> all_queries_;
+  u32 dropped_frames_{0};
+  // capture
+  bool capturing_{false};
+  Clock::time_point capture_start_;
+  f64 gpu_offset_us_{0}; //!< cpu time (from capture start) - gpu timestamp
+  std::vector<Event> events_;
+};
+
+#endif //GLSL_EXPERIMENTS_PROFILER_H
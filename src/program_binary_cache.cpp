@@ -0,0 +1,131 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file program_binary_cache.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "program_binary_cache.h"
+#include "hash.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr u32 cache_magic = 0x43425047; // "GPBC"
+constexpr u32 cache_version = 1;
+
+struct CacheEntryHeader {
+  u32 magic{cache_magic};
+  u32 version{cache_version};
+  u64 driver_hash{0};
+  u64 source_hash{0};
+  u32 format{0};
+  u32 size{0};
+};
+
+std::string glString(GLenum name) {
+  auto *s = reinterpret_cast<const char *>(glGetString(name));
+  return s ? s : "";
+}
+
+}
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory) : directory_(std::move(directory)) {}
+
+void ProgramBinaryCache::init() {
+  GLint format_count = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  enabled_ = format_count > 0 && !ec;
+  if (!enabled_)
+    return;
+  auto driver = ponos::concat(glString(GL_VENDOR), "\n", glString(GL_RENDERER), "\n", glString(GL_VERSION), "\n");
+  driver_hash_ = hash_string(driver);
+  // a different driver invalidates every entry
+  auto driver_file = directory_ + "/driver.txt";
+  std::ifstream in(driver_file);
+  std::string cached_driver((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  if (cached_driver != driver) {
+    for (const auto &entry : std::filesystem::directory_iterator(directory_, ec))
+      if (entry.path().extension() == ".bin")
+        std::filesystem::remove(entry.path(), ec);
+    std::ofstream(driver_file) << driver;
+  }
+}
+
+bool ProgramBinaryCache::load(u64 source_hash, ShaderProgram &program) {
+  if (!enabled_)
+    return false;
+  std::ifstream in(filename(source_hash), std::ios::binary);
+  CacheEntryHeader header;
+  if (in.read(reinterpret_cast<char *>(&header), sizeof(header))
+      && header.magic == cache_magic && header.version == cache_version
+      && header.driver_hash == driver_hash_ && header.source_hash == source_hash) {
+    std::vector<u8> data(header.size);
+    if (in.read(reinterpret_cast<char *>(data.data()), header.size)
+        && program.link(header.format, data)) {
+      hits++;
+      return true;
+    }
+  }
+  misses++;
+  return false;
+}
+
+bool ProgramBinaryCache::store(u64 source_hash, const ShaderProgram &program) const {
+  if (!enabled_)
+    return false;
+  CacheEntryHeader header;
+  std::vector<u8> data;
+  GLenum format = 0;
+  if (!program.binary(format, data))
+    return false;
+  header.driver_hash = driver_hash_;
+  header.source_hash = source_hash;
+  header.format = format;
+  header.size = static_cast<u32>(data.size());
+  // write to a temporary file first so a crash never leaves a truncated entry
+  auto path = filename(source_hash);
+  auto tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(data.data()), data.size());
+    if (!out)
+      return false;
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  return !ec;
+}
+
+std::string ProgramBinaryCache::filename(u64 source_hash) const {
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash_combine(source_hash, driver_hash_)));
+  return directory_ + "/" + name;
+}
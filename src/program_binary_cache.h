@@ -0,0 +1,65 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file program_binary_cache.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief On-disk cache of linked program binaries.
+
+#ifndef GLSL_EXPERIMENTS_PROGRAM_BINARY_CACHE_H
+#define GLSL_EXPERIMENTS_PROGRAM_BINARY_CACHE_H
+
+#include "shader_program.h"
+
+/// Stores linked program binaries (glGetProgramBinary) in a directory, one
+/// file per program, keyed by the hash of the program sources. Binaries are
+/// only valid for the driver that produced them, so the cache is tagged with
+/// the driver vendor/renderer/version and emptied whenever that changes.
+class ProgramBinaryCache {
+public:
+  /// \param directory **[in]** cache directory (created if missing)
+  explicit ProgramBinaryCache(std::string directory);
+  /// Reads the driver identification and drops entries produced by any other
+  /// driver. Requires a current GL context.
+  void init();
+  /// \param source_hash **[in]** hash of all program sources
+  /// \param program **[out]** receives the cached binary
+  /// \return true on cache hit
+  bool load(u64 source_hash, ShaderProgram &program);
+  /// \param source_hash **[in]** hash of all program sources
+  /// \param program **[in]** successfully linked program
+  /// \return true if the binary was written
+  bool store(u64 source_hash, const ShaderProgram &program) const;
+  /// \return false if the driver supports no binary formats
+  [[nodiscard]] bool enabled() const { return enabled_; }
+
+  u32 hits{0};
+  u32 misses{0};
+private:
+  [[nodiscard]] std::string filename(u64 source_hash) const;
+
+  std::string directory_;
+  u64 driver_hash_{0};
+  bool enabled_{false};
+};
+
+#endif //GLSL_EXPERIMENTS_PROGRAM_BINARY_CACHE_H
@@ -0,0 +1,63 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file program_variants.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "program_variants.h"
+
+#include <algorithm>
+
+ProgramVariants::ProgramVariants(u32 capacity) : capacity_(std::max(capacity, 1u)) {}
+
+void ProgramVariants::put(u64 source_hash, ShaderProgram program) {
+  if (!program.id())
+    return;
+  auto &entry = programs_[source_hash];
+  entry.program = std::move(program);
+  entry.last_used = ++clock_;
+  if (programs_.size() <= capacity_)
+    return;
+  auto lru = programs_.begin();
+  for (auto it = programs_.begin(); it != programs_.end(); ++it)
+    if (it->second.last_used < lru->second.last_used)
+      lru = it;
+  programs_.erase(lru);
+}
+
+bool ProgramVariants::take(u64 source_hash, ShaderProgram &program) {
+  auto it = programs_.find(source_hash);
+  if (it == programs_.end()) {
+    misses++;
+    return false;
+  }
+  hits++;
+  program = std::move(it->second.program);
+  programs_.erase(it);
+  return true;
+}
+
+void ProgramVariants::clear() {
+  programs_.clear();
+}
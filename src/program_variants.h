@@ -0,0 +1,71 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file program_variants.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief In memory LRU of linked program variants.
+
+#ifndef GLSL_EXPERIMENTS_PROGRAM_VARIANTS_H
+#define GLSL_EXPERIMENTS_PROGRAM_VARIANTS_H
+
+#include "shader_program.h"
+
+/// Linked programs that are not being rendered, kept in memory so switching
+/// back to them (ex: toggling a shader feature) costs no compilation and no
+/// binary load. Programs are keyed by the hash of their preprocessed sources,
+/// which covers the feature #defines, and the least recently used program is
+/// deleted when the capacity is exceeded.
+///
+/// Usage:
+///   ShaderProgram program;
+///   if (!variants.take(hash, program))
+///     ... compile and link program
+///   variants.put(current_hash, std::move(current_program));
+class ProgramVariants {
+public:
+  /// \param capacity **[in]** programs kept, at least 1
+  explicit ProgramVariants(u32 capacity);
+  /// \param source_hash **[in]** hash of the program sources
+  /// \param program **[in]** successfully linked program, moved into the cache
+  void put(u64 source_hash, ShaderProgram program);
+  /// Moves the program of **source_hash** out of the cache
+  /// \param source_hash **[in]**
+  /// \param program **[out]**
+  /// \return true on cache hit
+  bool take(u64 source_hash, ShaderProgram &program);
+  void clear();
+  [[nodiscard]] size_t size() const { return programs_.size(); }
+
+  u32 hits{0};
+  u32 misses{0};
+private:
+  struct Entry {
+    ShaderProgram program;
+    u64 last_used{0};
+  };
+  std::unordered_map<u64, Entry> programs_;
+  u32 capacity_;
+  u64 clock_{0};
+};
+
+#endif //GLSL_EXPERIMENTS_PROGRAM_VARIANTS_H
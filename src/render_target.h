@@ -0,0 +1,62 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file render_target.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#ifndef GLSL_EXPERIMENTS_RENDER_TARGET_H
+#define GLSL_EXPERIMENTS_RENDER_TARGET_H
+
+#include <circe/circe.h>
+
+/// Framebuffer object with an RGBA8 color and a 24 bit depth attachment.
+class RenderTarget {
+public:
+  RenderTarget() = default;
+  RenderTarget(const RenderTarget &) = delete;
+  RenderTarget &operator=(const RenderTarget &) = delete;
+  ~RenderTarget();
+  /// (Re)creates the attachments, if the size changed.
+  /// \param width **[in]**
+  /// \param height **[in]**
+  /// \return false if the framebuffer is incomplete
+  bool resize(u32 width, u32 height);
+  void destroy();
+  /// Binds the framebuffer and sets the viewport to cover it
+  void bind() const;
+  /// \param pixels **[out]** width * height RGBA8 pixels, bottom row first
+  void read(std::vector<u8> &pixels) const;
+  [[nodiscard]] GLuint id() const { return fbo_; }
+  [[nodiscard]] u32 width() const { return width_; }
+  [[nodiscard]] u32 height() const { return height_; }
+
+private:
+  GLuint fbo_{0};
+  GLuint color_{0};
+  GLuint depth_{0};
+  u32 width_{0};
+  u32 height_{0};
+};
+
+#endif //GLSL_EXPERIMENTS_RENDER_TARGET_H
@@ -0,0 +1,114 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shader_config.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "shader_config.h"
+
+#include <json11.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+bool readText(const std::filesystem::path &path, std::string &text) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    return false;
+  text.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  return true;
+}
+
+void readVec3(const json11::Json &json, f32 *v) {
+  for (int d = 0; d < 3; ++d)
+    v[d] = static_cast<f32>(json[d].number_value());
+}
+
+}
+
+bool loadShaderConfig(const std::string &path, ShaderConfig &config, std::string &err) {
+  std::string text;
+  if (!readText(path, text)) {
+    err = "could not open " + path;
+    return false;
+  }
+  auto json = json11::Json::parse(text, err);
+  if (!err.empty())
+    return false;
+  config.path = path;
+  const auto &light = json["light"];
+  readVec3(light["direction"], config.light.direction);
+  readVec3(light["point"], config.light.point);
+  readVec3(light["ambient"], config.light.ambient);
+  readVec3(light["diffuse"], config.light.diffuse);
+  readVec3(light["specular"], config.light.specular);
+  const auto &material = json["material"];
+  readVec3(material["kAmbient"], config.material.k_ambient);
+  readVec3(material["kDiffuse"], config.material.k_diffuse);
+  readVec3(material["kSpecular"], config.material.k_specular);
+  config.material.shininess = static_cast<f32>(material["shininess"].number_value());
+  std::filesystem::path directory = std::filesystem::path(path).parent_path();
+  for (int i = 0; i < ShaderConfig::texture_count; ++i) {
+    const auto &texture = json["t" + std::to_string(i)];
+    config.texture_units[i] = texture["unit_name"].string_value();
+    if (config.texture_units[i].empty())
+      config.texture_units[i] = "GL_TEXTURE" + std::to_string(i);
+    auto file = texture["path"].string_value();
+    config.textures[i] = file.empty() ? std::string() : (directory / file).string();
+  }
+  auto environment = json["environment"].string_value();
+  config.environment = environment.empty() ? std::string() : (directory / environment).string();
+  // "features": {"NAME": default state}, json objects keep names sorted
+  config.features.clear();
+  for (const auto &feature : json["features"].object_items())
+    config.features.push_back({feature.first, feature.second.bool_value()});
+  if (config.features.size() > max_shader_features) {
+    err = path + ": more than " + std::to_string(max_shader_features) + " features";
+    return false;
+  }
+  // stages are optional, the editor starts with empty sources if they are missing
+  auto basename = directory / std::filesystem::path(path).stem();
+  config.vertex_source.clear();
+  config.fragment_source.clear();
+  readText(basename.string() + ".vert", config.vertex_source);
+  readText(basename.string() + ".frag", config.fragment_source);
+  return true;
+}
+
+u32 defaultFeatureMask(const std::vector<ShaderFeature> &features) {
+  u32 mask = 0;
+  for (size_t i = 0; i < features.size() && i < max_shader_features; ++i)
+    if (features[i].enabled)
+      mask |= 1u << i;
+  return mask;
+}
+
+std::string featureDefines(const std::vector<ShaderFeature> &features, u32 mask) {
+  std::string defines;
+  for (size_t i = 0; i < features.size() && i < max_shader_features; ++i)
+    if (mask & (1u << i))
+      defines += "#define " + features[i].name + " 1\n";
+  return defines;
+}
@@ -0,0 +1,71 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shader_config.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#ifndef GLSL_EXPERIMENTS_SHADER_CONFIG_H
+#define GLSL_EXPERIMENTS_SHADER_CONFIG_H
+
+#include "uniform_blocks.h"
+
+constexpr u32 max_shader_features = 32;
+
+/// Compile time toggle of a config. Enabled features are defined right after
+/// #version (#define NAME 1), each combination of them (a bitmask, bit i for
+/// feature i) giving its own specialized program.
+struct ShaderFeature {
+  std::string name;
+  bool enabled{false}; //!< default state
+};
+
+/// Content of a shader config (foo/foo.json), with the stage sources found
+/// next to it (foo/foo.vert, foo/foo.frag).
+struct ShaderConfig {
+  static constexpr int texture_count = 2;
+  std::string path;
+  LightBlockData light;
+  MaterialBlockData material;
+  std::string texture_units[texture_count]; //!< GL_TEXTURE0, GL_TEXTURE1, ...
+  std::string textures[texture_count];      //!< image paths, empty if unused
+  std::string environment;                  //!< equirectangular .hdr path, empty if unused
+  std::vector<ShaderFeature> features;      //!< sorted by name
+  std::string vertex_source;
+  std::string fragment_source;
+};
+
+/// \param path **[in]** config json
+/// \param config **[out]**
+/// \param err **[out]**
+/// \return false if the json could not be parsed
+bool loadShaderConfig(const std::string &path, ShaderConfig &config, std::string &err);
+/// \param features **[in]**
+/// \return bitmask of the features enabled by default
+u32 defaultFeatureMask(const std::vector<ShaderFeature> &features);
+/// \param features **[in]**
+/// \param mask **[in]** bit i enables features[i]
+/// \return #define lines of the enabled features, for ShaderIncludeCache::preprocess
+std::string featureDefines(const std::vector<ShaderFeature> &features, u32 mask);
+
+#endif //GLSL_EXPERIMENTS_SHADER_CONFIG_H
@@ -27,6 +27,33 @@
 
 #include <circe/circe.h>
 #include <json11.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <utility>
+#include "hash.h"
+#include "async_shader.h"
+#include "environment_map.h"
+#include "file_watcher.h"
+#include "frame_capture.h"
+#include "gpu_mesh.h"
+#include "instance_buffer.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "profiler.h"
+#include "program_binary_cache.h"
+#include "program_variants.h"
+#include "shader_config.h"
+#include "shader_preprocessor.h"
+#include "shadow_map.h"
+#include "terrain_renderer.h"
+#include "texture_streamer.h"
+#include "uniform_blocks.h"
+#include "uniform_binding_table.h"
+#include "vertex_format.h"
 
 using namespace json11;
 using namespace circe::gl;
@@ -75,6 +102,17 @@ struct Light {
         {"diffuse", diffuse},
         {"specular", specular}};
   }
+  [[nodiscard]] LightBlockData block() const {
+    LightBlockData data;
+    for (int d = 0; d < 3; ++d) {
+      data.direction[d] = direction[d];
+      data.point[d] = point[d];
+      data.ambient[d] = ambient[d];
+      data.diffuse[d] = diffuse[d];
+      data.specular[d] = specular[d];
+    }
+    return data;
+  }
 };
 
 struct Material {
@@ -90,6 +128,16 @@ struct Material {
         {"shininess", shininess}
     };
   }
+  [[nodiscard]] MaterialBlockData block() const {
+    MaterialBlockData data;
+    for (int d = 0; d < 3; ++d) {
+      data.k_ambient[d] = kAmbient[d];
+      data.k_diffuse[d] = kDiffuse[d];
+      data.k_specular[d] = kSpecular[d];
+    }
+    data.shininess = shininess;
+    return data;
+  }
 };
 
 struct LightObject {
@@ -194,8 +242,12 @@ struct LightObject {
 
 class TextureUnit {
 public:
-  TextureUnit() {
-    // load default check texture
+  TextureUnit() = default;
+  TextureUnit(const TextureUnit &) = delete;
+  TextureUnit &operator=(const TextureUnit &) = delete;
+  ~TextureUnit() {
+    if (texture_)
+      glDeleteTextures(1, &texture_);
   }
   void show(const ponos::Path &config_path) {
     if (ImGui::Button(unit_name.c_str()))
@@ -211,98 +263,501 @@ public:
     ImGui::SameLine();
     if (ImGui::Button(ponos::concat("View ", unit_name).c_str()))
       show_view_ = !show_view_;
+    if (!status_.empty())
+      ImGui::Text("%s\n", status_.c_str());
     if (show_view_) {
       ImGui::Begin(unit_name.c_str(), &show_view_);
-      texture.bind(GL_TEXTURE0);
-      ImGui::Image((void *) (intptr_t) (texture.textureObjectId()), {256, 256},
+      ImGui::Image((void *) (intptr_t) (textureObjectId()), {256, 256},
                    {0, 1}, {1, 0});
       ImGui::End();
     }
   }
+  /// Requests **path** from the streamer. The placeholder (or the previous
+  /// texture) stays bound until the upload completes.
   void load(const ponos::Path &path) {
     path_ = path;
-    texture = Texture::fromFile(path);
+    if (!streamer)
+      return;
+    status_ = "loading...";
+    u32 request = ++request_;
+    streamer->load(path.fullName(), [this, request](GLuint texture, const TextureStreamer::Stats &stats,
+                                                    const std::string &err) {
+      if (request != request_) {
+        // a newer load was requested meanwhile
+        if (texture)
+          glDeleteTextures(1, &texture);
+        return;
+      }
+      if (!texture) {
+        status_ = err;
+        return;
+      }
+      if (texture_)
+        glDeleteTextures(1, &texture_);
+      texture_ = texture;
+      char text[128];
+      snprintf(text, sizeof(text), "%s | %.1f MB | load %.1f ms | upload %.1f ms (%u frames)",
+               pixelFormatName(stats.format), stats.bytes / 1048576.0, stats.decode_ms, stats.upload_ms,
+               stats.upload_frames);
+      status_ = text;
+    });
+  }
+  void bind(GLenum unit) const {
+    glActiveTexture(unit);
+    glBindTexture(GL_TEXTURE_2D, textureObjectId());
   }
+  /// \return loaded texture, or the placeholder while there is none
+  [[nodiscard]] GLuint textureObjectId() const { return texture_ ? texture_ : placeholder(); }
+  [[nodiscard]] const ponos::Path &path() const { return path_; }
   [[nodiscard]] Json to_json() const { return Json::object{{"unit_name", unit_name}, {"path", path_.fullName()}}; }
 
   std::string unit_name = "GL_TEXTURE0";
-  Texture texture;
+  TextureStreamer *streamer{nullptr};
 private:
+  /// \return checker texture shared by all units
+  static GLuint placeholder() {
+    static GLuint texture = 0;
+    if (!texture) {
+      u32 pixels[8 * 8];
+      for (int i = 0; i < 64; ++i)
+        pixels[i] = ((i / 8 + i % 8) % 2) ? 0xff404040 : 0xffc0c0c0;
+      glGenTextures(1, &texture);
+      glBindTexture(GL_TEXTURE_2D, texture);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 8, 8, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+    return texture;
+  }
+
+  GLuint texture_{0};
+  u32 request_{0};
+  std::string status_;
   bool show_view_{false};
   ponos::Path path_;
 };
 
 struct UniformData {
   u64 index;
-  Program::Uniform data;
+  ShaderProgram::Uniform data;
+};
+
+/// Stage file as last loaded or saved, tells unsaved edits apart when the
+/// file changes on disk
+struct StageFile {
+  std::string saved_text;
+  bool changed_on_disk{false}; //!< while the editor had unsaved edits
+};
+
+/// Shader stage that is only recompiled when the content of its expanded
+/// source (includes too) changes. Compilation does not wait for the driver,
+/// finish() collects its result.
+struct ShaderStage {
+  explicit ShaderStage(GLuint type) : type(type) {}
+  /// Starts compiling **preprocessed**, unless the stage already holds it
+  /// \param preprocessed **[in]** stage source code, includes expanded
+  void update(PreprocessedSource preprocessed) {
+    auto h = hash_string(preprocessed.code);
+    source = std::move(preprocessed);
+    if (h == source_hash)
+      return;
+    source_hash = h;
+    shader.compile(source.code, type);
+    finished = false;
+  }
+  /// Waits for the compilation if it is still running
+  /// \return true if the stage holds a valid compiled shader for its source
+  bool finish() {
+    if (!finished && !shader.finish())
+      shader.err = source.mapLog(shader.err);
+    finished = true;
+    return shader.compiled();
+  }
+  AsyncShader shader;
+  GLuint type;
+  PreprocessedSource source;
+  u64 source_hash{0};
+  bool finished{true};
+};
+
+/// Decides when the shader program should be rebuilt. Edits keep pushing the
+/// rebuild forward by a debounce interval, so typing does not trigger one
+/// compilation per keystroke.
+class ShaderRebuildScheduler {
+public:
+  /// Registers editor activity
+  void notifyEdit() {
+    pending_ = true;
+    idle_timer_.tick();
+  }
+  /// Schedules a rebuild for the next poll, ignoring the debounce interval
+  void requestNow() {
+    pending_ = true;
+    immediate_ = true;
+  }
+  /// \return true if a rebuild should happen now
+  bool poll() {
+    if (!pending_ || (!immediate_ && idle_timer_.tack() < debounce_ms))
+      return false;
+    pending_ = immediate_ = false;
+    return true;
+  }
+  [[nodiscard]] bool pending() const { return pending_; }
+
+  f64 debounce_ms{500};
+private:
+  bool pending_{false};
+  bool immediate_{false};
+  ponos::Timer idle_timer_;
 };
 
 class ShaderEditor : public BaseApp {
 public:
   ShaderEditor() : BaseApp(800, 800) {
     // texture views
-    for (int i = 0; i < 2; ++i)
+    for (int i = 0; i < 2; ++i) {
       texture_views[i].unit_name = ponos::concat("GL_TEXTURE", i);
+      texture_views[i].streamer = &texture_streamer;
+    }
     // editor
     auto lang = TextEditor::LanguageDefinition::GLSL();
     vertex_editor.SetLanguageDefinition(lang);
     fragment_editor.SetLanguageDefinition(lang);
+    // shader cache
+    binary_cache.init();
+    // builds run on driver threads while the current program keeps rendering
+    enableParallelShaderCompile(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+    // compressed textures
+    if (compressedTexturesSupported())
+      texture_streamer.cache = &texture_cache;
+    // hot reload
+    std::string err;
+    if (!file_watcher.start(err))
+      reload_status = err;
     loadConfig(ponos::Path(std::string(SHADERS_PATH) + "/blinn_phong/blinn_phong.json"));
     // reserved uniforms
-    reserved_uniforms.insert("cameraPosition");
-    reserved_uniforms.insert("model");
-    reserved_uniforms.insert("view");
-    reserved_uniforms.insert("projection");
-    reserved_uniforms.insert("screenResolution");
+    for (const auto *name : reserved_uniform_names)
+      reserved_uniforms.insert(name);
     // setup scene
     setupMesh();
-    buildShader();
+    setupFloor();
+    if (!buildShader())
+      compilation_status = "Err";
+    watchFiles();
   }
 
   void render(circe::CameraInterface *camera) override {
-    showInfo();
-    showControls();
-    showEditor(vertex_editor, "Vertex Shader", &show_vertex_editor);
-    showEditor(fragment_editor, "Fragment Shader", &show_fragment_editor);
+    profiler.beginFrame();
+    {
+      Profiler::Scope scope(profiler, ProfileSection::UI);
+      showInfo();
+      showControls();
+      showProfiler();
+      showEditor(vertex_editor, "Vertex Shader", &show_vertex_editor);
+      showEditor(fragment_editor, "Fragment Shader", &show_fragment_editor);
+    }
+    // rebuild shader program
+    {
+      Profiler::Scope scope(profiler, ProfileSection::REBUILD);
+      if (vertex_editor.IsTextChanged() || fragment_editor.IsTextChanged())
+        rebuild_scheduler.notifyEdit();
+      reloadChangedFiles();
+      pollBuild();
+      if (rebuild_scheduler.poll()) {
+        if (!buildShader())
+          compilation_status = "Err";
+        // includes may have changed
+        watchFiles();
+      }
+    }
     // render object
-    mesh_.program.use();
+    program_.use();
     // attach textures
-    for (int i = 0; i < 2; ++i) {
-      auto uniform_name = ponos::concat("channel", i);
-      if (mesh_.program.hasUniform(uniform_name)) {
-        mesh_.program.setUniform(uniform_name, i);
-        texture_views[i].texture.bind(GL_TEXTURE0 + i);
-      }
+    {
+      Profiler::Scope scope(profiler, ProfileSection::TEXTURES);
+      texture_streamer.update();
+      updateEnvironment();
+      for (int i = 0; i < 2; ++i)
+        if (channel_bindings[i] >= 0)
+          texture_views[i].bind(GL_TEXTURE0 + i);
+      // the environment takes the units after the channels
+      if (environment_bindings[0] >= 0 || environment_bindings[1] >= 0)
+        environment_map_.bind(GL_TEXTURE2, GL_TEXTURE3);
+    }
+    {
+      Profiler::Scope scope(profiler, ProfileSection::UNIFORMS);
+      for (int i = 0; i < 2; ++i)
+        if (channel_bindings[i] >= 0)
+          uniform_bindings.set(channel_bindings[i], i);
+      for (int i = 0; i < 2; ++i)
+        uniform_bindings.set(environment_bindings[i], 2 + i);
+      uniform_bindings.set(shadow_map_binding, 4);
+      for (size_t i = 0; i < vec3_uniforms.size(); ++i)
+        uniform_bindings.set(vec3_bindings[i], vec3_uniforms[i]);
+      for (size_t i = 0; i < f32_uniforms.size(); ++i)
+        uniform_bindings.set(f32_bindings[i], f32_uniforms[i]);
+      uniform_bindings.set(reserved_bindings[ReservedUniform::MODEL],
+                           ponos::transpose(objectTransform().matrix()));
+      uniform_bindings.set(reserved_bindings[ReservedUniform::VIEW],
+                           ponos::transpose(camera->getViewTransform().matrix()));
+      uniform_bindings.set(reserved_bindings[ReservedUniform::PROJECTION],
+                           ponos::transpose(camera->getProjectionTransform().matrix()));
+      uniform_bindings.set(reserved_bindings[ReservedUniform::CAMERA_POSITION], camera->getPosition());
+      uniform_bindings.set(reserved_bindings[ReservedUniform::SCREEN_RESOLUTION],
+                           ponos::vec2(this->app_->viewports[0].width, this->app_->viewports[0].height));
+      uniform_bindings.set(reserved_bindings[ReservedUniform::TIME], static_cast<f32>(clock.tack() / 1000));
+      updateInstances();
+      uniform_bindings.set(reserved_bindings[ReservedUniform::INSTANCE_COUNT],
+                           static_cast<int>(instancing() ? instance_buffer_.count() : 0));
+      // terrain chunks are always float
+      const auto dequantization = draw_terrain_ ? VertexDequantization() : mesh_dequantization_;
+      uniform_bindings.set(reserved_bindings[ReservedUniform::POSITION_SCALE],
+                           ponos::vec3(dequantization.position_scale[0], dequantization.position_scale[1],
+                                       dequantization.position_scale[2]));
+      uniform_bindings.set(reserved_bindings[ReservedUniform::POSITION_OFFSET],
+                           ponos::vec3(dequantization.position_offset[0], dequantization.position_offset[1],
+                                       dequantization.position_offset[2]));
+      uniform_bindings.set(reserved_bindings[ReservedUniform::NORMAL_ENCODING], dequantization.normal_encoding);
+      uniform_call_count = uniform_bindings.upload();
+      updateUniformBlocks(camera);
+    }
+    {
+      Profiler::Scope scope(profiler, ProfileSection::SHADOWS);
+      renderShadows(camera);
+      // the depth pass has its own program
+      program_.use();
+    }
+    {
+      Profiler::Scope scope(profiler, ProfileSection::DRAW);
+      updateLods();
+      const auto &mesh = draw_mesh_ ? imported_mesh_ : shape_mesh_;
+      current_lod_ = draw_terrain_ ? 0 : selectMeshLod(mesh, camera);
+      glEnable(GL_DEPTH_TEST);
+      if (draw_terrain_)
+        drawTerrain(camera);
+      else if (instancing()) {
+        // every copy in a single call
+        instance_buffer_.bind();
+        mesh.drawInstanced(instance_buffer_.count(), current_lod_);
+      } else if (draw_mesh_ || vertex_format_ != VertexFormat::FLOAT || mesh.lods().size() > 1)
+        mesh.draw(current_lod_);
+      else
+        model.draw();
+      if (shadows())
+        drawFloor();
+    }
+    // before ImGui draws on top of the scene
+    {
+      Profiler::Scope scope(profiler, ProfileSection::CAPTURE);
+      captureFrame();
     }
-    for (const auto &u : vec3_uniform_names)
-      if (mesh_.program.hasUniform(u.first))
-        mesh_.program.setUniform(u.first, vec3_uniforms[u.second.index]);
-    for (const auto &u : f32_uniform_names)
-      if (mesh_.program.hasUniform(u.first))
-        mesh_.program.setUniform(u.first, f32_uniforms[u.second.index]);
-
-    if (mesh_.program.hasUniform("model"))
-      mesh_.program.setUniform("model", ponos::transpose(mesh_.transform.matrix()));
-    if (mesh_.program.hasUniform("view"))
-      mesh_.program.setUniform("view",
-                               ponos::transpose(camera->getViewTransform().matrix()));
-    if (mesh_.program.hasUniform("projection"))
-      mesh_.program.setUniform("projection",
-                               ponos::transpose(camera->getProjectionTransform().matrix()));
-    if (mesh_.program.hasUniform("cameraPosition"))
-      mesh_.program.setUniform("cameraPosition", camera->getPosition());
-    if (mesh_.program.hasUniform("screenResolution"))
-      mesh_.program.setUniform("screenResolution",
-                               ponos::vec2(this->app_->viewports[0].width, this->app_->viewports[0].height));
-    glEnable(GL_DEPTH_TEST);
-//    mesh_.draw();
-    model.draw();
 //    light_object.light = &light;
 //    light_object.render(camera);
   }
 
+  void updateUniformBlocks(circe::CameraInterface *camera) {
+    if (uses_frame_block) {
+      FrameBlockData data;
+      copyMatrix(ponos::transpose(camera->getViewTransform().matrix()), data.view);
+      copyMatrix(ponos::transpose(camera->getProjectionTransform().matrix()), data.projection);
+      auto camera_position = camera->getPosition();
+      for (int d = 0; d < 3; ++d)
+        data.camera_position[d] = camera_position[d];
+      data.time = static_cast<f32>(clock.tack() / 1000);
+      data.screen_resolution[0] = this->app_->viewports[0].width;
+      data.screen_resolution[1] = this->app_->viewports[0].height;
+      uniform_call_count += frame_block.update(&data);
+      frame_block.bind();
+    }
+    if (uses_scene_block) {
+      SceneBlockData data;
+      data.light = light.block();
+      data.material = material.block();
+      uniform_call_count += scene_block.update(&data);
+      scene_block.bind();
+    }
+    if (uses_environment_block) {
+      EnvironmentBlockData data;
+      environment_map_.blockData(data);
+      data.intensity = environment_intensity_;
+      data.enabled = environment_enabled_ && environment_map_.loaded();
+      uniform_call_count += environment_block.update(&data);
+      environment_block.bind();
+    }
+  }
+
+  /// Fits the cascades to the camera, renders the object into the shadow
+  /// atlas and updates the ShadowBlock. The floor only receives shadows, so
+  /// it is left out of the depth pass.
+  void renderShadows(circe::CameraInterface *camera) {
+    shadow_cascade_count_ = 0;
+    std::string err;
+    shadow_params_.resolution = 512u << shadow_resolution_;
+    // nothing samples the atlas unless the program declares the block
+    const bool enabled = shadows() && uses_shadow_block;
+    if (enabled && !shadow_map_.resize(shadow_params_.resolution, shadow_params_.cascade_count, err))
+      shadow_status_ = err;
+    else if (enabled) {
+      f32 view_projection[4][4], light_direction[3], bounds[6];
+      copyMatrix((camera->getProjectionTransform() * camera->getViewTransform()).matrix(), &view_projection[0][0]);
+      for (int d = 0; d < 3; ++d)
+        light_direction[d] = light.direction[d];
+      sceneBounds(bounds);
+      shadow_cascade_count_ = fitShadowCascades(view_projection, light_direction, bounds, shadow_params_,
+                                                shadow_cascades_);
+      const auto &mesh = draw_mesh_ ? imported_mesh_ : shape_mesh_;
+      const u32 instance_count = instancing() ? instance_buffer_.count() : 0;
+      f32 model_matrix[4][4];
+      copyMatrix(objectTransform().matrix(), &model_matrix[0][0]);
+      if (instance_count)
+        instance_buffer_.bind();
+      shadow_map_.begin();
+      for (u32 c = 0; c < shadow_cascade_count_; ++c) {
+        shadow_map_.beginCascade(c, shadow_cascades_[c].view_projection);
+        shadow_map_.setObject(model_matrix, mesh_dequantization_, instance_count);
+        if (instance_count)
+          mesh.drawInstanced(instance_count, current_lod_);
+        else
+          mesh.draw(current_lod_);
+      }
+      shadow_map_.end();
+      shadow_status_ = ponos::concat(shadow_map_.width(), "x", shadow_map_.height(), " atlas");
+    }
+    if (uses_shadow_block) {
+      ShadowBlockData data;
+      data.cascade_count = static_cast<i32>(shadow_cascade_count_);
+      data.bias = shadow_bias_;
+      for (u32 c = 0; c < shadow_cascade_count_; ++c) {
+        // column major
+        for (int i = 0; i < 4; ++i)
+          for (int j = 0; j < 4; ++j)
+            data.matrices[c][j * 4 + i] = shadow_cascades_[c].shadow_matrix[i][j];
+        shadowAtlasTile(shadow_cascade_count_, c, data.tiles[c]);
+        data.splits[c] = shadow_cascades_[c].far;
+      }
+      uniform_call_count += shadow_block.update(&data);
+      shadow_block.bind();
+    }
+    if (shadow_map_binding >= 0 && shadow_cascade_count_)
+      shadow_map_.bind(GL_TEXTURE4);
+  }
+
+  /// \param bounds **[out]** world space min, max of the object, or of every instance
+  void sceneBounds(f32 bounds[6]) const {
+    const auto m = objectTransform().matrix();
+    for (int d = 0; d < 3; ++d) {
+      bounds[d] = std::numeric_limits<f32>::max();
+      bounds[d + 3] = std::numeric_limits<f32>::lowest();
+    }
+    for (int corner = 0; corner < 8; ++corner)
+      for (int i = 0; i < 3; ++i) {
+        f32 v = m.m[i][3];
+        for (int j = 0; j < 3; ++j)
+          v += m.m[i][j] * lod_bounds_[j + ((corner >> j) & 1) * 3];
+        bounds[i] = std::min(bounds[i], v);
+        bounds[i + 3] = std::max(bounds[i + 3], v);
+      }
+    if (instancing()) {
+      // instances fill a cube around the origin, rotated around y and scaled
+      // up to 1.5x
+      f32 radius = 0;
+      for (int d = 0; d < 3; ++d)
+        radius += std::max(bounds[d] * bounds[d], bounds[d + 3] * bounds[d + 3]);
+      radius = std::sqrt(radius) * 1.5f * instance_params_.scale;
+      const f32 side = std::ceil(std::cbrt(static_cast<f32>(instance_params_.count)));
+      for (int d = 0; d < 3; ++d) {
+        bounds[d] = -0.5f * side * instance_params_.spacing - radius;
+        bounds[d + 3] = 0.5f * side * instance_params_.spacing + radius;
+      }
+    }
+  }
+
+  /// Draws the floor under the scene with the current program
+  void drawFloor() {
+    f32 bounds[6], size = 0;
+    sceneBounds(bounds);
+    for (int d = 0; d < 3; ++d)
+      size = std::max(size, bounds[d + 3] - bounds[d]);
+    auto transform = ponos::translate(ponos::vec3((bounds[0] + bounds[3]) * 0.5f, bounds[1],
+                                                  (bounds[2] + bounds[5]) * 0.5f))
+        * ponos::scale(4 * size, 1, 4 * size);
+    const VertexDequantization dequantization;
+    uniform_bindings.set(reserved_bindings[ReservedUniform::MODEL], ponos::transpose(transform.matrix()));
+    uniform_bindings.set(reserved_bindings[ReservedUniform::INSTANCE_COUNT], 0);
+    uniform_bindings.set(reserved_bindings[ReservedUniform::POSITION_SCALE], ponos::vec3(1, 1, 1));
+    uniform_bindings.set(reserved_bindings[ReservedUniform::POSITION_OFFSET], ponos::vec3(0, 0, 0));
+    uniform_bindings.set(reserved_bindings[ReservedUniform::NORMAL_ENCODING], dequantization.normal_encoding);
+    uniform_call_count += uniform_bindings.upload();
+    floor_mesh_.draw();
+  }
+
+  /// Queues the read back of the frame just drawn, for a screenshot or the
+  /// next frame of a sequence, and collects the files written meanwhile.
+  void captureFrame() {
+    frame_capture_.poll();
+    if (screenshot_requested_ || recording_) {
+      std::error_code ec;
+      std::filesystem::create_directories(recording_ ? sequence_path_ : std::string(CAPTURE_PATH), ec);
+      std::string path;
+      if (recording_)
+        path = sequence_path_ + "/" + numbered("frame_", record_frame_, 5) + ".png";
+      else {
+        // never overwrites previous screenshots
+        auto name = ponos::FileSystem::basename(config_path.fullName(), ".json");
+        do
+          path = ponos::concat(CAPTURE_PATH, "/", numbered(name + "_", ++screenshot_count_, 3), ".png");
+        while (std::filesystem::exists(path));
+      }
+      frame_capture_.capture(0, this->app_->viewports[0].width, this->app_->viewports[0].height, path);
+      screenshot_requested_ = false;
+      if (recording_ && ++record_frame_ >= static_cast<u32>(turntable_frames_) && turntable_)
+        recording_ = false;
+    }
+    capture_status_ = ponos::concat(frame_capture_.written, " written | ", frame_capture_.pending(), " pending | ",
+                                    frame_capture_.stalls, " stalls");
+    if (frame_capture_.failed)
+      capture_status_ += ponos::concat("\n", frame_capture_.failed, " failed: ", frame_capture_.err);
+  }
+
+  /// Starts writing every frame into a new directory under CAPTURE_PATH
+  void startRecording() {
+    auto name = ponos::FileSystem::basename(config_path.fullName(), ".json");
+    do
+      sequence_path_ = ponos::concat(CAPTURE_PATH, "/", numbered(name + "_sequence_", ++sequence_count_, 3));
+    while (std::filesystem::exists(sequence_path_));
+    record_frame_ = 0;
+    recording_ = true;
+  }
+
+  /// \return **prefix** followed by **number** zero padded to **digits**
+  static std::string numbered(const std::string &prefix, u32 number, int digits) {
+    char text[16];
+    snprintf(text, sizeof(text), "%0*u", digits, number);
+    return prefix + text;
+  }
+
+  /// Chunks are selected and culled in object space, so a turntable
+  /// recording spins the culling along with the terrain
+  void drawTerrain(circe::CameraInterface *camera) {
+    const auto model = objectTransform();
+    auto view_projection = (camera->getProjectionTransform() * camera->getViewTransform() * model).matrix();
+    f32 m[4][4], eye[3];
+    copyMatrix(view_projection, &m[0][0]);
+    auto camera_position = ponos::inverse(model)(camera->getPosition());
+    for (int d = 0; d < 3; ++d)
+      eye[d] = camera_position[d];
+    terrain_renderer_.draw(m, eye);
+  }
+
+  static void copyMatrix(const ponos::mat4 &m, f32 *data) {
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        data[i * 4 + j] = m.m[i][j];
+  }
+
   void showInfo() {
-    static ponos::Timer timer;
     static bool show = true;
     ImGuiIO &io = ImGui::GetIO();
     ImGui::SetNextWindowBgAlpha(0.35f); // Transparent background
@@ -310,43 +765,177 @@ public:
         ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings
             | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
     if (ImGui::Begin("Example: Simple overlay", &show, window_flags)) {
-      auto t = 2 - timer.tack() / 1000;
-      static std::string compilation_status;
-      if (t < 0) {
-        if (buildShader())
-          compilation_status = "Ok";
-        else
-          compilation_status = "Err";
-        timer.tick();
-      }
-      ImGui::Text("Compilation %s (next %.2f)\n", compilation_status.c_str(), t);
+      ImGui::Text("Compilation %s%s\n", compilation_status.c_str(),
+                  rebuild_scheduler.pending() ? " (pending)" : "");
+      if (program_from_variants)
+        ImGui::Text("variant swap %.2f ms (%u hits)\n", link_ms, program_variants.hits);
+      else if (program_from_cache)
+        ImGui::Text("cached binary %.2f ms (%u hits)\n", link_ms, binary_cache.hits);
+      else
+        ImGui::Text("build %.2f ms%s\n", build_ms, parallelShaderCompileEnabled() ? " (driver threads)" : "");
+      if (!reload_status.empty())
+        ImGui::Text("%s\n", reload_status.c_str());
       ImGui::Separator();
-      ImGui::Text("FPS %u\n", this->last_FPS_);
+      const auto &frame = profiler.sections()[ProfileSection::FRAME];
+      ImGui::Text("FPS %u | frame %.2f ms (p99 %.2f ms)\n", this->last_FPS_, frame.cpu.last(),
+                  frame.cpu.percentiles().p99);
+      ImGui::SameLine();
+      ImGui::Checkbox("Profiler", &show_profiler);
+      ImGui::Text("Uniform calls %u/%zu\n", uniform_call_count, uniform_bindings.size());
+      const auto &mesh = draw_mesh_ ? imported_mesh_ : shape_mesh_;
+      if (instancing())
+        ImGui::Text("Instances %u | triangles %llu | generated in %.2f ms\n", instance_buffer_.count(),
+                    static_cast<unsigned long long>(mesh.indexCount(current_lod_) / 3) * instance_buffer_.count(),
+                    instance_generation_ms_);
+      if (!draw_terrain_ && mesh.lods().size() > 1)
+        ImGui::Text("LOD %u/%zu | triangles %zu | error %.4f\n", current_lod_, mesh.lods().size() - 1,
+                    mesh.indexCount(current_lod_) / 3, mesh.level(current_lod_).error);
+      if (texture_streamer.pending())
+        ImGui::Text("Textures loading %zu | upload %zu KB %.2f ms\n", texture_streamer.pending(),
+                    texture_streamer.frameBytes() / 1024, texture_streamer.frameMs());
+      if (draw_terrain_) {
+        const auto &stats = terrain_renderer_.stats();
+        ImGui::Text("Terrain chunks %u | triangles %llu\n", stats.drawn_chunks,
+                    static_cast<unsigned long long>(stats.triangles));
+        ImGui::Text("resident %u | loading %u\n", stats.resident_chunks, stats.pending_chunks);
+      }
       ImGui::Separator();
       if (ImGui::IsMousePosValid())
         ImGui::Text("Mouse Position: (%.1f,%.1f)", io.MousePos.x, io.MousePos.y);
       else
         ImGui::Text("Mouse Position: <invalid>");
       ImGui::Separator();
-      ImGui::Text("Vertex Shader Compilation\n%s\n", vertex_shader.err.c_str());
+      ImGui::Text("Vertex Shader Compilation\n%s\n", vertex_stage.shader.err.c_str());
       ImGui::Separator();
-      ImGui::Text("Fragment Shader Compilation\n%s\n", fragment_shader.err.c_str());
+      ImGui::Text("Fragment Shader Compilation\n%s\n", fragment_stage.shader.err.c_str());
+
+    }
+    ImGui::End();
+  }
 
+  void showProfiler() {
+    if (!show_profiler)
+      return;
+    ImGui::Begin("Profiler", &show_profiler);
+    ImGui::Checkbox("GPU timestamps", &profiler.gpu_enabled);
+    ImGui::SameLine();
+    if (!profiler.capturing()) {
+      if (ImGui::Button("Start capture"))
+        profiler.startCapture();
+    } else if (ImGui::Button("Stop capture")) {
+      std::string err;
+      auto path = ponos::concat(CACHE_PATH, "/traces/trace_", ++trace_count, ".json");
+      profiler_status = profiler.stopCapture(path, err) ? "saved " + path : err;
     }
+    if (profiler.capturing())
+      ImGui::Text("capturing %zu events\n", profiler.capturedEvents());
+    else if (!profiler_status.empty())
+      ImGui::Text("%s\n", profiler_status.c_str());
+    if (profiler.droppedFrames())
+      ImGui::Text("GPU results dropped for %u frames\n", profiler.droppedFrames());
+    auto show_history = [](const std::string &name, const char *unit, const Profiler::History &history) {
+      if (!history.count)
+        return;
+      auto p = history.percentiles();
+      ImGui::Text("%s %s %6.2f ms | p50 %.2f p95 %.2f p99 %.2f max %.2f\n", name.c_str(), unit,
+                  history.last(), p.p50, p.p95, p.p99, p.max);
+      auto samples = history.ordered();
+      ImGui::PlotLines(ponos::concat("##", name, unit).c_str(), samples.data(), static_cast<int>(samples.size()),
+                       0, nullptr, 0, p.max, ImVec2(0, 40));
+    };
+    const auto &sections = profiler.sections();
+    // ImGui rendering and buffer swaps happen outside of render()
+    f32 outside = sections[ProfileSection::FRAME].cpu.last();
+    for (const auto &section : sections) {
+      if (&section != &sections[ProfileSection::FRAME])
+        outside -= section.cpu.last();
+      ImGui::Separator();
+      show_history(section.name, "cpu", section.cpu);
+      show_history(section.name, "gpu", section.gpu);
+    }
+    ImGui::Separator();
+    ImGui::Text("outside sections %.2f ms (cpu)\n", std::max(outside, 0.f));
     ImGui::End();
   }
 
   void showControls() {
     ImGui::Begin("Controls");
     showConfigFileButtons();
-    showLoadFile(vertex_editor, "Open Vertex Shader", "OpenFileVSKey", ".vert", show_vertex_editor);
-    showLoadFile(fragment_editor, "Open Fragment Shader", "OpenFileFSKey", ".frag", show_fragment_editor);
+    showLoadFile(vertex_editor, vertex_file, "Open Vertex Shader", "OpenFileVSKey", ".vert", show_vertex_editor);
+    showLoadFile(fragment_editor, fragment_file, "Open Fragment Shader", "OpenFileFSKey", ".frag",
+                 show_fragment_editor);
     ImGui::Separator();
     ImGui::Text("Mesh\n");
-    int mesh_option = 0;
-    if (ImGui::Combo("Mesh", (int *) &mesh_option, "Sphere\0Plane\0Terrain\0"))
-      setupMesh(mesh_option);
+    if (ImGui::Combo("Mesh", &mesh_option_,
+                     "Sphere\0Plane\0Terrain\0Cube\0Suzanne\0Teapot\0Geosphere\0Torus Knot\0"))
+      setupMesh(mesh_option_);
+    if (mesh_option_ < 2 && ImGui::Checkbox("Optimize vertex order", &optimize_shapes_)) {
+      last_mesh_option_ = -1;
+      setupMesh(mesh_option_);
+    }
+    if (!draw_terrain_ && ImGui::Combo("Vertex format", &vertex_format_,
+                                       "Float\0" "16 bit, octahedral normals\0" "16 bit, 10:10:10:2 normals\0")) {
+      if (draw_mesh_)
+        loadMesh(mesh_path_);
+      else {
+        last_mesh_option_ = -1;
+        setupMesh(mesh_option_);
+      }
+    }
+    if (!draw_terrain_) {
+      const auto &lods = (draw_mesh_ ? imported_mesh_ : shape_mesh_).lods();
+      if (lods.size() > 1) {
+        // -1 follows the screen size, otherwise the level is forced
+        ImGui::SliderInt("LOD", &lod_override_, -1, static_cast<int>(lods.size()) - 1,
+                         lod_override_ < 0 ? "auto" : "%d");
+        if (lod_override_ < 0)
+          ImGui::SliderFloat("LOD error (px)", &lod_error_pixels_, 0.1, 8.0);
+      }
+      ImGui::Text("%s\n", lod_status_.c_str());
+    }
+    if (mesh_option_ == 2) {
+      ImGui::Combo("Resolution", &terrain_resolution_, "256\0" "512\0" "1024\0" "2048\0" "4096\0" "8192\0"
+                                                       "16384\0");
+      ImGui::SliderInt("Octaves", &terrain_octaves_, 1, 12);
+      ImGui::SliderFloat("Frequency", &terrain_params_.frequency, 0.5, 16.0);
+      ImGui::SliderFloat("Height", &terrain_params_.height, 0.0, 1.0);
+      if (ImGui::Button("Generate"))
+        generateTerrain();
+    }
+    if (ImGui::Button("Open Mesh"))
+      igfd::ImGuiFileDialog::Instance()->OpenDialog("OpenMeshKey", "Choose File", ".obj",
+                                                    std::string(MODELS_PATH) + "/assets/");
+    if (igfd::ImGuiFileDialog::Instance()->FileDialog("OpenMeshKey")) {
+      if (igfd::ImGuiFileDialog::Instance()->IsOk)
+        loadMesh(igfd::ImGuiFileDialog::Instance()->GetFilePathName());
+      igfd::ImGuiFileDialog::Instance()->CloseDialog("OpenMeshKey");
+    }
+    ImGui::Text("%s\n", mesh_status.c_str());
+    if (!draw_terrain_) {
+      ImGui::Checkbox("Instancing", &instancing_);
+      if (instancing_) {
+        if (ImGui::InputInt("Instances", &instance_count_, 100, 1000))
+          instance_count_ = std::max(1, std::min(instance_count_, 1000000));
+        ImGui::Combo("Layout", &instance_params_.layout, "Grid\0Random\0");
+        ImGui::SliderFloat("Spacing", &instance_params_.spacing, 1.0, 10.0);
+        if (instance_params_.layout == InstanceLayout::RANDOM && ImGui::Button("Shuffle"))
+          instance_params_.seed++;
+      }
+    }
 //    ImGui::SliderFloat3("Scale", &mesh.scale[0], 0.0001, 100);
+    if (!features_.empty()) {
+      ImGui::Separator();
+      ImGui::Text("Features\n");
+      for (size_t i = 0; i < features_.size(); ++i) {
+        bool enabled = feature_mask_ & (1u << i);
+        if (ImGui::Checkbox(features_[i].name.c_str(), &enabled)) {
+          // a variant built before is swapped in, others are compiled now
+          feature_mask_ ^= 1u << i;
+          rebuild_scheduler.requestNow();
+        }
+      }
+      ImGui::Text("%zu variants kept\n", program_variants.size());
+    }
     ImGui::Separator();
     ImGui::Text("Uniforms\n");
     // Uniform Controls
@@ -356,6 +945,65 @@ public:
       if (f32_uniform_names.count(name))
         ImGui::SliderFloat(name.c_str(), &f32_uniforms[f32_uniform_names[name].index], 0.0, 1.0);
     }
+    if (uses_scene_block) {
+      ImGui::Separator();
+      ImGui::Text("Light\n");
+      ImGui::SliderFloat3("light.direction", &light.direction[0], -1.0, 1.0);
+      ImGui::SliderFloat3("light.point", &light.point[0], -10.0, 10.0);
+      ImGui::ColorEdit3("light.ambient", &light.ambient[0]);
+      ImGui::ColorEdit3("light.diffuse", &light.diffuse[0]);
+      ImGui::ColorEdit3("light.specular", &light.specular[0]);
+      ImGui::Text("Material\n");
+      ImGui::ColorEdit3("material.kAmbient", &material.kAmbient[0]);
+      ImGui::ColorEdit3("material.kDiffuse", &material.kDiffuse[0]);
+      ImGui::ColorEdit3("material.kSpecular", &material.kSpecular[0]);
+      ImGui::SliderFloat("material.shininess", &material.shininess, 0.0, 256.0);
+    }
+    if (uses_environment_block) {
+      ImGui::Separator();
+      ImGui::Text("Environment\n");
+      if (ImGui::Button("Open Environment"))
+        igfd::ImGuiFileDialog::Instance()->OpenDialog("OpenEnvironmentKey", "Choose File", ".hdr",
+                                                      std::string(TEXTURES_PATH) + "/assets/");
+      if (igfd::ImGuiFileDialog::Instance()->FileDialog("OpenEnvironmentKey")) {
+        if (igfd::ImGuiFileDialog::Instance()->IsOk)
+          loadEnvironment(igfd::ImGuiFileDialog::Instance()->GetFilePathName());
+        igfd::ImGuiFileDialog::Instance()->CloseDialog("OpenEnvironmentKey");
+      }
+      ImGui::Checkbox("Environment lighting", &environment_enabled_);
+      ImGui::SliderFloat("Environment intensity", &environment_intensity_, 0.0, 4.0);
+      ImGui::Text("%s\n", environment_status_.c_str());
+    }
+    ImGui::Separator();
+    ImGui::Text("Shadows\n");
+    if (!draw_terrain_)
+      ImGui::Checkbox("Shadows and floor", &shadows_);
+    if (shadows()) {
+      int cascade_count = static_cast<int>(shadow_params_.cascade_count);
+      if (ImGui::SliderInt("Cascades", &cascade_count, 1, max_shadow_cascades))
+        shadow_params_.cascade_count = static_cast<u32>(cascade_count);
+      ImGui::Combo("Shadow resolution", &shadow_resolution_, "512\0" "1024\0" "2048\0" "4096\0");
+      ImGui::SliderFloat("Shadow distance", &shadow_params_.max_distance, 1.0, 200.0);
+      ImGui::SliderFloat("Split lambda", &shadow_params_.split_lambda, 0.0, 1.0);
+      ImGui::SliderFloat("Shadow bias", &shadow_bias_, 0.0, 0.01, "%.4f");
+      ImGui::Text("%s\n", uses_shadow_block ? shadow_status_.c_str() : "the program does not use ShadowBlock");
+    }
+    ImGui::Separator();
+    ImGui::Text("Capture\n");
+    if (ImGui::Button("Screenshot"))
+      screenshot_requested_ = true;
+    ImGui::SameLine();
+    if (!recording_) {
+      if (ImGui::Button("Record"))
+        startRecording();
+    } else if (ImGui::Button("Stop"))
+      recording_ = false;
+    ImGui::Checkbox("Turntable", &turntable_);
+    if (turntable_)
+      ImGui::SliderInt("Turntable frames", &turntable_frames_, 30, 720);
+    if (recording_)
+      ImGui::Text("recording frame %u\n", record_frame_);
+    ImGui::Text("%s\n", capture_status_.c_str());
     ImGui::Separator();
     // Textures
     for (auto &v : texture_views)
@@ -391,7 +1039,9 @@ public:
             ponos::FileSystem::writeFile(config_path.fullName(),
                                          Json(Json::object{{"light", light}, {"material", material},
                                                            {"t0", texture_views[0]},
-                                                           {"t1", texture_views[1]}}).dump());
+                                                           {"t1", texture_views[1]},
+                                                           {"environment", environment_path_},
+                                                           {"features", featuresJson()}}).dump());
       }
       igfd::ImGuiFileDialog::Instance()->CloseDialog("SaveConfigKey");
     }
@@ -413,86 +1063,353 @@ public:
   }
 
   void showLoadFile(TextEditor &editor,
+                    StageFile &file,
                     const std::string &label,
                     const std::string &key,
-                    const std::string &file_ext, bool &p_open) const {
+                    const std::string &file_ext, bool &p_open) {
+    auto basename = config_path.cwd() + ponos::FileSystem::basename(config_path.fullName(), ".json");
     if (ImGui::Button(label.c_str()))
       igfd::ImGuiFileDialog::Instance()->OpenDialog(key, "Choose File", "", config_path.cwd().fullName());
     ImGui::SameLine();
     if (ImGui::Button(ponos::concat("Save ", file_ext).c_str())) {
-      auto basename = config_path.cwd() + ponos::FileSystem::basename(config_path.fullName(), ".json");
-      ponos::FileSystem::writeFile(ponos::concat(basename, file_ext), editor.GetText());
+      file.saved_text = editor.GetText();
+      file.changed_on_disk = false;
+      ponos::FileSystem::writeFile(ponos::concat(basename, file_ext), file.saved_text);
     }
     if (igfd::ImGuiFileDialog::Instance()->FileDialog(key)) {
       if (igfd::ImGuiFileDialog::Instance()->IsOk) {
-        editor.SetText(ponos::FileSystem::readFile(igfd::ImGuiFileDialog::Instance()->GetFilePathName() + file_ext));
+        file.saved_text =
+            ponos::FileSystem::readFile(igfd::ImGuiFileDialog::Instance()->GetFilePathName() + file_ext);
+        file.changed_on_disk = false;
+        editor.SetText(file.saved_text);
       }
       igfd::ImGuiFileDialog::Instance()->CloseDialog(key);
     }
     ImGui::SameLine();
     if (ImGui::Button(ponos::concat("Toggle ", file_ext).c_str()))
       p_open = !p_open;
+    if (file.changed_on_disk) {
+      // see reloadChangedFiles, unsaved edits are only replaced on request
+      ImGui::Text("%s changed on disk, the editor has unsaved edits\n", file_ext.c_str());
+      if (ImGui::Button(ponos::concat("Reload ", file_ext, " from disk").c_str())) {
+        file.saved_text = ponos::FileSystem::readFile(ponos::concat(basename, file_ext));
+        file.changed_on_disk = false;
+        editor.SetText(file.saved_text);
+        rebuild_scheduler.requestNow();
+      }
+      ImGui::SameLine();
+      if (ImGui::Button(ponos::concat("Keep ", file_ext, " edits").c_str()))
+        file.changed_on_disk = false;
+    }
   }
 
   void loadConfig(const ponos::Path &path) {
+    ShaderConfig config;
     std::string err;
-    auto json = Json::parse(ponos::FileSystem::readFile(path), err);
-    if (err.empty()) {
-      for (u32 d = 0; d < 3; ++d) {
-        light.direction[d] = json["light"]["direction"][d].number_value();
-        light.point[d] = json["light"]["point"][d].number_value();
-        light.ambient[d] = json["light"]["ambient"][d].number_value();
-        light.diffuse[d] = json["light"]["diffuse"][d].number_value();
-        light.specular[d] = json["light"]["specular"][d].number_value();
-        material.kAmbient[d] = json["material"]["kAmbient"][d].number_value();
-        material.kDiffuse[d] = json["material"]["kDiffuse"][d].number_value();
-        material.kSpecular[d] = json["material"]["kSpecular"][d].number_value();
+    if (!loadShaderConfig(path.fullName(), config, err))
+      return;
+    applySceneFields(config);
+    features_ = config.features;
+    feature_mask_ = defaultFeatureMask(features_);
+
+    config_path = path;
+
+    // load textures
+    for (int i = 0; i < 2; ++i) {
+      texture_views[i].unit_name = config.texture_units[i];
+      if (!config.textures[i].empty())
+        texture_views[i].load(ponos::Path(config.textures[i]));
+    }
+    if (!config.environment.empty())
+      loadEnvironment(config.environment);
+
+    vertex_editor.SetText(config.vertex_source);
+    fragment_editor.SetText(config.fragment_source);
+    vertex_file = {config.vertex_source, false};
+    fragment_file = {config.fragment_source, false};
+    rebuild_scheduler.requestNow();
+    file_watcher.clear();
+    watchFiles();
+  }
+
+  /// Copies light and material of **config**
+  void applySceneFields(const ShaderConfig &config) {
+    for (u32 d = 0; d < 3; ++d) {
+      light.direction[d] = config.light.direction[d];
+      light.point[d] = config.light.point[d];
+      light.ambient[d] = config.light.ambient[d];
+      light.diffuse[d] = config.light.diffuse[d];
+      light.specular[d] = config.light.specular[d];
+      material.kAmbient[d] = config.material.k_ambient[d];
+      material.kDiffuse[d] = config.material.k_diffuse[d];
+      material.kSpecular[d] = config.material.k_specular[d];
+    }
+    material.shininess = config.material.shininess;
+  }
+
+  /// Registers the files the current config is made of (stages, includes,
+  /// textures) in the file watcher
+  void watchFiles() {
+    if (!file_watcher.running())
+      return;
+    std::filesystem::path json = config_path.fullName();
+    std::vector<std::string> files = {json.string(),
+                                      std::filesystem::path(json).replace_extension(".vert").string(),
+                                      std::filesystem::path(json).replace_extension(".frag").string()};
+    for (const auto &view : texture_views)
+      if (!view.path().fullName().empty())
+        files.emplace_back(view.path().fullName());
+    for (const auto *stage : {&vertex_stage, &fragment_stage})
+      files.insert(files.end(), stage->source.dependencies.begin(), stage->source.dependencies.end());
+    std::string err;
+    for (const auto &file : files)
+      if (!file_watcher.watch(file, err))
+        reload_status = err;
+  }
+
+  /// Applies the changes other programs made to the files of the config,
+  /// reloading only the affected stage, texture unit or config fields. Custom
+  /// uniform values and the camera are kept.
+  void reloadChangedFiles() {
+    if (!file_watcher.running()) {
+      // no notifications, shared headers are polled instead
+      if (include_poll_timer.tack() > include_poll_ms) {
+        include_poll_timer.tick();
+        auto changed = include_cache.poll();
+        if (vertex_stage.source.dependsOn(changed) || fragment_stage.source.dependsOn(changed))
+          rebuild_scheduler.requestNow();
       }
-      material.shininess = json["material"]["shinniness"].number_value();
-
-      config_path = path;
-
-      // load textures
-      for (int i = 0; i < 2; ++i) {
-        auto tid = ponos::concat("t", i);
-        texture_views[i].unit_name = json[tid]["unit_name"].string_value();
-        if (texture_views[i].unit_name.empty())
-          texture_views[i].unit_name = ponos::concat("GL_TEXTURE", i);
-        auto tf = json[tid]["path"].string_value();
-        if (!tf.empty())
-          texture_views[i].load(ponos::Path(config_path.cwd() + tf));
+      return;
+    }
+    auto changed = file_watcher.poll();
+    if (changed.empty())
+      return;
+    ponos::Timer timer;
+    auto is_changed = [&](const std::string &path) {
+      return std::find(changed.begin(), changed.end(), FileWatcher::key(path)) != changed.end();
+    };
+    std::vector<std::string> reloaded, kept;
+    std::filesystem::path json = config_path.fullName();
+    if (is_changed(json.string()) && reloadConfigFields())
+      reloaded.emplace_back(json.filename().string());
+    // stages go through the editors, the rebuild recompiles only what changed
+    struct Stage {
+      TextEditor *editor;
+      StageFile *file;
+      const char *extension;
+    };
+    Stage stages[] = {{&vertex_editor, &vertex_file, ".vert"}, {&fragment_editor, &fragment_file, ".frag"}};
+    for (auto &stage : stages) {
+      auto path = std::filesystem::path(json).replace_extension(stage.extension).string();
+      if (!is_changed(path))
+        continue;
+      auto text = ponos::FileSystem::readFile(path);
+      auto name = std::filesystem::path(path).filename().string();
+      auto current = stage.editor->GetText();
+      if (!sameText(text, current)) {
+        if (!sameText(stage.file->saved_text, current)) {
+          // unsaved edits are never replaced silently, showLoadFile asks
+          stage.file->changed_on_disk = true;
+          kept.emplace_back(name);
+          continue;
+        }
+        stage.editor->SetText(text);
+        rebuild_scheduler.requestNow();
       }
+      stage.file->saved_text = text;
+      stage.file->changed_on_disk = false;
+      reloaded.emplace_back(name);
+    }
+    for (auto &view : texture_views) {
+      auto path = view.path();
+      if (!path.fullName().empty() && is_changed(path.fullName())) {
+        view.load(path);
+        reloaded.emplace_back(std::filesystem::path(path.fullName()).filename().string());
+      }
+    }
+    if (vertex_stage.source.dependsOn(changed) || fragment_stage.source.dependsOn(changed)) {
+      // content hashes tell saved from touched headers
+      auto headers = include_cache.poll();
+      if (vertex_stage.source.dependsOn(headers) || fragment_stage.source.dependsOn(headers))
+        rebuild_scheduler.requestNow();
+      for (const auto &header : headers)
+        reloaded.emplace_back(std::filesystem::path(header).filename().string());
+    }
+    if (reloaded.empty() && kept.empty())
+      return;
+    reload_status.clear();
+    if (!reloaded.empty()) {
+      reload_status = "reloaded";
+      for (const auto &name : reloaded)
+        reload_status += " " + name;
+      reload_status += ponos::concat(" (", timer.tack(), " ms)");
+    }
+    for (const auto &name : kept)
+      reload_status += (reload_status.empty() ? "" : "\n") + name + " changed on disk, unsaved edits kept";
+  }
 
-      auto basename = config_path.cwd() + ponos::FileSystem::basename(config_path.fullName(), ".json");
-
-      vertex_editor.SetText(ponos::FileSystem::readFile(ponos::concat(basename, ".vert")));
-      fragment_editor.SetText(ponos::FileSystem::readFile(ponos::concat(basename, ".frag")));
+  /// Reloads light, material, texture units and environment from the config
+  /// json. Only units whose image or name changed are touched.
+  /// \return false if the json could not be read
+  bool reloadConfigFields() {
+    ShaderConfig config;
+    std::string err;
+    if (!loadShaderConfig(config_path.fullName(), config, err)) {
+      reload_status = err;
+      return false;
+    }
+    applySceneFields(config);
+    for (int i = 0; i < 2; ++i) {
+      texture_views[i].unit_name = config.texture_units[i];
+      if (!config.textures[i].empty() && config.textures[i] != texture_views[i].path().fullName())
+        texture_views[i].load(ponos::Path(config.textures[i]));
+    }
+    if (!config.environment.empty() && config.environment != environment_job_.requested)
+      loadEnvironment(config.environment);
+    // toggles of unchanged features keep their current state
+    bool same_features = config.features.size() == features_.size();
+    for (size_t i = 0; same_features && i < features_.size(); ++i)
+      same_features = config.features[i].name == features_[i].name;
+    if (!same_features) {
+      features_ = config.features;
+      feature_mask_ = defaultFeatureMask(features_);
+      rebuild_scheduler.requestNow();
     }
+    watchFiles();
+    return true;
+  }
+
+  /// \return feature states as saved in the config json
+  [[nodiscard]] Json featuresJson() const {
+    Json::object features;
+    for (size_t i = 0; i < features_.size(); ++i)
+      features[features_[i].name] = (feature_mask_ & (1u << i)) != 0;
+    return features;
   }
 
+  /// \return true if **a** and **b** only differ by line endings or trailing new lines
+  static bool sameText(const std::string &a, const std::string &b) {
+    auto normalize = [](std::string s) {
+      s.erase(std::remove(s.begin(), s.end(), '\r'), s.end());
+      while (!s.empty() && s.back() == '\n')
+        s.pop_back();
+      return s;
+    };
+    return normalize(a) == normalize(b);
+  }
+
+  /// Starts building the program of the editor sources. The current program
+  /// keeps rendering until pollBuild installs the new one.
+  /// \return false if the sources could not be preprocessed
   bool buildShader() {
-    bool fail = false;
-    fail &= !vertex_shader.compile(vertex_editor.GetText(), GL_VERTEX_SHADER);
-    fail &= !fragment_shader.compile(fragment_editor.GetText(), GL_FRAGMENT_SHADER);
-    if (fail)
+    // includes are relative to the config directory
+    auto directory = config_path.cwd().fullName();
+    auto name = ponos::FileSystem::basename(config_path.fullName(), ".json");
+    PreprocessedSource vertex_source, fragment_source;
+    std::string err;
+    // each feature mask is a separate program
+    auto defines = featureDefines(features_, feature_mask_);
+    if (!include_cache.preprocess(vertex_editor.GetText(), name + ".vert", directory, vertex_source, err, defines)) {
+      vertex_stage.shader.err = err;
       return false;
-    Program program_attempt;
-    program_attempt.attach(vertex_shader);
-    program_attempt.attach(fragment_shader);
-    if (!program_attempt.link())
+    }
+    if (!include_cache.preprocess(fragment_editor.GetText(), name + ".frag", directory, fragment_source, err,
+                                  defines)) {
+      fragment_stage.shader.err = err;
       return false;
-    mesh_.program.destroy();
-    mesh_.program.attach(vertex_shader);
-    mesh_.program.attach(fragment_shader);
-    if (!mesh_.program.link())
-      exit(-1);
+    }
+    auto program_hash = hash_combine(hash_string(vertex_source.code), hash_string(fragment_source.code));
+    if (program_hash == building_program_hash)
+      return true;
+    if (program_hash == linked_program_hash) {
+      // edits went back to the program being rendered
+      building_program.destroy();
+      building_program_hash = 0;
+      compilation_status = "Ok";
+      return true;
+    }
+    ShaderProgram program_attempt;
+    ponos::Timer timer;
+    // programs replaced earlier (other feature masks, undone edits) are still linked
+    program_from_variants = program_variants.take(program_hash, program_attempt);
+    if (program_from_variants || binary_cache.load(program_hash, program_attempt)) {
+      link_ms = timer.tack();
+      program_from_cache = !program_from_variants;
+      vertex_stage.shader.err.clear();
+      fragment_stage.shader.err.clear();
+      // keeps the include dependencies of the cached program
+      vertex_stage.source = std::move(vertex_source);
+      fragment_stage.source = std::move(fragment_source);
+      building_program.destroy();
+      building_program_hash = 0;
+      installProgram(std::move(program_attempt), program_hash);
+      compilation_status = "Ok";
+      return true;
+    }
+    // stages with unchanged sources keep their compiled shader
+    vertex_stage.update(std::move(vertex_source));
+    fragment_stage.update(std::move(fragment_source));
+    building_program.startLink({vertex_stage.shader.id(), fragment_stage.shader.id()});
+    building_program_hash = program_hash;
+    build_timer.tick();
+    compilation_status = "Compiling";
+    return true;
+  }
+
+  /// Installs the program started by buildShader once the driver is done with
+  /// it. Never waits while the driver compiles in parallel.
+  void pollBuild() {
+    if (!building_program_hash || !vertex_stage.shader.ready() || !fragment_stage.shader.ready()
+        || !building_program.linkCompleted())
+      return;
+    const auto program_hash = building_program_hash;
+    building_program_hash = 0;
+    build_ms = build_timer.tack();
+    // both stages report their errors
+    bool compiled = vertex_stage.finish();
+    compiled = fragment_stage.finish() && compiled;
+    if (!building_program.finishLink() || !compiled) {
+      compilation_status = "Err";
+      return;
+    }
+    binary_cache.store(program_hash, building_program);
+    program_from_cache = program_from_variants = false;
+    installProgram(std::move(building_program), program_hash);
+    compilation_status = "Ok";
+  }
+
+  /// Renders with **program** from now on, resolving its uniforms and blocks
+  /// \param program **[in]** successfully linked
+  /// \param program_hash **[in]** hash of its preprocessed sources
+  void installProgram(ShaderProgram program, u64 program_hash) {
+    // the replaced program stays linked for a quick swap back
+    program_variants.put(linked_program_hash, std::move(program_));
+    program_ = std::move(program);
+    linked_program_hash = program_hash;
+    uses_frame_block = frame_block.attach(program_.id());
+    uses_scene_block = scene_block.attach(program_.id());
+    uses_environment_block = environment_block.attach(program_.id());
+    uses_shadow_block = shadow_block.attach(program_.id());
     // reset uniforms
     ordered_uniform_names.clear();
-    const auto &uniforms = mesh_.program.uniforms();
+    uniform_bindings.clear();
+    std::fill(std::begin(reserved_bindings), std::end(reserved_bindings), -1);
+    for (const auto &u : program_.uniforms())
+      for (int i = 0; i < ReservedUniform::COUNT; ++i)
+        if (u.name == reserved_uniform_names[i])
+          reserved_bindings[i] = uniform_bindings.add(u.location, u.type);
+    for (int i = 0; i < 2; ++i)
+      channel_bindings[i] = uniform_bindings.add(program_.locateUniform(ponos::concat("channel", i)), GL_INT);
+    environment_bindings[0] = uniform_bindings.add(program_.locateUniform("environmentMap"), GL_INT);
+    environment_bindings[1] = uniform_bindings.add(program_.locateUniform("brdfLut"), GL_INT);
+    shadow_map_binding = uniform_bindings.add(program_.locateUniform("shadowMap"), GL_INT);
+    const auto &uniforms = program_.uniforms();
     std::unordered_map<std::string, UniformData> vec3_uniform_names_tmp;
     std::vector<vec3> vec3_uniforms_tmp;
     std::unordered_map<std::string, UniformData> f32_uniform_names_tmp;
     std::vector<f32> f32_uniforms_tmp;
+    vec3_bindings.clear();
+    f32_bindings.clear();
     for (const auto &u : uniforms) {
       if (reserved_uniforms.count(u.name))
         continue;
@@ -500,6 +1417,7 @@ public:
       ordered_uniform_names.emplace_back(name);
       if (u.type == GL_FLOAT_VEC3) {
         vec3_uniform_names_tmp[name] = {vec3_uniforms_tmp.size(), u};
+        vec3_bindings.emplace_back(uniform_bindings.add(u.location, u.type));
         if (vec3_uniform_names.count(name))
           vec3_uniforms_tmp.emplace_back(vec3_uniforms[vec3_uniform_names[name].index]);
         else
@@ -507,6 +1425,7 @@ public:
       }
       if (u.type == GL_FLOAT) {
         f32_uniform_names_tmp[name] = {f32_uniforms_tmp.size(), u};
+        f32_bindings.emplace_back(uniform_bindings.add(u.location, u.type));
         if (f32_uniform_names.count(name))
           f32_uniforms_tmp.emplace_back(f32_uniforms[f32_uniform_names[name].index]);
         else
@@ -517,19 +1436,60 @@ public:
     f32_uniform_names = std::move(f32_uniform_names_tmp);
     vec3_uniforms = std::move(vec3_uniforms_tmp);
     f32_uniforms = std::move(f32_uniforms_tmp);
-    return true;
+  }
+
+  /// \return **stats** for the mesh status line
+  static std::string cacheStatsText(const VertexCacheStats &stats) {
+    char text[64];
+    snprintf(text, sizeof(text), "ACMR %.3f ATVR %.3f", stats.acmr, stats.atvr);
+    return text;
+  }
+
+  /// Unit quad on the xz plane, facing up, with the position, normal, uv,
+  /// tangent and bitangent attributes of the shapes. drawFloor scales it
+  /// under the scene.
+  void setupFloor() {
+    const f32 vertices[] = {-1, 0, -1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1,
+                            -1, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1,
+                            1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1,
+                            1, 0, -1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 1};
+    const u32 indices[] = {0, 1, 2, 0, 2, 3};
+    MeshAttribute attributes[5];
+    const char *names[5] = {"position", "normal", "uv", "tangent", "bitangent"};
+    const u32 component_counts[5] = {3, 3, 2, 3, 3};
+    u32 stride = 0;
+    for (int i = 0; i < 5; ++i) {
+      strncpy(attributes[i].name, names[i], sizeof(attributes[i].name) - 1);
+      attributes[i].component_count = component_counts[i];
+      attributes[i].type = GL_FLOAT;
+      attributes[i].offset = stride;
+      stride += component_counts[i] * sizeof(f32);
+    }
+    floor_mesh_.upload(attributes, 5, stride, vertices, sizeof(vertices), indices, 6);
   }
 
   void setupMesh(int mesh_option = 0) {
-    static int last_option = -1;
-    if (last_option != mesh_option) {
+    static const char *mesh_assets[] = {"cube", "suzanne", "teapot", "geosphere", "torusknot"};
+    if (last_mesh_option_ != mesh_option && mesh_option >= 3) {
+      last_mesh_option_ = mesh_option;
+      loadMesh(ponos::concat(MODELS_PATH, "/assets/", mesh_assets[mesh_option - 3], ".obj"));
+      return;
+    }
+    if (last_mesh_option_ != mesh_option && mesh_option == 2) {
+      last_mesh_option_ = mesh_option;
+      generateTerrain();
+      return;
+    }
+    if (last_mesh_option_ != mesh_option) {
+      draw_mesh_ = draw_terrain_ = false;
+      mesh_.transform = ponos::Transform();
       model = circe::Shapes::plane(ponos::Plane::XZ(),
                                    ponos::point3(),
                                    ponos::vec3(1, 0, 0),
                                    1,
                                    circe::shape_options::normal |
                                        circe::shape_options::tangent_space);
-      last_option = mesh_option;
+      last_mesh_option_ = mesh_option;
       ponos::RawMeshSPtr raw_mesh;
       switch (mesh_option) {
       case 0:raw_mesh = ponos::RawMeshes::icosphere(ponos::point3(), 1., 3, true, true);
@@ -545,24 +1505,39 @@ public:
                                          circe::shape_options::tangent_space);
         raw_mesh = ponos::RawMeshes::plane(ponos::Plane::XY(), ponos::point3(), ponos::vec3(1, 0, 0), 1);
         break;
-      case 2:raw_mesh = ponos::RawMeshes::plane(ponos::Plane::XZ(), ponos::point3(), ponos::vec3(1, 0, 0), 20);
-        for (int i = 0; i <= 20; ++i)
-          for (int j = 0; j <= 20; ++j)
-            raw_mesh->positions[i * 21 * 3 + j * 3 + 1] = ponos::Perlin::at(ponos::point2(i, j) * 0.05);
-        break;
       default: break;
       }
       // prepare mesh data
       std::vector<float> vertex_data;
       std::vector<u32> index_data;
       circe::gl::setup_buffer_data_from_mesh(*raw_mesh, vertex_data, index_data);
+      const bool has_normals = raw_mesh->normalDescriptor.count, has_uvs = raw_mesh->texcoordDescriptor.count;
+      // attribute i goes to location i, tangents need the uv before them
+      const bool has_tangents = has_normals && has_uvs;
+      u32 vertex_stride = 3 + (has_normals ? 3 : 0) + (has_uvs ? 2 : 0);
+      if (optimize_shapes_) {
+        auto report = optimizeMesh(vertex_data, vertex_stride, index_data);
+        mesh_status = "vertex cache " + cacheStatsText(report.before) + " -> " + cacheStatsText(report.after);
+      } else
+        mesh_status = "vertex cache " + cacheStatsText(analyzeVertexCache(index_data.data(), index_data.size(),
+                                                                          vertex_data.size() / vertex_stride));
+      // tangent frames for normal mapping (locations 3 and 4)
+      if (has_tangents) {
+        vertex_data = addTangentFrames(vertex_data.data(), vertex_data.size() / vertex_stride, vertex_stride, 3, 6,
+                                       index_data.data(), index_data.size());
+        vertex_stride += 6;
+      }
       mesh_.vb.attributes = circe::gl::VertexBuffer::Attributes();
       // describe vertex buffer
       mesh_.vb.attributes.push<ponos::point3>("position");
-      if (raw_mesh->normalDescriptor.count)
+      if (has_normals)
         mesh_.vb.attributes.push<ponos::vec3>("normal");
-      if (raw_mesh->texcoordDescriptor.count)
+      if (has_uvs)
         mesh_.vb.attributes.push<ponos::point2>("uv");
+      if (has_tangents) {
+        mesh_.vb.attributes.push<ponos::vec3>("tangent");
+        mesh_.vb.attributes.push<ponos::vec3>("bitangent");
+      }
       // upload data
       mesh_.vb = vertex_data;
       mesh_.ib = index_data;
@@ -570,27 +1545,410 @@ public:
       // bind attributes
       mesh_.vao.bind();
       mesh_.vb.bindAttributeFormats();
+      // same data for instanced and compact draws, attribute i at location i
+      MeshAttribute attributes[5];
+      u32 attribute_count = 0, stride = 0;
+      auto add_attribute = [&](const char *name, u32 component_count) {
+        auto &attribute = attributes[attribute_count++];
+        strncpy(attribute.name, name, sizeof(attribute.name) - 1);
+        attribute.component_count = component_count;
+        attribute.type = GL_FLOAT;
+        attribute.offset = stride;
+        stride += component_count * sizeof(f32);
+      };
+      add_attribute("position", 3);
+      if (has_normals)
+        add_attribute("normal", 3);
+      if (has_uvs)
+        add_attribute("uv", 2);
+      if (has_tangents) {
+        add_attribute("tangent", 3);
+        add_attribute("bitangent", 3);
+      }
+      PackedVertices packed;
+      std::string err;
+      if (!packVertices(vertex_data.data(), vertex_data.size() / vertex_stride, attributes, attribute_count, stride,
+                        vertex_format_, packed, err)) {
+        mesh_status += "\n" + err;
+        return;
+      }
+      shape_mesh_.upload(packed.attributes, packed.attribute_count, packed.stride, packed.data.data(),
+                         packed.data.size(), index_data.data(), index_data.size());
+      mesh_dequantization_ = packed.dequantization;
+      mesh_status += ponos::concat("\n", packed.stride, " bytes per vertex");
+      buildLods(shape_mesh_, vertex_data.data(), vertex_data.size() / vertex_stride, vertex_stride,
+                index_data.data(), index_data.size());
+      for (int d = 0; d < 3; ++d) {
+        lod_bounds_[d] = lod_bounds_[d + 3] = vertex_data.empty() ? 0 : vertex_data[d];
+        for (size_t v = 0; v < vertex_data.size(); v += vertex_stride) {
+          lod_bounds_[d] = std::min(lod_bounds_[d], vertex_data[v + d]);
+          lod_bounds_[d + 3] = std::max(lod_bounds_[d + 3], vertex_data[v + d]);
+        }
+      }
     }
   }
 
+  /// Simplifies a copy of the mesh on the thread pool. The chain replaces the
+  /// index buffer of **mesh** in updateLods, unless another mesh was set up
+  /// in the meantime.
+  void buildLods(GpuMesh &mesh, const f32 *vertices, size_t vertex_count, u32 vertex_stride, const u32 *indices,
+                 size_t index_count) {
+    auto chain = std::make_shared<LodChain>();
+    lod_job_.chain = chain;
+    lod_job_.mesh = &mesh;
+    lod_status_ = "building LODs...";
+    lod_job_.done = ThreadPool::global().submit(
+        [chain, vertex_stride, vertex_data = std::vector<f32>(vertices, vertices + vertex_count * vertex_stride),
+            index_data = std::vector<u32>(indices, indices + index_count)] {
+          *chain = buildLodChain(index_data.data(), index_data.size(), vertex_data.data(),
+                                 vertex_data.size() / vertex_stride, vertex_stride);
+        });
+  }
+
+  /// Uploads the LOD chain once the background job is done
+  void updateLods() {
+    if (!lod_job_.done.valid() || lod_job_.done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return;
+    lod_job_.done.get();
+    const auto &chain = *lod_job_.chain;
+    lod_job_.mesh->uploadLods(chain);
+    if (chain.lods.size() > 1)
+      lod_status_ = ponos::concat(chain.lods.size(), " LODs, down to ", chain.lods.back().count / 3,
+                                  " triangles (", static_cast<int>(chain.ms), " ms)");
+    else
+      lod_status_ = "no LODs, too few triangles";
+    lod_job_.chain.reset();
+  }
+
+  /// \return the forced level, or the coarsest one whose error stays under
+  /// lod_error_pixels_ for the projected size of the object
+  u32 selectMeshLod(const GpuMesh &mesh, circe::CameraInterface *camera) const {
+    if (mesh.lods().size() < 2)
+      return 0;
+    if (lod_override_ >= 0)
+      return std::min(static_cast<u32>(lod_override_), static_cast<u32>(mesh.lods().size() - 1));
+    // bounding sphere of the object, the object transform scales uniformly
+    const auto model = objectTransform().matrix();
+    f32 center[4] = {0, 0, 0, 1}, extent = 0;
+    for (int d = 0; d < 3; ++d) {
+      center[d] = (lod_bounds_[d] + lod_bounds_[d + 3]) * 0.5f;
+      extent = std::max(extent, lod_bounds_[d + 3] - lod_bounds_[d]);
+    }
+    const f32 scale = std::sqrt(model.m[0][0] * model.m[0][0] + model.m[1][0] * model.m[1][0]
+                                    + model.m[2][0] * model.m[2][0]);
+    const f32 radius = 0.5f * std::sqrt(3.f) * extent * scale;
+    // depth of the center (clip w) and vertical scale of the projection
+    const auto mvp = (camera->getProjectionTransform() * camera->getViewTransform() * objectTransform()).matrix();
+    f32 w = 0;
+    for (int j = 0; j < 4; ++j)
+      w += mvp.m[3][j] * center[j];
+    if (w <= radius)
+      return 0;
+    const f32 projection_scale = camera->getProjectionTransform().matrix().m[1][1];
+    const f32 screen_size = radius * projection_scale / w * this->app_->viewports[0].height;
+    return selectLod(mesh.lods(), screen_size, lod_error_pixels_);
+  }
+
+  /// \return true if copies of the current mesh are drawn instead of one object
+  [[nodiscard]] bool instancing() const { return instancing_ && !draw_terrain_; }
+
+  /// \return true if the object casts shadows onto a floor (the terrain does not)
+  [[nodiscard]] bool shadows() const { return shadows_ && !draw_terrain_; }
+
+  /// \return model transform of the object, spun around y while recording a turntable
+  [[nodiscard]] ponos::Transform objectTransform() const {
+    if (!recording_ || !turntable_)
+      return mesh_.transform;
+    return ponos::rotateY(360.f * static_cast<f32>(record_frame_) / static_cast<f32>(turntable_frames_))
+        * mesh_.transform;
+  }
+
+  /// Regenerates the instance buffer when its parameters changed. The
+  /// instances are computed by the thread pool.
+  void updateInstances() {
+    if (!instancing())
+      return;
+    instance_params_.count = static_cast<u32>(instance_count_);
+    if (instance_buffer_.count() && instance_params_ == generated_instance_params_)
+      return;
+    ponos::Timer timer;
+    generateInstances(instance_params_, instances_);
+    instance_buffer_.upload(instances_);
+    instance_generation_ms_ = timer.tack();
+    generated_instance_params_ = instance_params_;
+  }
+
+  /// Restarts the chunked terrain with the current parameters. Chunks are
+  /// generated in the background as the camera asks for them.
+  void generateTerrain() {
+    terrain_params_.resolution = 256u << terrain_resolution_;
+    terrain_params_.octaves = static_cast<u32>(terrain_octaves_);
+    terrain_renderer_.setup(terrain_params_);
+    mesh_.transform = ponos::Transform();
+    draw_mesh_ = false;
+    draw_terrain_ = true;
+    const u32 resolution = terrain_renderer_.params().resolution;
+    const u32 chunks = resolution / TerrainRenderer::chunk_size;
+    mesh_status = ponos::concat(resolution, "x", resolution, " terrain: ", chunks, "x", chunks, " chunks of ",
+                                TerrainRenderer::chunk_size, "x", TerrainRenderer::chunk_size, " quads");
+  }
+
+  /// Reads the precomputed lighting of an equirectangular .hdr from the
+  /// cache, computing it on the global pool on a miss, off the render thread.
+  /// The current environment stays bound until updateEnvironment uploads the
+  /// new one.
+  void loadEnvironment(const std::string &path) {
+    auto &job = environment_job_;
+    job.requested = path;
+    environment_status_ = "loading " + std::filesystem::path(path).filename().string() + "...";
+    // replacing a running std::async future would wait for it
+    if (job.done.valid())
+      return;
+    auto result = std::make_shared<EnvironmentResult>();
+    job.result = result;
+    job.path = path;
+    job.timer.tick();
+    // a thread of its own rather than a pool job: a miss runs
+    // precomputeEnvironment, whose parallelFor must not be called from a job
+    job.done = std::async(std::launch::async, [cache = &environment_cache, path, result] {
+      u32 misses = cache->misses;
+      result->ok = cache->load(path, result->environment, result->err, ThreadPool::global());
+      result->cached = cache->misses == misses;
+    });
+  }
+
+  /// Uploads the environment once its job is done, or starts the one
+  /// requested while it was running
+  void updateEnvironment() {
+    auto &job = environment_job_;
+    if (!job.done.valid() || job.done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return;
+    job.done.get();
+    auto result = std::exchange(job.result, nullptr);
+    if (job.requested != job.path) {
+      loadEnvironment(job.requested);
+      return;
+    }
+    if (!result->ok) {
+      environment_status_ = result->err;
+      return;
+    }
+    const auto &environment = result->environment;
+    environment_map_.upload(environment);
+    environment_path_ = job.path;
+    environment_status_ = ponos::concat(std::filesystem::path(job.path).filename().string(), "\n",
+                                        environment.specular_size, "px, ", environment.specular_levels, " levels (",
+                                        static_cast<int>(job.timer.tack()), " ms",
+                                        result->cached ? ", cached)" : ")");
+  }
+
+  /// Loads an OBJ through its binary cache (foo.obj -> foo.mesh), which is
+  /// (re)generated whenever it is missing or older than the source. Compact
+  /// vertex formats are packed from the mapping before the upload.
+  bool loadMesh(const std::string &path) {
+    ponos::Timer timer;
+    MeshFile file;
+    bool from_cache = false;
+    std::string cache_warning;
+    if (!openMeshCached(path, file, mesh_status, &from_cache, &cache_warning))
+      return false;
+    const auto &header = file.header();
+    PackedVertices packed;
+    if (vertex_format_ == VertexFormat::FLOAT) {
+      // vertex and index data go from the mapping straight to the GPU
+      imported_mesh_.upload(file);
+      packed.stride = header.vertex_stride;
+    } else {
+      if (!packVertices(file.vertexData(), header.vertex_count, header.attributes, header.attribute_count,
+                        header.vertex_stride, vertex_format_, packed, mesh_status))
+        return false;
+      imported_mesh_.upload(packed.attributes, packed.attribute_count, packed.stride, packed.data.data(),
+                            packed.data.size(), file.indexData(), header.index_count);
+    }
+    mesh_dequantization_ = packed.dequantization;
+    mesh_path_ = path;
+    buildLods(imported_mesh_, static_cast<const f32 *>(file.vertexData()), header.vertex_count,
+              header.vertex_stride / static_cast<u32>(sizeof(f32)), file.indexData(), header.index_count);
+    for (int d = 0; d < 3; ++d) {
+      lod_bounds_[d] = header.bounds_min[d];
+      lod_bounds_[d + 3] = header.bounds_max[d];
+    }
+    draw_terrain_ = false;
+    // fit the mesh into the unit cube at the origin
+    f32 extent = 0;
+    ponos::vec3 center;
+    for (int d = 0; d < 3; ++d) {
+      extent = std::max(extent, header.bounds_max[d] - header.bounds_min[d]);
+      center[d] = (header.bounds_max[d] + header.bounds_min[d]) * 0.5f;
+    }
+    f32 s = extent > 0 ? 2 / extent : 1;
+    mesh_.transform = ponos::scale(s, s, s) * ponos::translate(-center);
+    draw_mesh_ = true;
+    mesh_status = ponos::concat(header.vertex_count, " vertices ", header.index_count / 3, " triangles (",
+                                static_cast<int>(timer.tack()), " ms", from_cache ? ", cached)" : ")");
+    // imported meshes are optimized when their cache is written
+    mesh_status += "\nvertex cache " + cacheStatsText(analyzeVertexCache(file.indexData(), header.index_count,
+                                                                         header.vertex_count));
+    mesh_status += ponos::concat("\n", packed.stride, " bytes per vertex");
+    if (!cache_warning.empty())
+      mesh_status += "\n" + cache_warning;
+    return true;
+  }
+
   // Textures
+  TextureCache texture_cache{CACHE_PATH "/textures"};
+  TextureStreamer texture_streamer;
   TextureUnit texture_views[2];
   bool show_texture_views[2]{false, false};
+  // image based lighting
+  EnvironmentCache environment_cache{CACHE_PATH "/environments"};
+  EnvironmentMap environment_map_;
+  std::string environment_path_; //!< of environment_map_
+  struct EnvironmentResult {
+    Environment environment;
+    std::string err;
+    bool ok{false};
+    bool cached{false};
+  };
+  struct EnvironmentJob {
+    std::future<void> done;
+    std::shared_ptr<EnvironmentResult> result;
+    std::string path;      //!< being loaded
+    std::string requested; //!< last path asked for
+    ponos::Timer timer;
+  };
+  EnvironmentJob environment_job_; //!< after environment_cache, its destruction waits for the job
+  std::string environment_status_;
+  bool environment_enabled_{true};
+  f32 environment_intensity_{1};
+  // shadows of the directional light
+  bool shadows_{false};
+  ShadowParams shadow_params_;
+  int shadow_resolution_{1}; //!< 512 << shadow_resolution_ texels per cascade
+  f32 shadow_bias_{0.0005f};
+  ShadowMap shadow_map_;
+  ShadowCascade shadow_cascades_[max_shadow_cascades];
+  u32 shadow_cascade_count_{0};
+  GpuMesh floor_mesh_; //!< receives the shadows, see drawFloor
+  std::string shadow_status_;
+  // frame capture, read back a few frames late and encoded on the thread pool
+  FrameCapture frame_capture_;
+  bool screenshot_requested_{false};
+  u32 screenshot_count_{0};
+  bool recording_{false};
+  bool turntable_{false};     //!< a recording spins the object once and stops
+  int turntable_frames_{120}; //!< frames per turn
+  u32 record_frame_{0};
+  std::string sequence_path_; //!< directory of the current recording
+  u32 sequence_count_{0};
+  std::string capture_status_;
   // gui
   ponos::Path config_path;
   bool show_vertex_editor{true}, show_fragment_editor{true};
   TextEditor vertex_editor, fragment_editor;
+  StageFile vertex_file, fragment_file;
   // scene
   Light light;
   Material material;
   // object
   Model mesh_;
+  GpuMesh imported_mesh_;
+  GpuMesh shape_mesh_; //!< sphere/plane, for instanced draws
+  int last_mesh_option_{-1};
+  bool optimize_shapes_{true}; //!< reorder sphere/plane for the vertex cache
+  int vertex_format_{VertexFormat::FLOAT};
+  VertexDequantization mesh_dequantization_; //!< of the sphere/plane or imported mesh being drawn
+  std::string mesh_path_;                    //!< imported mesh
+  // levels of detail
+  struct LodJob {
+    std::future<void> done;
+    std::shared_ptr<LodChain> chain;
+    GpuMesh *mesh{nullptr};
+  };
+  LodJob lod_job_;
+  f32 lod_bounds_[6]{}; //!< object space min, max of the sphere/plane or imported mesh
+  int lod_override_{-1}; //!< -1 picks the level from the screen size
+  f32 lod_error_pixels_{1};
+  u32 current_lod_{0};
+  std::string lod_status_;
+  // instancing
+  bool instancing_{false};
+  int instance_count_{1000};
+  InstanceParams instance_params_;
+  InstanceParams generated_instance_params_; //!< content of instance_buffer_
+  std::vector<InstanceData> instances_;
+  InstanceBuffer instance_buffer_;
+  f64 instance_generation_ms_{0};
+  bool draw_mesh_{false};
+  int mesh_option_{0};
+  TerrainRenderer terrain_renderer_;
+  bool draw_terrain_{false};
+  TerrainParams terrain_params_;
+  int terrain_resolution_{0}; //!< 256 << terrain_resolution_ samples per side
+  int terrain_octaves_{6};
+  std::string mesh_status;
   circe::gl::SceneModel model;
   // shader
-  Shader vertex_shader;
-  Shader fragment_shader;
+  ShaderProgram program_;
+  ProgramBinaryCache binary_cache{CACHE_PATH "/programs"};
+  bool program_from_cache{false};
+  ProgramVariants program_variants{16};
+  bool program_from_variants{false};
+  std::vector<ShaderFeature> features_; //!< of the config
+  u32 feature_mask_{0};                 //!< bit i enables features_[i]
+  ShaderStage vertex_stage{GL_VERTEX_SHADER};
+  ShaderStage fragment_stage{GL_FRAGMENT_SHADER};
+  ShaderRebuildScheduler rebuild_scheduler;
+  ShaderIncludeCache include_cache;
+  ponos::Timer include_poll_timer;
+  f64 include_poll_ms{500}; //!< without file watcher
+  FileWatcher file_watcher;
+  std::string reload_status;
+  u64 linked_program_hash{0};
+  f64 link_ms{0}; //!< of the cached binary
+  ShaderProgram building_program; //!< replaces program_ once the driver is done with it
+  u64 building_program_hash{0};   //!< 0 when no build is running
+  ponos::Timer build_timer;
+  f64 build_ms{0}; //!< from buildShader until the program was found ready
+  std::string compilation_status;
+  // profiling
+  struct ProfileSection {
+    enum : u32 { FRAME = 0, UI, REBUILD, TEXTURES, UNIFORMS, SHADOWS, DRAW, CAPTURE, COUNT };
+  };
+  Profiler profiler{{"frame", "ui", "rebuild", "textures", "uniforms", "shadows", "draw", "capture"}};
+  bool show_profiler{false};
+  std::string profiler_status;
+  u32 trace_count{0};
   // reserved uniforms
+  struct ReservedUniform {
+    enum : int {
+      MODEL = 0, VIEW, PROJECTION, CAMERA_POSITION, SCREEN_RESOLUTION, TIME, INSTANCE_COUNT,
+      POSITION_SCALE, POSITION_OFFSET, NORMAL_ENCODING, COUNT
+    };
+  };
+  static constexpr const char *reserved_uniform_names[ReservedUniform::COUNT] = {
+      "model", "view", "projection", "cameraPosition", "screenResolution", "time", "instanceCount",
+      "positionScale", "positionOffset", "normalEncoding"};
   std::set<std::string> reserved_uniforms;
+  // uniform locations resolved at link time, indices into uniform_bindings
+  UniformBindingTable uniform_bindings;
+  int reserved_bindings[ReservedUniform::COUNT]{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+  int channel_bindings[2]{-1, -1};
+  int environment_bindings[2]{-1, -1}; //!< environmentMap, brdfLut
+  int shadow_map_binding{-1};
+  std::vector<int> vec3_bindings;
+  std::vector<int> f32_bindings;
+  u32 uniform_call_count{0};
+  // std140 blocks, used when the program declares them
+  UniformBlockBuffer frame_block{"FrameBlock", 0, sizeof(FrameBlockData)};
+  UniformBlockBuffer scene_block{"SceneBlock", 1, sizeof(SceneBlockData)};
+  UniformBlockBuffer environment_block{"EnvironmentBlock", 2, sizeof(EnvironmentBlockData)};
+  UniformBlockBuffer shadow_block{"ShadowBlock", 3, sizeof(ShadowBlockData)};
+  bool uses_frame_block{false};
+  bool uses_scene_block{false};
+  bool uses_environment_block{false};
+  bool uses_shadow_block{false};
+  ponos::Timer clock;
   // uniforms
   std::vector<std::string> ordered_uniform_names;
   // name, {id, array_size}
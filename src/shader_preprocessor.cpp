@@ -0,0 +1,200 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shader_preprocessor.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "shader_preprocessor.h"
+#include "hash.h"
+
+#include <algorithm>
+#include <fstream>
+#include <regex>
+#include <set>
+#include <sstream>
+
+namespace {
+
+/// \return false if the file could not be read
+bool readText(const std::filesystem::path &path, std::string &text) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    return false;
+  std::stringstream ss;
+  ss << in.rdbuf();
+  text = ss.str();
+  return true;
+}
+
+/// \param line **[in]**
+/// \param path **[out]** quoted path of the directive
+/// \return true if **line** is an #include "path" directive
+bool parseInclude(const std::string &line, std::string &path) {
+  static const std::regex include(R"(^\s*#\s*include\s+"([^"]+)\")");
+  auto first = line.find_first_not_of(" \t");
+  if (first == std::string::npos || line[first] != '#')
+    return false;
+  std::smatch match;
+  if (!std::regex_search(line, match, include))
+    return false;
+  path = match[1];
+  return true;
+}
+
+}
+
+struct ShaderIncludeCache::Context {
+  PreprocessedSource &output;
+  std::filesystem::path root_directory;
+  std::vector<std::string> stack; //!< files being expanded, to detect cycles
+  std::set<std::string> included;
+  bool version_found{false};
+  const std::string &defines;
+};
+
+bool PreprocessedSource::dependsOn(const std::vector<std::string> &paths) const {
+  for (const auto &path : paths)
+    if (std::find(dependencies.begin(), dependencies.end(), path) != dependencies.end())
+      return true;
+  return false;
+}
+
+std::string PreprocessedSource::mapLog(const std::string &log) const {
+  // Mesa "0:12(3): error", NVIDIA "0(12) : error", AMD/Intel "ERROR: 0:12: ..."
+  static const std::regex location(R"(^((?:ERROR|WARNING): )?(\d+)([:(]\d+))");
+  std::string mapped;
+  std::istringstream in(log);
+  std::string line;
+  while (std::getline(in, line)) {
+    std::smatch match;
+    if (std::regex_search(line, match, location)) {
+      auto index = std::stoul(match[2]);
+      if (index < files.size())
+        line = match[1].str() + files[index] + match[3].str() + match.suffix().str();
+    }
+    mapped += line + "\n";
+  }
+  return mapped;
+}
+
+bool ShaderIncludeCache::preprocess(const std::string &source, const std::string &name, const std::string &directory,
+                                    PreprocessedSource &output, std::string &err, const std::string &defines) {
+  output = PreprocessedSource();
+  output.files.emplace_back(name);
+  output.code.reserve(source.size() + defines.size());
+  Context context{output, std::filesystem::weakly_canonical(directory), {}, {}, false, defines};
+  return expand(source, 0, context.root_directory, context, err);
+}
+
+std::vector<std::string> ShaderIncludeCache::poll() {
+  std::vector<std::string> changed;
+  for (auto it = files_.begin(); it != files_.end();) {
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(it->first, ec);
+    std::string text;
+    if (ec || (mtime != it->second.mtime && !readText(it->first, text))) {
+      changed.emplace_back(it->first);
+      it = files_.erase(it);
+      continue;
+    }
+    if (mtime != it->second.mtime) {
+      // touched files keep their compiled shaders
+      auto hash = hash_string(text);
+      if (hash != it->second.hash)
+        changed.emplace_back(it->first);
+      it->second = {std::move(text), hash, mtime};
+    }
+    ++it;
+  }
+  return changed;
+}
+
+const ShaderIncludeCache::File *ShaderIncludeCache::load(const std::filesystem::path &path) {
+  auto it = files_.find(path.string());
+  if (it != files_.end())
+    return &it->second;
+  File file;
+  std::error_code ec;
+  file.mtime = std::filesystem::last_write_time(path, ec);
+  if (ec || !readText(path, file.text))
+    return nullptr;
+  file.hash = hash_string(file.text);
+  return &(files_[path.string()] = std::move(file));
+}
+
+bool ShaderIncludeCache::expand(const std::string &text, u32 file_index, const std::filesystem::path &directory,
+                                Context &context, std::string &err) {
+  auto &output = context.output;
+  u32 line_number = 0;
+  for (size_t begin = 0; begin < text.size();) {
+    auto end = text.find('\n', begin);
+    if (end == std::string::npos)
+      end = text.size();
+    std::string line = text.substr(begin, end - begin);
+    begin = end + 1;
+    line_number++;
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    std::string include;
+    if (!parseInclude(line, include)) {
+      output.code += line + "\n";
+      // #defines and #line can only come after #version
+      if (!context.version_found && line.find("#version") != std::string::npos) {
+        context.version_found = true;
+        output.code += context.defines;
+        output.code += ponos::concat("#line ", line_number + 1, " ", file_index, "\n");
+      }
+      continue;
+    }
+    auto location = ponos::concat(output.files[file_index], ":", line_number, ": ");
+    auto path = std::filesystem::weakly_canonical(directory / include);
+    auto key = path.string();
+    if (std::find(context.stack.begin(), context.stack.end(), key) != context.stack.end()) {
+      err = location + "recursive include of \"" + include + "\"";
+      return false;
+    }
+    if (context.included.count(key)) {
+      // already expanded in this source, keep line numbers
+      output.code += "\n";
+      continue;
+    }
+    const File *file = load(path);
+    if (!file) {
+      err = location + "could not open include \"" + include + "\"";
+      return false;
+    }
+    auto name = path.lexically_relative(context.root_directory).string();
+    auto index = static_cast<u32>(output.files.size());
+    output.files.emplace_back(name.empty() ? key : name);
+    output.dependencies.emplace_back(key);
+    context.included.insert(key);
+    context.stack.emplace_back(key);
+    output.code += ponos::concat("#line 1 ", index, "\n");
+    if (!expand(file->text, index, path.parent_path(), context, err))
+      return false;
+    context.stack.pop_back();
+    output.code += ponos::concat("#line ", line_number + 1, " ", file_index, "\n");
+  }
+  return true;
+}
@@ -0,0 +1,100 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shader_preprocessor.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief GLSL #include expansion with cached include files.
+
+#ifndef GLSL_EXPERIMENTS_SHADER_PREPROCESSOR_H
+#define GLSL_EXPERIMENTS_SHADER_PREPROCESSOR_H
+
+#include <ponos/ponos.h>
+#include <filesystem>
+#include <unordered_map>
+
+/// Stage source with its #include directives expanded.
+struct PreprocessedSource {
+  /// \param paths **[in]** files, as returned by ShaderIncludeCache::poll()
+  /// \return true if any of **paths** was included by this source
+  [[nodiscard]] bool dependsOn(const std::vector<std::string> &paths) const;
+  /// Replaces the source string numbers of compiler messages by file names,
+  /// ex: "2:14(3): error" -> "include/scene.glsl:14(3): error".
+  /// \param log **[in]** shader info log
+  /// \return log referring to the original files
+  [[nodiscard]] std::string mapLog(const std::string &log) const;
+  std::string code;
+  /// names used in messages, indexed by the source string number of the #line
+  /// directives, files[0] is the root source
+  std::vector<std::string> files;
+  std::vector<std::string> dependencies; //!< absolute paths of the included files
+};
+
+/// Expands #include "file" directives of GLSL sources. Included paths are
+/// relative to the including file (the given directory for the root source),
+/// files are included once per source and #line directives keep compiler
+/// messages pointing to the original lines.
+///
+/// The cache keeps the content, modification time and content hash of every
+/// file it read, so poll() can tell which headers really changed and only
+/// the sources that include them need to be recompiled.
+///
+/// Usage:
+///   ShaderIncludeCache includes;
+///   PreprocessedSource vs;
+///   if (!includes.preprocess(source, "foo.vert", "shaders/foo", vs, err)) ...
+///   shader.compile(vs.code, GL_VERTEX_SHADER);
+///   // later
+///   if (vs.dependsOn(includes.poll())) ... recompile
+/// \note not thread safe, use one cache per thread
+class ShaderIncludeCache {
+public:
+  /// \param source **[in]** root source code
+  /// \param name **[in]** root name for messages
+  /// \param directory **[in]** where includes of the root source are searched
+  /// \param output **[out]**
+  /// \param err **[out]** file and line of the failing directive
+  /// \param defines **[in | optional]** lines inserted right after #version (ex: feature #defines)
+  /// \return false if an include is missing or recursive
+  bool preprocess(const std::string &source, const std::string &name, const std::string &directory,
+                  PreprocessedSource &output, std::string &err, const std::string &defines = "");
+  /// Checks the cached files on disk. Files whose modification time changed
+  /// are read again, but only reported if their content changed.
+  /// \return absolute paths of the changed (or removed) files
+  std::vector<std::string> poll();
+  void clear() { files_.clear(); }
+
+private:
+  struct File {
+    std::string text;
+    u64 hash{0};
+    std::filesystem::file_time_type mtime;
+  };
+  struct Context;
+  const File *load(const std::filesystem::path &path);
+  bool expand(const std::string &text, u32 file_index, const std::filesystem::path &directory, Context &context,
+              std::string &err);
+
+  std::unordered_map<std::string, File> files_; //!< by absolute path
+};
+
+#endif //GLSL_EXPERIMENTS_SHADER_PREPROCESSOR_H
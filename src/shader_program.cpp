@@ -0,0 +1,187 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shader_program.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "shader_program.h"
+#include "async_shader.h"
+
+ShaderProgram::ShaderProgram(ShaderProgram &&other) noexcept {
+  *this = std::move(other);
+}
+
+ShaderProgram::~ShaderProgram() {
+  destroy();
+}
+
+ShaderProgram &ShaderProgram::operator=(ShaderProgram &&other) noexcept {
+  if (this != &other) {
+    destroy();
+    id_ = other.id_;
+    other.id_ = 0;
+    err = std::move(other.err);
+    uniforms_ = std::move(other.uniforms_);
+    uniform_locations_ = std::move(other.uniform_locations_);
+  }
+  return *this;
+}
+
+bool ShaderProgram::link(const std::vector<const circe::gl::Shader *> &shaders) {
+  std::vector<GLuint> ids;
+  for (const auto *shader : shaders)
+    ids.emplace_back(shader->id());
+  startLink(ids);
+  return finishLink();
+}
+
+void ShaderProgram::startLink(const std::vector<GLuint> &shaders) {
+  destroy();
+  id_ = glCreateProgram();
+  // allows the program cache to retrieve the binary afterwards
+  glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  for (auto shader : shaders)
+    glAttachShader(id_, shader);
+  glLinkProgram(id_);
+  // the program keeps its executable, shaders can be deleted or recompiled
+  for (auto shader : shaders)
+    glDetachShader(id_, shader);
+}
+
+bool ShaderProgram::linkCompleted() const {
+  return compileCompleted(id_, true);
+}
+
+bool ShaderProgram::finishLink() {
+  return checkLinkStatus();
+}
+
+bool ShaderProgram::link(GLenum format, const std::vector<u8> &data) {
+  destroy();
+  id_ = glCreateProgram();
+  glProgramBinary(id_, format, data.data(), static_cast<GLsizei>(data.size()));
+  return checkLinkStatus();
+}
+
+bool ShaderProgram::binary(GLenum &format, std::vector<u8> &data) const {
+  GLint size = 0;
+  glGetProgramiv(id_, GL_PROGRAM_BINARY_LENGTH, &size);
+  if (size <= 0)
+    return false;
+  data.resize(size);
+  GLsizei written = 0;
+  glGetProgramBinary(id_, size, &written, &format, data.data());
+  data.resize(written);
+  return written > 0;
+}
+
+void ShaderProgram::destroy() {
+  if (id_)
+    glDeleteProgram(id_);
+  id_ = 0;
+  uniforms_.clear();
+  uniform_locations_.clear();
+}
+
+void ShaderProgram::use() const {
+  glUseProgram(id_);
+}
+
+bool ShaderProgram::hasUniform(const std::string &name) const {
+  return uniform_locations_.count(name);
+}
+
+GLint ShaderProgram::locateUniform(const std::string &name) const {
+  auto it = uniform_locations_.find(name);
+  if (it == uniform_locations_.end())
+    return -1;
+  return it->second;
+}
+
+void ShaderProgram::setUniform(const std::string &name, int value) const {
+  glUniform1i(locateUniform(name), value);
+}
+
+void ShaderProgram::setUniform(const std::string &name, f32 value) const {
+  glUniform1f(locateUniform(name), value);
+}
+
+void ShaderProgram::setUniform(const std::string &name, const ponos::vec2 &value) const {
+  glUniform2f(locateUniform(name), value.x, value.y);
+}
+
+void ShaderProgram::setUniform(const std::string &name, const ponos::vec3 &value) const {
+  glUniform3f(locateUniform(name), value.x, value.y, value.z);
+}
+
+void ShaderProgram::setUniform(const std::string &name, const ponos::point3 &value) const {
+  glUniform3f(locateUniform(name), value.x, value.y, value.z);
+}
+
+void ShaderProgram::setUniform(const std::string &name, const ponos::mat4 &value) const {
+  // matrices are expected already transposed to column-major order
+  f32 m[16];
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      m[i * 4 + j] = value.m[i][j];
+  glUniformMatrix4fv(locateUniform(name), 1, GL_FALSE, m);
+}
+
+bool ShaderProgram::checkLinkStatus() {
+  GLint linked = GL_FALSE;
+  glGetProgramiv(id_, GL_LINK_STATUS, &linked);
+  if (linked != GL_TRUE) {
+    GLint length = 0;
+    glGetProgramiv(id_, GL_INFO_LOG_LENGTH, &length);
+    err.resize(length);
+    if (length)
+      glGetProgramInfoLog(id_, length, nullptr, &err[0]);
+    destroy();
+    return false;
+  }
+  err.clear();
+  introspect();
+  return true;
+}
+
+void ShaderProgram::introspect() {
+  uniforms_.clear();
+  uniform_locations_.clear();
+  GLint count = 0, max_length = 0;
+  glGetProgramiv(id_, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(id_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+  std::vector<GLchar> name(max_length + 1);
+  for (GLint i = 0; i < count; ++i) {
+    Uniform u;
+    GLsizei length = 0;
+    glGetActiveUniform(id_, i, max_length, &length, &u.array_size, &u.type, name.data());
+    u.name.assign(name.data(), length);
+    u.location = glGetUniformLocation(id_, u.name.c_str());
+    // uniforms inside blocks have no location
+    if (u.location < 0)
+      continue;
+    uniform_locations_[u.name] = u.location;
+    uniforms_.emplace_back(u);
+  }
+}
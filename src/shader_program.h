@@ -0,0 +1,95 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shader_program.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief GL program object owned by the editor.
+
+#ifndef GLSL_EXPERIMENTS_SHADER_PROGRAM_H
+#define GLSL_EXPERIMENTS_SHADER_PROGRAM_H
+
+#include <circe/circe.h>
+#include <unordered_map>
+
+/// Linked GL program. Unlike circe::gl::Program, it can be created from a
+/// program binary and hands its binary back, which the program cache needs.
+class ShaderProgram {
+public:
+  struct Uniform {
+    std::string name;
+    GLint location{-1};
+    GLenum type{0};
+    GLint array_size{0};
+  };
+  ShaderProgram() = default;
+  ShaderProgram(const ShaderProgram &) = delete;
+  ShaderProgram(ShaderProgram &&other) noexcept;
+  ~ShaderProgram();
+  ShaderProgram &operator=(const ShaderProgram &) = delete;
+  ShaderProgram &operator=(ShaderProgram &&other) noexcept;
+  /// \param shaders **[in]** compiled stages
+  /// \return true if linkage succeeded (**err** holds the log otherwise)
+  bool link(const std::vector<const circe::gl::Shader *> &shaders);
+  /// Issues the link without waiting for the driver (see AsyncShader), the
+  /// program becomes usable after finishLink.
+  /// \param shaders **[in]** shader objects, possibly still compiling
+  void startLink(const std::vector<GLuint> &shaders);
+  /// \return true if finishLink will not block
+  [[nodiscard]] bool linkCompleted() const;
+  /// Waits for the link issued by startLink if it is still running.
+  /// \return true if linkage succeeded (**err** holds the log otherwise)
+  bool finishLink();
+  /// \param format **[in]** binary format returned by the driver
+  /// \param data **[in]** program binary
+  /// \return false if the driver rejects the binary
+  bool link(GLenum format, const std::vector<u8> &data);
+  /// \param format **[out]**
+  /// \param data **[out]**
+  /// \return false if the driver could not provide the binary
+  bool binary(GLenum &format, std::vector<u8> &data) const;
+  void destroy();
+  void use() const;
+  [[nodiscard]] bool hasUniform(const std::string &name) const;
+  /// \return -1 if **name** is not an active uniform
+  [[nodiscard]] GLint locateUniform(const std::string &name) const;
+  void setUniform(const std::string &name, int value) const;
+  void setUniform(const std::string &name, f32 value) const;
+  void setUniform(const std::string &name, const ponos::vec2 &value) const;
+  void setUniform(const std::string &name, const ponos::vec3 &value) const;
+  void setUniform(const std::string &name, const ponos::point3 &value) const;
+  void setUniform(const std::string &name, const ponos::mat4 &value) const;
+  /// \return active uniforms living in the default uniform block
+  [[nodiscard]] const std::vector<Uniform> &uniforms() const { return uniforms_; }
+  [[nodiscard]] GLuint id() const { return id_; }
+
+  std::string err;
+private:
+  bool checkLinkStatus();
+  void introspect();
+
+  GLuint id_{0};
+  std::vector<Uniform> uniforms_;
+  std::unordered_map<std::string, GLint> uniform_locations_;
+};
+
+#endif //GLSL_EXPERIMENTS_SHADER_PROGRAM_H
@@ -0,0 +1,348 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shader_validator.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Compiles and links every shader config of a shader tree in parallel, reporting errors and cost statistics.
+
+#include "headless_context.h"
+#include "shader_config.h"
+#include "shader_preprocessor.h"
+
+#include <json11.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <regex>
+#include <thread>
+
+namespace {
+
+/// Configs with up to this many features have every combination validated
+constexpr u32 max_exhaustive_features = 8;
+
+struct ShaderReport {
+  std::string name;
+  std::string config;
+  bool ok{false};
+  u32 variants{0}; //!< feature combinations compiled and linked
+  std::string log; //!< compiler and linker messages
+  f64 vertex_ms{0};
+  f64 fragment_ms{0};
+  f64 link_ms{0};
+  i32 uniforms{0};
+  i32 uniform_blocks{0};
+  i32 attributes{0};
+  i32 binary_size{0}; //!< bytes, 0 if the driver gives no binary
+  // driver statistics, -1 if the driver does not report them
+  i32 instructions{-1};
+  i32 registers{-1};
+};
+
+/// \return configs following the shaders/<name>/<name>.json layout under **root**
+std::vector<std::string> findConfigs(const std::string &root) {
+  std::vector<std::string> configs;
+  std::error_code ec;
+  for (std::filesystem::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+    const auto &path = it->path();
+    if (path.extension() == ".json" && path.stem() == path.parent_path().filename())
+      configs.emplace_back(path.string());
+  }
+  std::sort(configs.begin(), configs.end());
+  return configs;
+}
+
+std::string infoLog(GLuint object, bool program) {
+  GLint length = 0;
+  if (program)
+    glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length);
+  else
+    glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+  if (length <= 1)
+    return "";
+  std::string log(length, '\0');
+  if (program)
+    glGetProgramInfoLog(object, length, nullptr, &log[0]);
+  else
+    glGetShaderInfoLog(object, length, nullptr, &log[0]);
+  log.resize(length - 1);
+  return log;
+}
+
+/// Sums counters some drivers print in their logs, ex: "123 instructions", "32 registers"
+void parseDriverStats(const std::string &log, ShaderReport &report) {
+  static const std::regex instructions(R"((\d+)\s+instructions)", std::regex::icase);
+  static const std::regex registers(R"((\d+)\s+(?:R-regs|registers|GPRs))", std::regex::icase);
+  auto sum = [&](const std::regex &pattern, i32 &value) {
+    for (std::sregex_iterator it(log.begin(), log.end(), pattern), end; it != end; ++it)
+      value = std::max(value, 0) + std::stoi((*it)[1]);
+  };
+  sum(instructions, report.instructions);
+  sum(registers, report.registers);
+}
+
+GLuint compile(const PreprocessedSource &source, GLenum type, ShaderReport &report, f64 &ms) {
+  ponos::Timer timer;
+  GLuint shader = glCreateShader(type);
+  const char *text = source.code.c_str();
+  glShaderSource(shader, 1, &text, nullptr);
+  glCompileShader(shader);
+  GLint compiled = GL_FALSE;
+  // querying the status waits for the compilation
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+  ms = timer.tack();
+  auto log = infoLog(shader, false);
+  if (!log.empty())
+    report.log += source.mapLog(log);
+  parseDriverStats(log, report);
+  if (compiled != GL_TRUE) {
+    glDeleteShader(shader);
+    return 0;
+  }
+  return shader;
+}
+
+/// \return feature masks to validate, the default one first: every combination
+/// up to max_exhaustive_features features, otherwise the default with each
+/// feature toggled alone
+std::vector<u32> featureMasks(const std::vector<ShaderFeature> &features) {
+  const u32 default_mask = defaultFeatureMask(features);
+  const u32 count = static_cast<u32>(std::min<size_t>(features.size(), max_shader_features));
+  std::vector<u32> masks = {default_mask};
+  if (count <= max_exhaustive_features) {
+    for (u32 mask = 0; mask < (1u << count); ++mask)
+      if (mask != default_mask)
+        masks.emplace_back(mask);
+  } else
+    for (u32 i = 0; i < count; ++i)
+      masks.emplace_back(default_mask ^ (1u << i));
+  return masks;
+}
+
+/// \return enabled feature names joined by '+', for logs
+std::string variantName(const std::vector<ShaderFeature> &features, u32 mask) {
+  std::string name;
+  for (size_t i = 0; i < features.size() && i < max_shader_features; ++i)
+    if (mask & (1u << i))
+      name += (name.empty() ? "" : "+") + features[i].name;
+  return name.empty() ? "no features" : name;
+}
+
+/// Compiles and links the variant of **config** with the features of **mask**
+void validateVariant(const ShaderConfig &config, const std::string &directory, u32 mask,
+                     ShaderIncludeCache &includes, ShaderReport &report) {
+  std::string err;
+  PreprocessedSource vertex_source, fragment_source;
+  auto defines = featureDefines(config.features, mask);
+  if (!includes.preprocess(config.vertex_source, report.name + ".vert", directory, vertex_source, err, defines)
+      || !includes.preprocess(config.fragment_source, report.name + ".frag", directory, fragment_source, err,
+                              defines)) {
+    report.log = err + "\n";
+    return;
+  }
+  GLuint vertex = compile(vertex_source, GL_VERTEX_SHADER, report, report.vertex_ms);
+  GLuint fragment = compile(fragment_source, GL_FRAGMENT_SHADER, report, report.fragment_ms);
+  if (!vertex || !fragment) {
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+    return;
+  }
+  ponos::Timer timer;
+  GLuint program = glCreateProgram();
+  glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  glAttachShader(program, vertex);
+  glAttachShader(program, fragment);
+  glLinkProgram(program);
+  GLint linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  report.link_ms = timer.tack();
+  glDeleteShader(vertex);
+  glDeleteShader(fragment);
+  auto log = infoLog(program, true);
+  if (!log.empty())
+    report.log += "link: " + log + "\n";
+  parseDriverStats(log, report);
+  report.ok = linked == GL_TRUE;
+  if (report.ok) {
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &report.uniforms);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &report.uniform_blocks);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &report.attributes);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &report.binary_size);
+  }
+  glDeleteProgram(program);
+}
+
+void validate(const std::string &config_path, ShaderReport &report) {
+  report.config = config_path;
+  report.name = std::filesystem::path(config_path).stem().string();
+  ShaderConfig config;
+  std::string err;
+  if (!loadShaderConfig(config_path, config, err)) {
+    report.log = err;
+    return;
+  }
+  ShaderIncludeCache includes;
+  auto directory = std::filesystem::path(config_path).parent_path().string();
+  auto masks = featureMasks(config.features);
+  // timings and costs are the ones of the default variant, as in the baselines
+  validateVariant(config, directory, masks[0], includes, report);
+  for (size_t i = 1; i < masks.size(); ++i) {
+    ShaderReport variant;
+    variant.name = report.name;
+    validateVariant(config, directory, masks[i], includes, variant);
+    if (!variant.ok) {
+      report.ok = false;
+      report.log += "variant " + variantName(config.features, masks[i]) + ":\n" + variant.log;
+    }
+  }
+  report.variants = static_cast<u32>(masks.size());
+}
+
+json11::Json toJson(const ShaderReport &report) {
+  return json11::Json::object{
+      {"name", report.name}, {"config", report.config}, {"ok", report.ok},
+      {"variants", static_cast<int>(report.variants)}, {"log", report.log},
+      {"vertex_ms", report.vertex_ms}, {"fragment_ms", report.fragment_ms}, {"link_ms", report.link_ms},
+      {"uniforms", report.uniforms}, {"uniform_blocks", report.uniform_blocks},
+      {"attributes", report.attributes}, {"binary_size", report.binary_size},
+      {"instructions", report.instructions}, {"registers", report.registers}};
+}
+
+/// \return true if **value** grew more than **tolerance** percent over **base** (both valid)
+bool regressed(i32 value, i32 base, f64 tolerance) {
+  return value > 0 && base > 0 && value > base * (1 + tolerance / 100);
+}
+
+}
+
+int main(int argc, char **argv) {
+  std::string root = SHADERS_PATH;
+  std::string output, baseline;
+  f64 tolerance = 5;
+  u32 thread_count = std::max(1u, std::min(std::thread::hardware_concurrency(), 8u));
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "-o" && has_value)
+      output = argv[++i];
+    else if (arg == "-b" && has_value)
+      baseline = argv[++i];
+    else if (arg == "-t" && has_value)
+      tolerance = atof(argv[++i]);
+    else if (arg == "-j" && has_value)
+      thread_count = std::max(1, atoi(argv[++i]));
+    else if (arg[0] == '-') {
+      printf("usage: %s [-j threads] [-o report.json] [-b baseline.json] [-t tolerance %%] [shaders dir]\n"
+             "every feature combination is validated, only the default one and single toggles past %u features\n",
+             argv[0], max_exhaustive_features);
+      return -1;
+    } else
+      root = arg;
+  }
+  auto configs = findConfigs(root);
+  if (configs.empty()) {
+    printf("no <name>/<name>.json configs under %s\n", root.c_str());
+    return -1;
+  }
+  // one context per worker thread, so drivers can compile in parallel
+  std::vector<ShaderReport> reports(configs.size());
+  std::atomic<size_t> next{0};
+  std::mutex mutex;
+  std::string renderer, context_err;
+  std::vector<std::thread> workers;
+  thread_count = std::min<u32>(thread_count, static_cast<u32>(configs.size()));
+  ponos::Timer timer;
+  for (u32 t = 0; t < thread_count; ++t)
+    workers.emplace_back([&] {
+      HeadlessContext context;
+      {
+        // entry points are process wide, loaded by one thread at a time
+        std::lock_guard<std::mutex> guard(mutex);
+        std::string err;
+        if (!context.create(err)) {
+          context_err = err;
+          return;
+        }
+        renderer = context.renderer();
+      }
+      for (size_t i = next++; i < configs.size(); i = next++)
+        validate(configs[i], reports[i]);
+    });
+  for (auto &worker : workers)
+    worker.join();
+  if (renderer.empty()) {
+    printf("%s\n", context_err.c_str());
+    return -1;
+  }
+  auto total_ms = timer.tack();
+  // baseline
+  std::map<std::string, json11::Json> base;
+  if (!baseline.empty()) {
+    std::ifstream in(baseline);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()), err;
+    auto json = json11::Json::parse(text, err);
+    if (!err.empty()) {
+      printf("%s: %s\n", baseline.c_str(), err.c_str());
+      return -1;
+    }
+    for (const auto &item : json["shaders"].array_items())
+      base[item["name"].string_value()] = item;
+  }
+  printf("%s | %zu shaders | %u threads | %.1f ms\n", renderer.c_str(), configs.size(), thread_count, total_ms);
+  printf("%-20s %-6s %8s %8s %8s %8s %8s %6s %6s %10s %8s %8s\n", "shader", "status", "variants", "vs ms", "fs ms",
+         "link ms", "uniforms", "blocks", "attrs", "binary KB", "instr", "regs");
+  int result = 0;
+  json11::Json::array shaders;
+  for (const auto &report : reports) {
+    std::string status = report.ok ? "ok" : "ERROR";
+    auto it = base.find(report.name);
+    if (report.ok && it != base.end()) {
+      if (regressed(report.binary_size, it->second["binary_size"].int_value(), tolerance)
+          || regressed(report.instructions, it->second["instructions"].int_value(), tolerance)
+          || regressed(report.registers, it->second["registers"].int_value(), tolerance))
+        status = "COST";
+    }
+    if (status != "ok")
+      result = 1;
+    printf("%-20s %-6s %8u %8.2f %8.2f %8.2f %8d %6d %6d %10.1f %8d %8d\n", report.name.c_str(), status.c_str(),
+           report.variants, report.vertex_ms, report.fragment_ms, report.link_ms, report.uniforms, report.uniform_blocks,
+           report.attributes, report.binary_size / 1024.0, report.instructions, report.registers);
+    if (!report.ok && !report.log.empty())
+      printf("%s", report.log.c_str());
+    shaders.emplace_back(toJson(report));
+  }
+  if (!output.empty()) {
+    std::ofstream out(output);
+    out << json11::Json(json11::Json::object{{"renderer", renderer}, {"shaders", shaders}}).dump() << "\n";
+    if (!out) {
+      printf("could not write %s\n", output.c_str());
+      return -1;
+    }
+  }
+  return result;
+}
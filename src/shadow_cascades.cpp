@@ -0,0 +1,192 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shadow_cascades.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "shadow_cascades.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Gauss-Jordan with partial pivoting
+/// \return false if **m** is singular
+bool invert(const f32 m[4][4], f64 inverse[4][4]) {
+  f64 a[4][8];
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j) {
+      a[i][j] = m[i][j];
+      a[i][j + 4] = i == j;
+    }
+  for (int c = 0; c < 4; ++c) {
+    int pivot = c;
+    for (int r = c + 1; r < 4; ++r)
+      if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+        pivot = r;
+    if (std::abs(a[pivot][c]) < 1e-12)
+      return false;
+    std::swap(a[c], a[pivot]);
+    f64 inv_pivot = 1 / a[c][c];
+    for (auto &v : a[c])
+      v *= inv_pivot;
+    for (int r = 0; r < 4; ++r)
+      if (r != c) {
+        f64 f = a[r][c];
+        for (int j = 0; j < 8; ++j)
+          a[r][j] -= f * a[c][j];
+      }
+  }
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      inverse[i][j] = a[i][j + 4];
+  return true;
+}
+
+f64 dot(const f64 *a, const f64 *b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+f64 distance(const f64 *a, const f64 *b) {
+  f64 d[3] = {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+  return std::sqrt(dot(d, d));
+}
+
+void normalize(f64 *v) {
+  f64 length = std::sqrt(dot(v, v));
+  for (int i = 0; i < 3; ++i)
+    v[i] /= length;
+}
+
+void cross(const f64 *a, const f64 *b, f64 *c) {
+  c[0] = a[1] * b[2] - a[2] * b[1];
+  c[1] = a[2] * b[0] - a[0] * b[2];
+  c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+}
+
+u32 fitShadowCascades(const f32 camera_view_projection[4][4], const f32 light_direction[3],
+                      const f32 scene_bounds[6], const ShadowParams &params, ShadowCascade *cascades) {
+  f64 inverse[4][4];
+  if (!invert(camera_view_projection, inverse))
+    return 0;
+  // frustum corners, near plane (z = -1) then far plane (z = 1)
+  f64 corners[8][3];
+  for (int i = 0; i < 8; ++i) {
+    f64 ndc[4] = {i & 1 ? 1. : -1., i & 2 ? 1. : -1., i < 4 ? -1. : 1., 1};
+    f64 p[4] = {};
+    for (int r = 0; r < 4; ++r)
+      for (int c = 0; c < 4; ++c)
+        p[r] += inverse[r][c] * ndc[c];
+    for (int d = 0; d < 3; ++d)
+      corners[i][d] = p[d] / p[3];
+  }
+  // near and far distances, from the plane sizes: corners of both planes lie
+  // on the same rays from the eye
+  f64 near_center[3] = {}, far_center[3] = {};
+  for (int i = 0; i < 4; ++i)
+    for (int d = 0; d < 3; ++d) {
+      near_center[d] += corners[i][d] / 4;
+      far_center[d] += corners[i + 4][d] / 4;
+    }
+  f64 near_size = distance(corners[0], near_center), far_size = distance(corners[4], far_center);
+  f64 depth = distance(near_center, far_center);
+  f64 near = far_size > near_size ? depth * near_size / (far_size - near_size) : 0;
+  f64 far = near + depth;
+  f64 shadow_far = std::min<f64>(far, near + std::max(params.max_distance, 1e-3f));
+  // light basis, z grows away from the light
+  f64 forward[3] = {-light_direction[0], -light_direction[1], -light_direction[2]};
+  normalize(forward);
+  f64 up[3] = {0, 1, 0};
+  if (std::abs(forward[1]) > 0.99)
+    up[1] = 0, up[2] = 1;
+  f64 right[3], light_up[3];
+  cross(forward, up, right);
+  normalize(right);
+  cross(right, forward, light_up);
+  // caster depth range
+  f64 scene_near = 0;
+  for (int i = 0; i < 8; ++i) {
+    f64 p[3] = {scene_bounds[i & 1 ? 3 : 0], scene_bounds[i & 2 ? 4 : 1], scene_bounds[i & 4 ? 5 : 2]};
+    scene_near = i ? std::min(scene_near, dot(p, forward)) : dot(p, forward);
+  }
+  u32 count = std::min(std::max(params.cascade_count, 1u), max_shadow_cascades);
+  u32 resolution = std::max(params.resolution, 1u);
+  auto split = [&](u32 i) {
+    // practical split scheme (Zhang et al. 2006)
+    f64 t = static_cast<f64>(i) / count;
+    f64 logarithmic = near > 0 ? near * std::pow(shadow_far / near, t) : shadow_far * t;
+    f64 uniform = near + (shadow_far - near) * t;
+    return params.split_lambda * logarithmic + (1 - params.split_lambda) * uniform;
+  };
+  for (u32 c = 0; c < count; ++c) {
+    auto &cascade = cascades[c];
+    cascade.near = static_cast<f32>(split(c));
+    cascade.far = static_cast<f32>(c + 1 == count ? shadow_far : split(c + 1));
+    // slice corners along the frustum edges
+    f64 slice[8][3], center[3] = {};
+    for (int i = 0; i < 4; ++i)
+      for (int k = 0; k < 2; ++k) {
+        f64 t = ((k ? cascade.far : cascade.near) - near) / depth;
+        for (int d = 0; d < 3; ++d) {
+          slice[i + 4 * k][d] = corners[i][d] + (corners[i + 4][d] - corners[i][d]) * t;
+          center[d] += slice[i + 4 * k][d] / 8;
+        }
+      }
+    f64 radius = 0;
+    for (const auto &corner : slice)
+      radius = std::max(radius, distance(corner, center));
+    // a fixed step keeps the size from changing with rounding noise
+    radius = std::ceil(radius * 16) / 16;
+    f64 texel = 2 * radius / resolution;
+    f64 x = std::floor(dot(center, right) / texel) * texel;
+    f64 y = std::floor(dot(center, light_up) / texel) * texel;
+    f64 z_near = std::min(scene_near, dot(center, forward) - radius);
+    f64 z_far = dot(center, forward) + radius;
+    f64 z_scale = 2 / (z_far - z_near);
+    const f64 rows[4][4] = {
+        {right[0] / radius, right[1] / radius, right[2] / radius, -x / radius},
+        {light_up[0] / radius, light_up[1] / radius, light_up[2] / radius, -y / radius},
+        {forward[0] * z_scale, forward[1] * z_scale, forward[2] * z_scale, -z_near * z_scale - 1},
+        {0, 0, 0, 1}};
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j) {
+        cascade.view_projection[i][j] = static_cast<f32>(rows[i][j]);
+        // clip [-1, 1] -> [0, 1] on x, y and z
+        cascade.shadow_matrix[i][j] = static_cast<f32>(i < 3 ? 0.5 * rows[i][j] + (j == 3 ? 0.5 : 0) : rows[i][j]);
+      }
+    cascade.texel_size = static_cast<f32>(texel);
+  }
+  return count;
+}
+
+void shadowAtlasTile(u32 cascade_count, u32 index, f32 rect[4]) {
+  // 1: whole atlas, 2: side by side, 3 and 4: 2x2 grid
+  u32 columns = cascade_count > 1 ? 2 : 1;
+  u32 rows = cascade_count > 2 ? 2 : 1;
+  rect[2] = 1.f / columns;
+  rect[3] = 1.f / rows;
+  rect[0] = (index % columns) * rect[2];
+  rect[1] = (index / columns) * rect[3];
+}
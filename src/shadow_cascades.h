@@ -0,0 +1,72 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shadow_cascades.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Cascaded shadow map fitting: frustum splits and stable orthographic light projections.
+
+#ifndef GLSL_EXPERIMENTS_SHADOW_CASCADES_H
+#define GLSL_EXPERIMENTS_SHADOW_CASCADES_H
+
+#include <ponos/ponos.h>
+
+constexpr u32 max_shadow_cascades = 4;
+
+struct ShadowParams {
+  u32 cascade_count{3};
+  u32 resolution{1024};   //!< texels per side of each cascade
+  f32 max_distance{30};   //!< from the camera, shadows end there
+  f32 split_lambda{0.7f}; //!< 0: uniform splits, 1: logarithmic splits
+};
+
+/// Orthographic light view covering one slice of the camera frustum
+struct ShadowCascade {
+  f32 view_projection[4][4]{}; //!< world -> light clip space, row major
+  f32 shadow_matrix[4][4]{};   //!< world -> [0, 1] (tile uv, depth), row major
+  f32 near{0};                 //!< camera distance where the slice starts
+  f32 far{0};                  //!< camera distance where the slice ends
+  f32 texel_size{0};           //!< world units per shadow texel
+};
+
+/// Splits the camera frustum (up to params.max_distance) in
+/// params.cascade_count slices and fits an orthographic light projection to
+/// each of them. A slice is bounded by a sphere, so its projection keeps its
+/// size while the camera turns, and the projection center moves in whole
+/// texels, so shadow edges do not shimmer while the camera moves. Depth
+/// ranges are extended towards the light up to **scene_bounds**, so casters
+/// outside of the view still cast.
+/// \param camera_view_projection **[in]** projection * view, row major, GL clip space
+/// \param light_direction **[in]** from the scene towards the light
+/// \param scene_bounds **[in]** world min xyz, max xyz of every shadow caster
+/// \param params **[in]**
+/// \param cascades **[out]** params.cascade_count entries (clamped to max_shadow_cascades)
+/// \return number of cascades written, 0 if the camera matrix is singular
+u32 fitShadowCascades(const f32 camera_view_projection[4][4], const f32 light_direction[3],
+                      const f32 scene_bounds[6], const ShadowParams &params, ShadowCascade *cascades);
+
+/// \param cascade_count **[in]**
+/// \param index **[in]** cascade
+/// \param rect **[out]** x, y offset and x, y scale of the cascade tile in the atlas ([0, 1] units)
+void shadowAtlasTile(u32 cascade_count, u32 index, f32 rect[4]);
+
+#endif //GLSL_EXPERIMENTS_SHADOW_CASCADES_H
@@ -0,0 +1,157 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shadow_map.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "shadow_map.h"
+
+namespace {
+
+const char *vertex_source = R"(#version 440 core
+layout(location = 0) in vec3 vPosition;
+layout(location = 0) uniform mat4 lightViewProjection;
+layout(location = 1) uniform mat4 model;
+layout(location = 2) uniform vec3 positionScale;
+layout(location = 3) uniform vec3 positionOffset;
+layout(location = 4) uniform int instanceCount;
+struct Instance {
+  mat4 model;
+  vec4 color;
+};
+layout(std430, binding = 2) readonly buffer InstanceBlock {
+  Instance instances[];
+};
+void main() {
+  mat4 m = instanceCount > 0 ? instances[gl_InstanceID].model * model : model;
+  gl_Position = lightViewProjection * m * vec4(vPosition * positionScale + positionOffset, 1.0);
+}
+)";
+
+const char *fragment_source = R"(#version 440 core
+void main() {}
+)";
+
+}
+
+ShadowMap::~ShadowMap() {
+  destroy();
+}
+
+bool ShadowMap::resize(u32 resolution, u32 cascade_count, std::string &err) {
+  if (!program_.id()) {
+    circe::gl::Shader vertex_shader, fragment_shader;
+    if (!vertex_shader.compile(vertex_source, GL_VERTEX_SHADER)
+        || !fragment_shader.compile(fragment_source, GL_FRAGMENT_SHADER)) {
+      err = vertex_shader.err + fragment_shader.err;
+      return false;
+    }
+    if (!program_.link({&vertex_shader, &fragment_shader})) {
+      err = program_.err;
+      return false;
+    }
+  }
+  if (fbo_ && resolution == resolution_ && cascade_count == cascade_count_)
+    return true;
+  if (fbo_)
+    glDeleteFramebuffers(1, &fbo_);
+  if (depth_)
+    glDeleteTextures(1, &depth_);
+  resolution_ = resolution;
+  cascade_count_ = cascade_count;
+  f32 tile[4];
+  shadowAtlasTile(cascade_count, 0, tile);
+  width_ = static_cast<u32>(resolution / tile[2]);
+  height_ = static_cast<u32>(resolution / tile[3]);
+  glGenTextures(1, &depth_);
+  glBindTexture(GL_TEXTURE_2D, depth_);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width_, height_);
+  // hardware 2x2 PCF
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+  glGenFramebuffers(1, &fbo_);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_, 0);
+  glDrawBuffer(GL_NONE);
+  glReadBuffer(GL_NONE);
+  bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (!complete)
+    err = "incomplete shadow framebuffer";
+  return complete;
+}
+
+void ShadowMap::begin() {
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &saved_framebuffer_);
+  glGetIntegerv(GL_VIEWPORT, saved_viewport_);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+  glViewport(0, 0, width_, height_);
+  glEnable(GL_DEPTH_TEST);
+  glDepthMask(GL_TRUE);
+  glClear(GL_DEPTH_BUFFER_BIT);
+  // slope scaled bias against acne on surfaces facing away from the light
+  glEnable(GL_POLYGON_OFFSET_FILL);
+  glPolygonOffset(2, 4);
+  program_.use();
+}
+
+void ShadowMap::beginCascade(u32 cascade, const f32 view_projection[4][4]) {
+  f32 tile[4];
+  shadowAtlasTile(cascade_count_, cascade, tile);
+  glViewport(static_cast<GLint>(tile[0] * width_), static_cast<GLint>(tile[1] * height_), resolution_,
+             resolution_);
+  glUniformMatrix4fv(0, 1, GL_TRUE, &view_projection[0][0]);
+}
+
+void ShadowMap::setObject(const f32 model[4][4], const VertexDequantization &dequantization, u32 instance_count) {
+  glUniformMatrix4fv(1, 1, GL_TRUE, &model[0][0]);
+  glUniform3fv(2, 1, dequantization.position_scale);
+  glUniform3fv(3, 1, dequantization.position_offset);
+  glUniform1i(4, static_cast<GLint>(instance_count));
+}
+
+void ShadowMap::end() {
+  glDisable(GL_POLYGON_OFFSET_FILL);
+  glBindFramebuffer(GL_FRAMEBUFFER, saved_framebuffer_);
+  glViewport(saved_viewport_[0], saved_viewport_[1], saved_viewport_[2], saved_viewport_[3]);
+}
+
+void ShadowMap::bind(GLenum unit) const {
+  glActiveTexture(unit);
+  glBindTexture(GL_TEXTURE_2D, depth_);
+}
+
+void ShadowMap::destroy() {
+  if (fbo_)
+    glDeleteFramebuffers(1, &fbo_);
+  if (depth_)
+    glDeleteTextures(1, &depth_);
+  program_.destroy();
+  fbo_ = depth_ = 0;
+  resolution_ = cascade_count_ = width_ = height_ = 0;
+}
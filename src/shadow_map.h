@@ -0,0 +1,92 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file shadow_map.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Depth atlas and depth only pass of cascaded shadow maps.
+
+#ifndef GLSL_EXPERIMENTS_SHADOW_MAP_H
+#define GLSL_EXPERIMENTS_SHADOW_MAP_H
+
+#include "shader_program.h"
+#include "shadow_cascades.h"
+#include "vertex_format.h"
+
+#include <circe/circe.h>
+
+/// Depth atlas holding every cascade of a directional light (one tile per
+/// cascade, see shadowAtlasTile) and the depth only program that fills it.
+/// The atlas is a GL_DEPTH_COMPONENT32F texture with comparison enabled, for
+/// sampler2DShadow lookups.
+///
+/// Usage:
+///   shadow_map.resize(params.resolution, params.cascade_count, err);
+///   shadow_map.begin();
+///   for (u32 c = 0; c < count; ++c) {
+///     shadow_map.beginCascade(c, cascades[c].view_projection);
+///     shadow_map.setObject(model, dequantization, 0);
+///     mesh.draw();
+///   }
+///   shadow_map.end();
+class ShadowMap {
+public:
+  ShadowMap() = default;
+  ShadowMap(const ShadowMap &) = delete;
+  ShadowMap &operator=(const ShadowMap &) = delete;
+  ~ShadowMap();
+  /// (Re)creates the atlas if the layout changed, and the program once.
+  /// \param resolution **[in]** texels per side of each cascade
+  /// \param cascade_count **[in]**
+  /// \param err **[out]**
+  /// \return false if the program does not build or the framebuffer is incomplete
+  bool resize(u32 resolution, u32 cascade_count, std::string &err);
+  /// Binds and clears the atlas, and binds the depth program. The current
+  /// framebuffer and viewport are restored by end().
+  void begin();
+  /// \param cascade **[in]** selects its tile
+  /// \param view_projection **[in]** world -> light clip space, row major
+  void beginCascade(u32 cascade, const f32 view_projection[4][4]);
+  /// \param model **[in]** row major
+  /// \param dequantization **[in]** of the vertices drawn next
+  /// \param instance_count **[in]** > 0 takes the instance transforms from the InstanceBlock
+  void setObject(const f32 model[4][4], const VertexDequantization &dequantization, u32 instance_count);
+  void end();
+  /// \param unit **[in]** receives the atlas (sampler2DShadow shadowMap)
+  void bind(GLenum unit) const;
+  void destroy();
+  [[nodiscard]] u32 width() const { return width_; }
+  [[nodiscard]] u32 height() const { return height_; }
+
+private:
+  GLuint fbo_{0};
+  GLuint depth_{0};
+  ShaderProgram program_;
+  u32 resolution_{0};
+  u32 cascade_count_{0};
+  u32 width_{0};
+  u32 height_{0};
+  GLint saved_framebuffer_{0};
+  GLint saved_viewport_[4]{};
+};
+
+#endif //GLSL_EXPERIMENTS_SHADOW_MAP_H
@@ -0,0 +1,290 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file terrain.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "terrain.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr u32 hash_x = 0x27d4eb2du;
+constexpr u32 hash_y = 0x165667b1u;
+constexpr u32 hash_mix = 0x2c1b3c6du;
+
+u32 hash(i32 x, i32 y, u32 seed) {
+  u32 h = static_cast<u32>(x) * hash_x ^ static_cast<u32>(y) * hash_y ^ seed;
+  h ^= h >> 15;
+  h *= hash_mix;
+  h ^= h >> 12;
+  return h;
+}
+
+/// dot of (x, y) with one of the 4 diagonal gradients
+f32 gradient(u32 h, f32 x, f32 y) {
+  return ((h & 1) ? -x : x) + ((h & 2) ? -y : y);
+}
+
+f32 fade(f32 t) {
+  return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+u32 octaveSeed(u32 seed, u32 octave) {
+  return seed * 0x9e3779b9u + octave * 0x85ebca6bu;
+}
+
+#ifdef __SSE2__
+
+/// 32 bit low multiply (SSE4.1 _mm_mullo_epi32)
+__m128i mullo(__m128i a, __m128i b) {
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+__m128i hash4(__m128i x, __m128i y, __m128i seed) {
+  __m128i h = _mm_xor_si128(_mm_xor_si128(mullo(x, _mm_set1_epi32(hash_x)), mullo(y, _mm_set1_epi32(hash_y))), seed);
+  h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+  h = mullo(h, _mm_set1_epi32(hash_mix));
+  return _mm_xor_si128(h, _mm_srli_epi32(h, 12));
+}
+
+__m128 gradient4(__m128i h, __m128 x, __m128 y) {
+  // move hash bits 0 and 1 into the sign bits
+  __m128 sx = _mm_castsi128_ps(_mm_slli_epi32(h, 31));
+  __m128 sy = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(h, 1), 31));
+  return _mm_add_ps(_mm_xor_ps(x, sx), _mm_xor_ps(y, sy));
+}
+
+__m128 fade4(__m128 t) {
+  __m128 p = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6)), _mm_set1_ps(15))), _mm_set1_ps(10));
+  return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), p);
+}
+
+/// floor, as integers (SSE2 has no _mm_floor_ps)
+__m128i floor4(__m128 x) {
+  __m128i i = _mm_cvttps_epi32(x);
+  // truncation rounds negative values up, subtract 1 where that happened
+  return _mm_add_epi32(i, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(i), x)));
+}
+
+__m128 lerp4(__m128 a, __m128 b, __m128 t) {
+  return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+__m128 gradientNoise4(__m128 x, __m128 y, __m128i seed) {
+  __m128i ix = floor4(x), iy = floor4(y);
+  __m128 fx = _mm_sub_ps(x, _mm_cvtepi32_ps(ix)), fy = _mm_sub_ps(y, _mm_cvtepi32_ps(iy));
+  __m128i one = _mm_set1_epi32(1);
+  __m128i ix1 = _mm_add_epi32(ix, one), iy1 = _mm_add_epi32(iy, one);
+  __m128 fx1 = _mm_sub_ps(fx, _mm_set1_ps(1)), fy1 = _mm_sub_ps(fy, _mm_set1_ps(1));
+  __m128 n00 = gradient4(hash4(ix, iy, seed), fx, fy);
+  __m128 n10 = gradient4(hash4(ix1, iy, seed), fx1, fy);
+  __m128 n01 = gradient4(hash4(ix, iy1, seed), fx, fy1);
+  __m128 n11 = gradient4(hash4(ix1, iy1, seed), fx1, fy1);
+  __m128 u = fade4(fx), v = fade4(fy);
+  return lerp4(lerp4(n00, n10, u), lerp4(n01, n11, u), v);
+}
+
+#endif
+
+f32 lerp(f32 a, f32 b, f32 t) {
+  return a + (b - a) * t;
+}
+
+/// fBm at (u0 + j * step, v), j in [0, n)
+void heightsRow(const TerrainParams &params, f32 u0, f32 step, f32 v, u32 n, f32 *out) {
+  std::fill(out, out + n, 0.f);
+  f32 frequency = params.frequency, amplitude = params.height;
+  for (u32 octave = 0; octave < params.octaves; ++octave) {
+    u32 seed = octaveSeed(params.seed, octave);
+    f32 y = v * frequency;
+    u32 j = 0;
+#ifdef __SSE2__
+    if (params.use_simd) {
+      __m128i seed4 = _mm_set1_epi32(static_cast<i32>(seed));
+      __m128 y4 = _mm_set1_ps(y), frequency4 = _mm_set1_ps(frequency), amplitude4 = _mm_set1_ps(amplitude);
+      __m128 step4 = _mm_set1_ps(step), u04 = _mm_set1_ps(u0);
+      for (; j + 4 <= n; j += 4) {
+        __m128 u = _mm_add_ps(u04, _mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(j, j + 1, j + 2, j + 3)), step4));
+        __m128 h = gradientNoise4(_mm_mul_ps(u, frequency4), y4, seed4);
+        _mm_storeu_ps(out + j, _mm_add_ps(_mm_loadu_ps(out + j), _mm_mul_ps(h, amplitude4)));
+      }
+    }
+#endif
+    for (; j < n; ++j)
+      out[j] += gradientNoise((u0 + static_cast<f32>(j) * step) * frequency, y, seed) * amplitude;
+    frequency *= params.lacunarity;
+    amplitude *= params.gain;
+  }
+}
+
+/// Writes normal and tangent of sample j from height differences
+void writeFrame(f32 dhdx, f32 dhdz, f32 *normal, f32 *tangent) {
+  f32 n = 1 / std::sqrt(dhdx * dhdx + 1 + dhdz * dhdz);
+  normal[0] = -dhdx * n;
+  normal[1] = n;
+  normal[2] = -dhdz * n;
+  f32 t = 1 / std::sqrt(1 + dhdx * dhdx);
+  tangent[0] = t;
+  tangent[1] = dhdx * t;
+  tangent[2] = 0;
+}
+
+void normalsRow(Heightfield &field, u32 row, bool use_simd) {
+  const u32 n = field.resolution;
+  const f32 *h = field.heights.data();
+  const f32 *up = h + size_t(row ? row - 1 : row) * n;
+  const f32 *down = h + size_t(std::min(row + 1, n - 1)) * n;
+  const f32 *center = h + size_t(row) * n;
+  // one sided differences at the borders
+  const f32 dz = field.spacing() * ((row == 0 || row == n - 1) ? 1 : 2);
+  const f32 dx = field.spacing() * 2;
+  f32 *normals = field.normals.data() + size_t(row) * n * 3;
+  f32 *tangents = field.tangents.data() + size_t(row) * n * 3;
+  auto scalar = [&](u32 j) {
+    u32 l = j ? j - 1 : j, r = std::min(j + 1, n - 1);
+    f32 dhdx = (center[r] - center[l]) / (field.spacing() * static_cast<f32>(r - l));
+    f32 dhdz = (down[j] - up[j]) / dz;
+    writeFrame(dhdx, dhdz, normals + 3 * j, tangents + 3 * j);
+  };
+  scalar(0);
+  u32 j = 1;
+#ifdef __SSE2__
+  if (use_simd) {
+    const __m128 inv_dx = _mm_set1_ps(1 / dx), inv_dz = _mm_set1_ps(1 / dz), one = _mm_set1_ps(1);
+    const __m128 sign = _mm_set1_ps(-0.f);
+    alignas(16) f32 nx[4], ny[4], nz[4], tx[4], ty[4];
+    for (; j + 4 < n; j += 4) {
+      __m128 dhdx = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(center + j + 1), _mm_loadu_ps(center + j - 1)), inv_dx);
+      __m128 dhdz = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(down + j), _mm_loadu_ps(up + j)), inv_dz);
+      __m128 dhdx2 = _mm_mul_ps(dhdx, dhdx);
+      __m128 nl = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(dhdx2, one), _mm_mul_ps(dhdz, dhdz))));
+      __m128 tl = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(one, dhdx2)));
+      _mm_store_ps(nx, _mm_mul_ps(_mm_xor_ps(dhdx, sign), nl));
+      _mm_store_ps(ny, nl);
+      _mm_store_ps(nz, _mm_mul_ps(_mm_xor_ps(dhdz, sign), nl));
+      _mm_store_ps(tx, tl);
+      _mm_store_ps(ty, _mm_mul_ps(dhdx, tl));
+      for (u32 k = 0; k < 4; ++k) {
+        f32 *normal = normals + 3 * (j + k), *tangent = tangents + 3 * (j + k);
+        normal[0] = nx[k];
+        normal[1] = ny[k];
+        normal[2] = nz[k];
+        tangent[0] = tx[k];
+        tangent[1] = ty[k];
+        tangent[2] = 0;
+      }
+    }
+  }
+#endif
+  for (; j < n; ++j)
+    scalar(j);
+}
+
+}
+
+f32 gradientNoise(f32 x, f32 y, u32 seed) {
+  f32 fx0 = std::floor(x), fy0 = std::floor(y);
+  auto ix = static_cast<i32>(fx0), iy = static_cast<i32>(fy0);
+  f32 fx = x - fx0, fy = y - fy0;
+  f32 n00 = gradient(hash(ix, iy, seed), fx, fy);
+  f32 n10 = gradient(hash(ix + 1, iy, seed), fx - 1, fy);
+  f32 n01 = gradient(hash(ix, iy + 1, seed), fx, fy - 1);
+  f32 n11 = gradient(hash(ix + 1, iy + 1, seed), fx - 1, fy - 1);
+  f32 u = fade(fx), v = fade(fy);
+  return lerp(lerp(n00, n10, u), lerp(n01, n11, u), v);
+}
+
+void generateHeights(const TerrainParams &params, Heightfield &field, ThreadPool &pool) {
+  const u32 n = std::max(params.resolution, 2u);
+  const f32 step = 1.f / (n - 1);
+  field.resolution = n;
+  field.size = params.size;
+  field.heights.resize(size_t(n) * n);
+  pool.parallelFor(n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      heightsRow(params, 0, step, i * step, n, field.heights.data() + i * n);
+  }, 16);
+}
+
+void computeNormals(Heightfield &field, bool use_simd, ThreadPool &pool) {
+  const u32 n = field.resolution;
+  field.normals.resize(size_t(n) * n * 3);
+  field.tangents.resize(size_t(n) * n * 3);
+  pool.parallelFor(n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      normalsRow(field, static_cast<u32>(i), use_simd);
+  }, 16);
+}
+
+void generateTerrainChunk(const TerrainParams &params, f32 u0, f32 v0, f32 step, u32 count,
+                          std::vector<f32> &vertex_data) {
+  // one extra sample around the chunk, so border normals match the neighbors
+  Heightfield field;
+  field.resolution = count + 2;
+  field.size = step * (count + 1) * params.size;
+  field.heights.resize(size_t(field.resolution) * field.resolution);
+  field.normals.resize(field.heights.size() * 3);
+  field.tangents.resize(field.heights.size() * 3);
+  for (u32 i = 0; i < field.resolution; ++i)
+    heightsRow(params, u0 - step, step, v0 + (static_cast<f32>(i) - 1) * step, field.resolution,
+               field.heights.data() + size_t(i) * field.resolution);
+  for (u32 i = 1; i + 1 < field.resolution; ++i)
+    normalsRow(field, i, params.use_simd);
+  vertex_data.resize(size_t(count) * count * terrain_vertex_stride);
+  f32 *v = vertex_data.data();
+  for (u32 i = 0; i < count; ++i)
+    for (u32 j = 0; j < count; ++j, v += terrain_vertex_stride) {
+      size_t s = size_t(i + 1) * field.resolution + j + 1;
+      const f32 *normal = field.normals.data() + 3 * s, *tangent = field.tangents.data() + 3 * s;
+      f32 u = u0 + j * step, w = v0 + i * step;
+      v[0] = (u - 0.5f) * params.size;
+      v[1] = field.heights[s];
+      v[2] = (w - 0.5f) * params.size;
+      std::copy(normal, normal + 3, v + 3);
+      v[6] = u;
+      v[7] = w;
+      std::copy(tangent, tangent + 3, v + 8);
+      // bitangent = tangent x normal, along +z (+v)
+      v[11] = tangent[1] * normal[2] - tangent[2] * normal[1];
+      v[12] = tangent[2] * normal[0] - tangent[0] * normal[2];
+      v[13] = tangent[0] * normal[1] - tangent[1] * normal[0];
+    }
+}
+
+f32 terrainHeightBound(const TerrainParams &params) {
+  f32 bound = 0, amplitude = std::fabs(params.height);
+  for (u32 octave = 0; octave < params.octaves; ++octave, amplitude *= std::fabs(params.gain))
+    bound += amplitude;
+  return bound;
+}
@@ -0,0 +1,96 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file terrain.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Procedural terrain generation.
+
+#ifndef GLSL_EXPERIMENTS_TERRAIN_H
+#define GLSL_EXPERIMENTS_TERRAIN_H
+
+#include "thread_pool.h"
+
+struct TerrainParams {
+  u32 resolution{256}; //!< samples per side
+  f32 size{2};         //!< world extent of each side, centered at the origin
+  f32 height{0.3f};    //!< height scale
+  f32 frequency{3};    //!< of the first octave, in cycles per side
+  u32 octaves{6};
+  f32 lacunarity{2};   //!< frequency multiplier between octaves
+  f32 gain{0.5f};      //!< amplitude multiplier between octaves
+  u32 seed{0};
+  /// false forces the scalar path (for comparisons, results are the same)
+  bool use_simd{true};
+};
+
+/// Square grid of height samples, laid out row by row (z major). Sample
+/// (i, j) sits at x = (j / (resolution - 1) - 0.5) * size, z likewise with i.
+struct Heightfield {
+  u32 resolution{0};
+  f32 size{0};
+  std::vector<f32> heights;
+  std::vector<f32> normals;  //!< 3 floats per sample
+  std::vector<f32> tangents; //!< 3 floats per sample, along +x (+u)
+  [[nodiscard]] f32 spacing() const { return resolution > 1 ? size / (resolution - 1) : size; }
+};
+
+/// 2D gradient noise, roughly in [-1, 1]
+/// \param x **[in]**
+/// \param y **[in]**
+/// \param seed **[in | optional]**
+f32 gradientNoise(f32 x, f32 y, u32 seed = 0);
+
+/// Fills heights with multi octave fBm of gradient noise. Rows are split
+/// among the pool workers and each row is evaluated 4 samples at a time
+/// (SSE2 when available).
+/// \param params **[in]**
+/// \param field **[out]**
+/// \param pool **[in | optional]**
+void generateHeights(const TerrainParams &params, Heightfield &field, ThreadPool &pool = ThreadPool::global());
+
+/// Computes normals and tangents from central differences of the heights.
+/// \param field **[in/out]**
+/// \param use_simd **[in | optional]**
+/// \param pool **[in | optional]**
+void computeNormals(Heightfield &field, bool use_simd = true, ThreadPool &pool = ThreadPool::global());
+
+/// Interleaved vertex layout of generateTerrainChunk, matching the editor
+/// shaders: position (3), normal (3), uv (2), tangent (3), bitangent (3).
+constexpr u32 terrain_vertex_stride = 14;
+
+/// Builds the vertices of a count x count grid of terrain samples, starting
+/// at (u0, v0) in the [0, 1] terrain parametrization. Runs on the calling
+/// thread (meant to be called from pool jobs).
+/// \param params **[in]**
+/// \param u0 **[in]**
+/// \param v0 **[in]**
+/// \param step **[in]** uv distance between samples
+/// \param count **[in]** samples per side
+/// \param vertex_data **[out]** terrain_vertex_stride floats per sample, row by row
+void generateTerrainChunk(const TerrainParams &params, f32 u0, f32 v0, f32 step, u32 count,
+                          std::vector<f32> &vertex_data);
+
+/// \return upper bound of |height|
+f32 terrainHeightBound(const TerrainParams &params);
+
+#endif //GLSL_EXPERIMENTS_TERRAIN_H
@@ -0,0 +1,305 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file terrain_renderer.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "terrain_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+void Frustum::set(const f32 m[4][4]) {
+  // Gribb & Hartmann: planes are sums/differences of the last row with the others
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 4; ++j) {
+      planes[2 * i][j] = m[3][j] + m[i][j];
+      planes[2 * i + 1][j] = m[3][j] - m[i][j];
+    }
+}
+
+bool Frustum::intersects(const f32 box_min[3], const f32 box_max[3]) const {
+  for (const auto &plane : planes) {
+    // corner of the box furthest along the plane normal
+    f32 d = plane[3];
+    for (int k = 0; k < 3; ++k)
+      d += plane[k] * (plane[k] >= 0 ? box_max[k] : box_min[k]);
+    if (d < 0)
+      return false;
+  }
+  return true;
+}
+
+TerrainRenderer::TerrainRenderer(ThreadPool &pool, u32 slot_count) : pool_(pool), slot_count_(slot_count) {}
+
+TerrainRenderer::~TerrainRenderer() {
+  destroy();
+}
+
+void TerrainRenderer::destroy() {
+  cancelJobs();
+  resident_.clear();
+  free_slots_.clear();
+  if (vao_) {
+    glDeleteVertexArrays(1, &vao_);
+    glDeleteBuffers(1, &vbo_);
+    glDeleteBuffers(1, &ibo_);
+  }
+  vao_ = vbo_ = ibo_ = 0;
+}
+
+void TerrainRenderer::cancelJobs() {
+  for (auto &job : jobs_)
+    job.wait();
+  jobs_.clear();
+  generated_.clear();
+  pending_.clear();
+}
+
+void TerrainRenderer::setup(const TerrainParams &params) {
+  cancelJobs();
+  resident_.clear();
+  params_ = params;
+  levels_ = 0;
+  while ((chunk_size << levels_) < params.resolution)
+    ++levels_;
+  params_.resolution = chunk_size << levels_;
+  height_bound_ = terrainHeightBound(params_);
+  const u32 side = chunk_size + 1;
+  vertices_per_chunk_ = side * side + 4 * side;
+  if (!vao_) {
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glGenBuffers(1, &ibo_);
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glBufferData(GL_ARRAY_BUFFER, size_t(slot_count_) * vertices_per_chunk_ * terrain_vertex_stride * sizeof(f32),
+                 nullptr, GL_DYNAMIC_DRAW);
+    // position, normal, uv, tangent, bitangent
+    const u32 components[] = {3, 3, 2, 3, 3};
+    for (u32 i = 0, offset = 0; i < 5; offset += components[i++]) {
+      glEnableVertexAttribArray(i);
+      glVertexAttribPointer(i, components[i], GL_FLOAT, GL_FALSE, terrain_vertex_stride * sizeof(f32),
+                            reinterpret_cast<const void *>(static_cast<uintptr_t>(offset * sizeof(f32))));
+    }
+    // grid, then skirts along z = 0, z = 1, x = 0 and x = 1
+    std::vector<u16> indices;
+    for (u32 r = 0; r < chunk_size; ++r)
+      for (u32 c = 0; c < chunk_size; ++c) {
+        u16 a = r * side + c, b = a + side;
+        indices.insert(indices.end(), {a, b, u16(a + 1), u16(a + 1), b, u16(b + 1)});
+      }
+    const u32 skirt = side * side;
+    for (u32 i = 0; i < chunk_size; ++i) {
+      u16 a, b, sa, sb;
+      a = i, b = i + 1, sa = skirt + i, sb = sa + 1;
+      indices.insert(indices.end(), {a, b, sa, b, sb, sa});
+      a = chunk_size * side + i, b = a + 1, sa = skirt + side + i, sb = sa + 1;
+      indices.insert(indices.end(), {a, sa, b, b, sa, sb});
+      a = i * side, b = a + side, sa = skirt + 2 * side + i, sb = sa + 1;
+      indices.insert(indices.end(), {a, sa, b, b, sa, sb});
+      a = i * side + chunk_size, b = a + side, sa = skirt + 3 * side + i, sb = sa + 1;
+      indices.insert(indices.end(), {a, b, sa, b, sb, sa});
+    }
+    index_count_ = static_cast<u32>(indices.size());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u16), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+  }
+  free_slots_.clear();
+  for (u32 i = slot_count_; i > 0; --i)
+    free_slots_.emplace_back(i - 1);
+}
+
+u64 TerrainRenderer::key(u32 level, u32 x, u32 z) const {
+  return u64(level) << 48 | u64(x) << 24 | z;
+}
+
+void TerrainRenderer::bounds(u32 level, u32 x, u32 z, f32 box_min[3], f32 box_max[3]) const {
+  const f32 node = params_.size * static_cast<f32>(chunk_size << level) / params_.resolution;
+  box_min[0] = -0.5f * params_.size + x * node;
+  box_min[2] = -0.5f * params_.size + z * node;
+  box_max[0] = box_min[0] + node;
+  box_max[2] = box_min[2] + node;
+  box_min[1] = -height_bound_;
+  box_max[1] = height_bound_;
+}
+
+bool TerrainRenderer::ready(u32 level, u32 x, u32 z) {
+  f32 box_min[3], box_max[3];
+  bounds(level, x, z, box_min, box_max);
+  if (!frustum_.intersects(box_min, box_max))
+    return true;
+  auto it = resident_.find(key(level, x, z));
+  if (it == resident_.end()) {
+    request(level, x, z);
+    return false;
+  }
+  it->second.last_used = frame_;
+  return true;
+}
+
+void TerrainRenderer::visit(u32 level, u32 x, u32 z) {
+  f32 box_min[3], box_max[3];
+  bounds(level, x, z, box_min, box_max);
+  if (!frustum_.intersects(box_min, box_max)) {
+    stats_.culled_nodes++;
+    return;
+  }
+  f32 distance2 = 0;
+  for (int k = 0; k < 3; ++k) {
+    f32 d = std::max({box_min[k] - eye_[k], 0.f, eye_[k] - box_max[k]});
+    distance2 += d * d;
+  }
+  f32 split_distance = lod_distance * (box_max[0] - box_min[0]);
+  if (level > 0 && distance2 < split_distance * split_distance) {
+    // evaluate all children, so missing ones are requested together
+    bool children_ready = true;
+    for (u32 c = 0; c < 4; ++c)
+      children_ready = ready(level - 1, 2 * x + (c & 1), 2 * z + (c >> 1)) && children_ready;
+    if (children_ready) {
+      for (u32 c = 0; c < 4; ++c)
+        visit(level - 1, 2 * x + (c & 1), 2 * z + (c >> 1));
+      return;
+    }
+  }
+  auto it = resident_.find(key(level, x, z));
+  if (it == resident_.end()) {
+    request(level, x, z);
+    return;
+  }
+  it->second.last_used = frame_;
+  glDrawElementsBaseVertex(GL_TRIANGLES, index_count_, GL_UNSIGNED_SHORT, nullptr,
+                           static_cast<GLint>(it->second.slot * vertices_per_chunk_));
+  stats_.drawn_chunks++;
+  stats_.triangles += index_count_ / 3;
+}
+
+void TerrainRenderer::request(u32 level, u32 x, u32 z) {
+  u64 k = key(level, x, z);
+  // keep the queue short, so it follows the camera
+  if (pending_.count(k) || pending_.size() >= 4 * pool_.size())
+    return;
+  pending_.insert(k);
+  const f32 step = static_cast<f32>(1u << level) / params_.resolution;
+  const f32 u0 = x * chunk_size * step, v0 = z * chunk_size * step;
+  // skirts hang deep enough to cover the height error between levels
+  const f32 skirt_depth = std::min(height_bound_, params_.size * step * chunk_size * 0.25f);
+  jobs_.emplace_back(pool_.submit([this, k, u0, v0, step, skirt_depth] {
+    const u32 side = chunk_size + 1;
+    Generated chunk;
+    chunk.key = k;
+    generateTerrainChunk(params_, u0, v0, step, side, chunk.vertex_data);
+    chunk.vertex_data.resize(size_t(vertices_per_chunk_) * terrain_vertex_stride);
+    f32 *skirt = chunk.vertex_data.data() + size_t(side) * side * terrain_vertex_stride;
+    auto copy = [&](u32 r, u32 c) {
+      std::copy_n(chunk.vertex_data.data() + size_t(r * side + c) * terrain_vertex_stride, terrain_vertex_stride,
+                  skirt);
+      skirt[1] -= skirt_depth;
+      skirt += terrain_vertex_stride;
+    };
+    for (u32 i = 0; i < side; ++i)
+      copy(0, i);
+    for (u32 i = 0; i < side; ++i)
+      copy(chunk_size, i);
+    for (u32 i = 0; i < side; ++i)
+      copy(i, 0);
+    for (u32 i = 0; i < side; ++i)
+      copy(i, chunk_size);
+    std::lock_guard<std::mutex> guard(mutex_);
+    generated_.emplace_back(std::move(chunk));
+  }));
+}
+
+u32 TerrainRenderer::allocateSlot() {
+  if (!free_slots_.empty()) {
+    u32 slot = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+  }
+  // chunks drawn in the previous frame are kept, or the view would flicker
+  auto lru = resident_.end();
+  for (auto it = resident_.begin(); it != resident_.end(); ++it)
+    if (it->second.last_used + 1 < frame_ && (lru == resident_.end() || it->second.last_used < lru->second.last_used))
+      lru = it;
+  if (lru == resident_.end())
+    return slot_count_;
+  u32 slot = lru->second.slot;
+  resident_.erase(lru);
+  return slot;
+}
+
+void TerrainRenderer::uploadGenerated() {
+  std::vector<Generated> generated;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    generated.swap(generated_);
+  }
+  if (generated.empty())
+    return;
+  glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+  const size_t chunk_bytes = size_t(vertices_per_chunk_) * terrain_vertex_stride * sizeof(f32);
+  u32 uploads = 0;
+  std::vector<Generated> deferred;
+  for (auto &chunk : generated) {
+    if (uploads == uploads_per_frame) {
+      deferred.emplace_back(std::move(chunk));
+      continue;
+    }
+    u32 slot = allocateSlot();
+    if (slot == slot_count_) {
+      // every slot is in use, the traversal asks again if still needed
+      pending_.erase(chunk.key);
+      continue;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, slot * chunk_bytes, chunk_bytes, chunk.vertex_data.data());
+    resident_[chunk.key] = {slot, frame_};
+    pending_.erase(chunk.key);
+    uploads++;
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  if (!deferred.empty()) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::move(deferred.begin(), deferred.end(), std::back_inserter(generated_));
+  }
+}
+
+void TerrainRenderer::draw(const f32 view_projection[4][4], const f32 eye[3]) {
+  if (!vao_)
+    return;
+  ++frame_;
+  jobs_.erase(std::remove_if(jobs_.begin(), jobs_.end(), [](const std::future<void> &job) {
+    return job.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }), jobs_.end());
+  uploadGenerated();
+  frustum_.set(view_projection);
+  std::copy_n(eye, 3, eye_);
+  stats_ = Stats();
+  glBindVertexArray(vao_);
+  visit(levels_, 0, 0);
+  glBindVertexArray(0);
+  stats_.resident_chunks = static_cast<u32>(resident_.size());
+  stats_.pending_chunks = static_cast<u32>(pending_.size());
+}
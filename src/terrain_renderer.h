@@ -0,0 +1,133 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file terrain_renderer.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Chunked quadtree terrain with continuous level of detail.
+
+#ifndef GLSL_EXPERIMENTS_TERRAIN_RENDERER_H
+#define GLSL_EXPERIMENTS_TERRAIN_RENDERER_H
+
+#include "terrain.h"
+
+#include <circe/circe.h>
+#include <unordered_map>
+#include <unordered_set>
+
+/// Six planes extracted from a view projection matrix
+struct Frustum {
+  /// \param m **[in]** projection * view, row major (ponos convention)
+  void set(const f32 m[4][4]);
+  /// \return false if the box is completely outside
+  [[nodiscard]] bool intersects(const f32 box_min[3], const f32 box_max[3]) const;
+  f32 planes[6][4]{};
+};
+
+/// Draws a procedural heightfield as a quadtree of chunks. Every chunk, at
+/// any level, is a grid of chunk_size x chunk_size quads, so deeper levels
+/// sample the terrain more densely. All chunks share one index buffer
+/// (grid + skirts hiding cracks between levels) and live in fixed slots of
+/// a single vertex buffer, so each chunk is one glDrawElementsBaseVertex.
+///
+/// Chunks are generated by the thread pool when the traversal first asks for
+/// them. Until all four children of a node are available the node itself is
+/// drawn, and the least recently used chunks are evicted when slots run out.
+class TerrainRenderer {
+public:
+  struct Stats {
+    u32 drawn_chunks{0};
+    u32 culled_nodes{0};
+    u64 triangles{0};
+    u32 resident_chunks{0};
+    u32 pending_chunks{0};
+  };
+  static constexpr u32 chunk_size = 64;
+  /// \param pool **[in | optional]** chunk generation workers
+  /// \param slot_count **[in | optional]** maximum chunks kept on the GPU
+  explicit TerrainRenderer(ThreadPool &pool = ThreadPool::global(), u32 slot_count = 512);
+  ~TerrainRenderer();
+  TerrainRenderer(const TerrainRenderer &) = delete;
+  TerrainRenderer &operator=(const TerrainRenderer &) = delete;
+  /// Drops every chunk and starts over with new terrain parameters.
+  /// params.resolution is rounded up to chunk_size times a power of 2.
+  void setup(const TerrainParams &params);
+  /// Selects, culls and draws the chunks for this view. Expects the shader
+  /// program to be bound already.
+  /// \param view_projection **[in]** projection * view, row major
+  /// \param eye **[in]** camera position
+  void draw(const f32 view_projection[4][4], const f32 eye[3]);
+  void destroy();
+  [[nodiscard]] bool empty() const { return !vao_; }
+  [[nodiscard]] const TerrainParams &params() const { return params_; }
+  [[nodiscard]] const Stats &stats() const { return stats_; }
+  /// A node is split while the camera is closer than lod_distance times its size
+  f32 lod_distance{2};
+  /// Chunks uploaded per draw call at most
+  u32 uploads_per_frame{8};
+
+private:
+  struct Chunk {
+    u32 slot{0};
+    u64 last_used{0};
+  };
+  struct Generated {
+    u64 key{0};
+    std::vector<f32> vertex_data;
+  };
+  [[nodiscard]] u64 key(u32 level, u32 x, u32 z) const;
+  void bounds(u32 level, u32 x, u32 z, f32 box_min[3], f32 box_max[3]) const;
+  /// \return true if the node is renderable now (visible and resident, or culled)
+  bool ready(u32 level, u32 x, u32 z);
+  void visit(u32 level, u32 x, u32 z);
+  void request(u32 level, u32 x, u32 z);
+  void uploadGenerated();
+  /// Waits for running jobs and drops their results
+  void cancelJobs();
+  /// \return a free slot, evicting the least recently used chunk if needed
+  /// (never one used in this frame); slot_count_ if none
+  u32 allocateSlot();
+
+  ThreadPool &pool_;
+  TerrainParams params_;
+  u32 levels_{0}; //!< root level, leaves are level 0
+  u32 slot_count_;
+  u32 vertices_per_chunk_{0};
+  u32 index_count_{0};
+  GLuint vao_{0};
+  GLuint vbo_{0};
+  GLuint ibo_{0};
+  std::unordered_map<u64, Chunk> resident_;
+  std::vector<u32> free_slots_;
+  std::unordered_set<u64> pending_;
+  // written by generation jobs
+  std::mutex mutex_;
+  std::vector<Generated> generated_;
+  std::vector<std::future<void>> jobs_;
+  u64 frame_{0};
+  f32 height_bound_{0};
+  Frustum frustum_;
+  f32 eye_[3]{};
+  Stats stats_;
+};
+
+#endif //GLSL_EXPERIMENTS_TERRAIN_RENDERER_H
@@ -0,0 +1,167 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file texture_cache.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "texture_cache.h"
+#include "hash.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+namespace {
+
+u64 alignUp(u64 offset) {
+  return (offset + texture_file_alignment - 1) / texture_file_alignment * texture_file_alignment;
+}
+
+}
+
+bool writeTextureFile(const std::string &path, const Image &image, u64 source_hash) {
+  if (image.levels.empty() || image.levels.size() > TextureFileHeader::max_levels)
+    return false;
+  TextureFileHeader header;
+  header.version = texture_file_version;
+  header.source_hash = source_hash;
+  header.format = static_cast<u32>(image.format);
+  header.level_count = static_cast<u32>(image.levels.size());
+  u64 offset = sizeof(TextureFileHeader);
+  for (u32 i = 0; i < header.level_count; ++i) {
+    offset = alignUp(offset);
+    header.levels[i].width = image.levels[i].width;
+    header.levels[i].height = image.levels[i].height;
+    header.levels[i].offset = offset;
+    header.levels[i].size = image.levels[i].size;
+    offset += image.levels[i].size;
+  }
+  // several threads may import the same image, each one writes its own file
+  auto tmp_path = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+  FILE *file = fopen(tmp_path.c_str(), "wb");
+  if (!file)
+    return false;
+  const u8 padding[texture_file_alignment] = {};
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  u64 end = sizeof(header);
+  for (u32 i = 0; ok && i < header.level_count; ++i) {
+    const auto &level = header.levels[i];
+    ok = fwrite(padding, 1, level.offset - end, file) == level.offset - end
+        && fwrite(image.data.data() + image.levels[i].offset, 1, level.size, file) == level.size;
+    end = level.offset + level.size;
+  }
+  ok = fclose(file) == 0 && ok;
+  std::error_code ec;
+  if (ok)
+    std::filesystem::rename(tmp_path, path, ec);
+  else
+    std::filesystem::remove(tmp_path, ec);
+  return ok && !ec;
+}
+
+bool readTextureFile(const std::string &path, Image &image, u64 &source_hash) {
+  MappedFile file;
+  if (!file.open(path) || file.size() < sizeof(TextureFileHeader))
+    return false;
+  TextureFileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, "GTEX", 4) != 0 || header.version != texture_file_version
+      || header.format > static_cast<u32>(PixelFormat::BC5)
+      || !header.level_count || header.level_count > TextureFileHeader::max_levels)
+    return false;
+  image.format = static_cast<PixelFormat>(header.format);
+  image.generate_mipmaps = false;
+  image.levels.resize(header.level_count);
+  size_t total = 0;
+  for (u32 i = 0; i < header.level_count; ++i) {
+    const auto &level = header.levels[i];
+    if (level.offset + level.size > file.size())
+      return false;
+    image.levels[i].width = level.width;
+    image.levels[i].height = level.height;
+    image.levels[i].offset = total;
+    image.levels[i].size = level.size;
+    total += level.size;
+  }
+  image.data.resize(total);
+  for (u32 i = 0; i < header.level_count; ++i)
+    std::memcpy(image.data.data() + image.levels[i].offset, file.data() + header.levels[i].offset,
+                header.levels[i].size);
+  source_hash = header.source_hash;
+  return true;
+}
+
+bool isNormalMapPath(const std::string &path) {
+  auto name = std::filesystem::path(path).stem().string();
+  std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+  auto endsWith = [&](const std::string &suffix) {
+    return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+  };
+  return name.find("normal") != std::string::npos || endsWith("_n") || endsWith("_nrm");
+}
+
+TextureCache::TextureCache(std::string directory) : directory_(std::move(directory)) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+}
+
+std::string TextureCache::filename(const std::string &path, u64 *source_hash) const {
+  MappedFile source;
+  if (!source.open(path))
+    return "";
+  bool normal_map = isNormalMapPath(path);
+  u64 h = hash_combine(hash_bytes(source.data(), source.size()), normal_map);
+  if (source_hash)
+    *source_hash = h;
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.tex", static_cast<unsigned long long>(h));
+  return directory_ + "/" + name;
+}
+
+bool TextureCache::load(const std::string &path, Image &image, std::string &err, ThreadPool *pool) {
+  u64 source_hash = 0;
+  auto cache_path = filename(path, &source_hash);
+  if (cache_path.empty()) {
+    err = path + ": could not read file";
+    return false;
+  }
+  u64 cached_hash = 0;
+  if (readTextureFile(cache_path, image, cached_hash) && cached_hash == source_hash) {
+    hits++;
+    return true;
+  }
+  misses++;
+  Image rgba;
+  if (!decodeImage(path, rgba, err))
+    return false;
+  generateMipmaps(rgba);
+  compressImage(rgba, chooseCompressedFormat(rgba, isNormalMapPath(path)), image, pool);
+  // a failed write only means the next load imports again
+  writeTextureFile(cache_path, image, source_hash);
+  return true;
+}
@@ -0,0 +1,96 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file texture_cache.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Disk cache of block compressed textures.
+
+#ifndef GLSL_EXPERIMENTS_TEXTURE_CACHE_H
+#define GLSL_EXPERIMENTS_TEXTURE_CACHE_H
+
+#include "texture_compression.h"
+
+#include <atomic>
+
+/// File layout:
+///   TextureFileHeader
+///   level blobs, largest first (each aligned to texture_file_alignment)
+struct TextureFileHeader {
+  static constexpr u32 max_levels = 16;
+  struct Level {
+    u32 width{0};
+    u32 height{0};
+    u64 offset{0}; //!< from the beginning of the file
+    u64 size{0};
+  };
+  char magic[4]{'G', 'T', 'E', 'X'};
+  u32 version{0};
+  u64 source_hash{0}; //!< hash of the source file content and import options
+  u32 format{0};      //!< PixelFormat
+  u32 level_count{0};
+  Level levels[max_levels];
+};
+
+constexpr u32 texture_file_version = 1;
+constexpr u64 texture_file_alignment = 64;
+
+/// \param path **[in]** output file
+/// \param image **[in]**
+/// \param source_hash **[in]**
+/// \return false if the file could not be written
+bool writeTextureFile(const std::string &path, const Image &image, u64 source_hash);
+/// \param path **[in]** .tex file
+/// \param image **[out]**
+/// \param source_hash **[out]**
+/// \return false if missing, truncated or from another format version
+bool readTextureFile(const std::string &path, Image &image, u64 &source_hash);
+
+/// \param path **[in]** image file
+/// \return true if the name marks a normal map (ex: wall_normal.jpg, wall_n.png)
+bool isNormalMapPath(const std::string &path);
+
+/// Stores GPU ready (block compressed, full mip chain) versions of image
+/// files in a directory, keyed by the hash of the image file content. A miss
+/// decodes the image, generates its mips, compresses and stores it.
+class TextureCache {
+public:
+  /// \param directory **[in]** cache directory (created if missing)
+  explicit TextureCache(std::string directory);
+  /// Thread safe.
+  /// \param path **[in]** image file
+  /// \param image **[out]** compressed image
+  /// \param err **[out]**
+  /// \param pool **[in | optional]** used to compress on a miss (see compressImage)
+  /// \return false if the image could neither be read from the cache nor imported
+  bool load(const std::string &path, Image &image, std::string &err, ThreadPool *pool = nullptr);
+  /// \param path **[in]** image file
+  /// \return cache file path for the current content of **path**, empty if unreadable
+  [[nodiscard]] std::string filename(const std::string &path, u64 *source_hash = nullptr) const;
+
+  std::atomic<u32> hits{0};
+  std::atomic<u32> misses{0};
+private:
+  std::string directory_;
+};
+
+#endif //GLSL_EXPERIMENTS_TEXTURE_CACHE_H
@@ -0,0 +1,274 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file texture_compression.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "texture_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/// Averages 2x2 pixel blocks of **src** (w x h) into **dst**
+void downsample(const u8 *src, u32 w, u32 h, u8 *dst, u32 dw, u32 dh) {
+  for (u32 y = 0; y < dh; ++y) {
+    const u8 *r0 = src + size_t(std::min(2 * y, h - 1)) * w * 4;
+    const u8 *r1 = src + size_t(std::min(2 * y + 1, h - 1)) * w * 4;
+    u8 *out = dst + size_t(y) * dw * 4;
+    u32 x = 0;
+#ifdef __SSE2__
+    // 2 output pixels per iteration, from 4 pixels of each source row
+    if (w >= 2) {
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i two = _mm_set1_epi16(2);
+      for (; x + 2 <= dw && 2 * x + 4 <= w; x += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + 8 * x));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + 8 * x));
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+        __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), two), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 4 * x), _mm_packus_epi16(sum, zero));
+      }
+    }
+#endif
+    for (; x < dw; ++x) {
+      u32 x0 = std::min(2 * x, w - 1) * 4, x1 = std::min(2 * x + 1, w - 1) * 4;
+      for (u32 c = 0; c < 4; ++c)
+        out[4 * x + c] = static_cast<u8>((r0[x0 + c] + r0[x1 + c] + r1[x0 + c] + r1[x1 + c] + 2) / 4);
+    }
+  }
+}
+
+/// Copies the 4x4 block at (bx, by), repeating edge pixels
+void fetchBlock(const u8 *src, u32 w, u32 h, u32 bx, u32 by, u8 block[64]) {
+  for (u32 y = 0; y < 4; ++y) {
+    const u8 *row = src + size_t(std::min(4 * by + y, h - 1)) * w * 4;
+    for (u32 x = 0; x < 4; ++x)
+      std::memcpy(block + 16 * y + 4 * x, row + 4 * std::min(4 * bx + x, w - 1), 4);
+  }
+}
+
+u16 to565(const i32 c[3]) {
+  return static_cast<u16>(((c[0] * 31 + 127) / 255) << 11 | ((c[1] * 63 + 127) / 255) << 5 | ((c[2] * 31 + 127) / 255));
+}
+
+void from565(u16 v, i32 c[3]) {
+  i32 r = v >> 11 & 31, g = v >> 5 & 63, b = v & 31;
+  c[0] = r << 3 | r >> 2;
+  c[1] = g << 2 | g >> 4;
+  c[2] = b << 3 | b >> 2;
+}
+
+/// BC1 color block (always in 4 color mode, as required by BC3)
+void encodeColor(const u8 block[64], u8 *out) {
+  i32 lo[3] = {255, 255, 255}, hi[3] = {0, 0, 0}, mean[3] = {0, 0, 0};
+  for (u32 i = 0; i < 16; ++i)
+    for (u32 c = 0; c < 3; ++c) {
+      lo[c] = std::min<i32>(lo[c], block[4 * i + c]);
+      hi[c] = std::max<i32>(hi[c], block[4 * i + c]);
+      mean[c] += block[4 * i + c];
+    }
+  // pick the bounding box diagonal that follows the colors: flip red and blue
+  // when they are anti correlated with green
+  i32 cov_rg = 0, cov_bg = 0;
+  for (u32 i = 0; i < 16; ++i) {
+    i32 g = 16 * block[4 * i + 1] - mean[1];
+    cov_rg += (16 * block[4 * i] - mean[0]) * g;
+    cov_bg += (16 * block[4 * i + 2] - mean[2]) * g;
+  }
+  if (cov_rg < 0)
+    std::swap(lo[0], hi[0]);
+  if (cov_bg < 0)
+    std::swap(lo[2], hi[2]);
+  // inset the box, endpoints sit slightly inside the color range
+  for (u32 c = 0; c < 3; ++c) {
+    i32 inset = (hi[c] - lo[c]) / 16;
+    hi[c] -= inset;
+    lo[c] += inset;
+  }
+  u16 c0 = to565(hi), c1 = to565(lo);
+  if (c0 < c1)
+    std::swap(c0, c1);
+  u32 indices = 0;
+  if (c0 != c1) {
+    i32 palette[4][3];
+    from565(c0, palette[0]);
+    from565(c1, palette[1]);
+    for (u32 c = 0; c < 3; ++c) {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    for (u32 i = 0; i < 16; ++i) {
+      u32 best = 0;
+      i32 best_d = 1 << 30;
+      for (u32 p = 0; p < 4; ++p) {
+        i32 d = 0;
+        for (u32 c = 0; c < 3; ++c) {
+          i32 e = block[4 * i + c] - palette[p][c];
+          d += e * e;
+        }
+        if (d < best_d) {
+          best_d = d;
+          best = p;
+        }
+      }
+      indices |= best << (2 * i);
+    }
+  }
+  out[0] = c0 & 0xff;
+  out[1] = c0 >> 8;
+  out[2] = c1 & 0xff;
+  out[3] = c1 >> 8;
+  for (u32 i = 0; i < 4; ++i)
+    out[4 + i] = indices >> (8 * i) & 0xff;
+}
+
+/// BC4 block of **channel** (BC3 alpha, BC5 red/green)
+void encodeChannel(const u8 block[64], u32 channel, u8 *out) {
+  i32 a0 = 0, a1 = 255;
+  for (u32 i = 0; i < 16; ++i) {
+    a0 = std::max<i32>(a0, block[4 * i + channel]);
+    a1 = std::min<i32>(a1, block[4 * i + channel]);
+  }
+  u64 indices = 0;
+  if (a0 != a1) {
+    // 8 value mode: a0, a1, then 6 interpolated values from a0 to a1
+    i32 palette[8] = {a0, a1};
+    for (i32 p = 2; p < 8; ++p)
+      palette[p] = ((8 - p) * a0 + (p - 1) * a1 + 3) / 7;
+    for (u32 i = 0; i < 16; ++i) {
+      u64 best = 0;
+      i32 best_d = 256;
+      for (u32 p = 0; p < 8; ++p) {
+        i32 d = std::abs(block[4 * i + channel] - palette[p]);
+        if (d < best_d) {
+          best_d = d;
+          best = p;
+        }
+      }
+      indices |= best << (3 * i);
+    }
+  }
+  out[0] = static_cast<u8>(a0);
+  out[1] = static_cast<u8>(a1);
+  for (u32 i = 0; i < 6; ++i)
+    out[2 + i] = indices >> (8 * i) & 0xff;
+}
+
+void encodeBlock(const u8 block[64], PixelFormat format, u8 *out) {
+  switch (format) {
+  case PixelFormat::BC1: encodeColor(block, out);
+    break;
+  case PixelFormat::BC3: encodeChannel(block, 3, out);
+    encodeColor(block, out + 8);
+    break;
+  case PixelFormat::BC5: encodeChannel(block, 0, out);
+    encodeChannel(block, 1, out + 8);
+    break;
+  default: break;
+  }
+}
+
+}
+
+void generateMipmaps(Image &image) {
+  if (image.levels.empty() || image.format != PixelFormat::RGBA8)
+    return;
+  image.levels.resize(1);
+  size_t total = image.levels[0].size;
+  for (u32 w = image.width(), h = image.height(); w > 1 || h > 1;) {
+    w = std::max(w / 2, 1u);
+    h = std::max(h / 2, 1u);
+    ImageLevel level;
+    level.width = w;
+    level.height = h;
+    level.offset = total;
+    level.size = size_t(w) * h * 4;
+    total += level.size;
+    image.levels.emplace_back(level);
+  }
+  image.data.resize(total);
+  for (size_t i = 1; i < image.levels.size(); ++i) {
+    const auto &src = image.levels[i - 1];
+    const auto &dst = image.levels[i];
+    downsample(image.data.data() + src.offset, src.width, src.height,
+               image.data.data() + dst.offset, dst.width, dst.height);
+  }
+  image.generate_mipmaps = false;
+}
+
+PixelFormat chooseCompressedFormat(const Image &image, bool normal_map) {
+  if (normal_map)
+    return PixelFormat::BC5;
+  const auto &level = image.levels[0];
+  const u8 *pixels = image.data.data() + level.offset;
+  for (size_t i = 3; i < level.size; i += 4)
+    if (pixels[i] != 255)
+      return PixelFormat::BC3;
+  return PixelFormat::BC1;
+}
+
+void compressImage(const Image &rgba, PixelFormat format, Image &compressed, ThreadPool *pool) {
+  compressed.format = format;
+  compressed.generate_mipmaps = rgba.generate_mipmaps;
+  compressed.levels.clear();
+  size_t total = 0;
+  for (const auto &src : rgba.levels) {
+    ImageLevel level;
+    level.width = src.width;
+    level.height = src.height;
+    level.offset = total;
+    level.size = rowBytes(format, src.width) * ((src.height + 3) / 4);
+    total += level.size;
+    compressed.levels.emplace_back(level);
+  }
+  compressed.data.resize(total);
+  const size_t block_size = format == PixelFormat::BC1 ? 8 : 16;
+  for (size_t l = 0; l < rgba.levels.size(); ++l) {
+    const auto &src = rgba.levels[l];
+    const u8 *pixels = rgba.data.data() + src.offset;
+    u8 *out = compressed.data.data() + compressed.levels[l].offset;
+    u32 blocks_x = (src.width + 3) / 4, blocks_y = (src.height + 3) / 4;
+    auto encodeRows = [&](size_t begin, size_t end) {
+      u8 block[64];
+      for (size_t by = begin; by < end; ++by)
+        for (u32 bx = 0; bx < blocks_x; ++bx) {
+          fetchBlock(pixels, src.width, src.height, bx, static_cast<u32>(by), block);
+          encodeBlock(block, format, out + (by * blocks_x + bx) * block_size);
+        }
+    };
+    if (pool)
+      pool->parallelFor(blocks_y, encodeRows, 16);
+    else
+      encodeRows(0, blocks_y);
+  }
+}
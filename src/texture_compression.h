@@ -0,0 +1,53 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file texture_compression.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief CPU mip generation and BC1/BC3/BC5 block compression.
+
+#ifndef GLSL_EXPERIMENTS_TEXTURE_COMPRESSION_H
+#define GLSL_EXPERIMENTS_TEXTURE_COMPRESSION_H
+
+#include "image.h"
+#include "thread_pool.h"
+
+/// Appends the full mip chain (down to 1x1) to a single level RGBA8 image.
+/// Each level is a 2x2 box filter of the previous one (SSE2 when available).
+/// \param image **[in/out]**
+void generateMipmaps(Image &image);
+
+/// \param image **[in]** RGBA8 image
+/// \param normal_map **[in]** the image holds tangent space normals
+/// \return BC5 for normal maps, BC1 for opaque images and BC3 otherwise
+PixelFormat chooseCompressedFormat(const Image &image, bool normal_map);
+
+/// Block compresses every level of an RGBA8 image with a fast range fit
+/// encoder. BC5 keeps the red and green channels only.
+/// \param rgba **[in]** RGBA8 image
+/// \param format **[in]** BC1, BC3 or BC5
+/// \param compressed **[out]**
+/// \param pool **[in | optional]** compress rows of blocks in parallel (must
+/// not be given when called from a job of the same pool)
+void compressImage(const Image &rgba, PixelFormat format, Image &compressed, ThreadPool *pool = nullptr);
+
+#endif //GLSL_EXPERIMENTS_TEXTURE_COMPRESSION_H
@@ -0,0 +1,88 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file texture_converter.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Imports the textures used by shader configs into the compressed texture cache.
+
+#include "texture_cache.h"
+
+#include <json11.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+/// \return image files referenced by a shader config ("t0", "t1", ...)
+std::vector<std::string> configTextures(const std::string &config) {
+  std::ifstream in(config);
+  std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  std::string err;
+  auto json = json11::Json::parse(text, err);
+  std::vector<std::string> textures;
+  for (const auto &item : json.object_items()) {
+    auto path = item.second["path"].string_value();
+    if (item.first[0] == 't' && !path.empty())
+      textures.emplace_back((std::filesystem::path(config).parent_path() / path).string());
+  }
+  return textures;
+}
+
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    printf("usage: %s [-o cache_dir] <config.json | image>...\n", argv[0]);
+    return -1;
+  }
+  std::string cache_dir = CACHE_PATH "/textures";
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-o" && i + 1 < argc)
+      cache_dir = argv[++i];
+    else if (std::filesystem::path(arg).extension() == ".json") {
+      auto textures = configTextures(arg);
+      inputs.insert(inputs.end(), textures.begin(), textures.end());
+    } else
+      inputs.emplace_back(arg);
+  }
+  TextureCache cache(cache_dir);
+  int result = 0;
+  for (const auto &input : inputs) {
+    Image image;
+    std::string err;
+    ponos::Timer timer;
+    u32 misses = cache.misses;
+    if (!cache.load(input, image, err, &ThreadPool::global())) {
+      printf("%s: %s\n", input.c_str(), err.c_str());
+      result = -1;
+      continue;
+    }
+    printf("%s -> %s\n  %ux%u %s, %zu levels, %.1f KB%s, %.1f ms\n", input.c_str(), cache.filename(input).c_str(),
+           image.width(), image.height(), pixelFormatName(image.format), image.levels.size(),
+           image.data.size() / 1024.0, cache.misses == misses ? " (cached)" : "", timer.tack());
+  }
+  return result;
+}
@@ -0,0 +1,246 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file texture_streamer.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "texture_streamer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace {
+
+GLenum internalFormat(PixelFormat format) {
+  switch (format) {
+  case PixelFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+  case PixelFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  case PixelFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+  default: return GL_RGBA8;
+  }
+}
+
+GLsizei mipCount(u32 width, u32 height) {
+  GLsizei count = 1;
+  while ((width | height) >> count)
+    ++count;
+  return count;
+}
+
+}
+
+TextureStreamer::TextureStreamer(ThreadPool &pool, u32 ring_size) : pool_(pool), ring_(std::max(ring_size, 1u)) {}
+
+TextureStreamer::~TextureStreamer() {
+  for (auto &f : decoding_)
+    f.wait();
+  for (auto &slot : ring_) {
+    if (slot.fence)
+      glDeleteSync(slot.fence);
+    if (slot.buffer)
+      glDeleteBuffers(1, &slot.buffer);
+  }
+  for (auto &job : uploads_)
+    if (job->texture)
+      glDeleteTextures(1, &job->texture);
+}
+
+void TextureStreamer::load(const std::string &path, Callback callback) {
+  auto job = std::make_unique<Job>();
+  job->path = path;
+  job->callback = std::move(callback);
+  ++in_flight_;
+  // std::function must be copyable, so the job travels as a raw pointer
+  auto *raw = job.release();
+  auto done = pool_.submit([this, raw] {
+    std::unique_ptr<Job> job(raw);
+    ponos::Timer timer;
+    if (cache)
+      cache->load(job->path, job->image, job->err);
+    else
+      decodeImage(job->path, job->image, job->err);
+    job->stats.decode_ms = timer.tack();
+    job->stats.format = job->image.format;
+    std::lock_guard<std::mutex> guard(mutex_);
+    decoded_.emplace_back(std::move(job));
+  });
+  std::lock_guard<std::mutex> guard(mutex_);
+  decoding_.emplace_back(std::move(done));
+}
+
+size_t TextureStreamer::pending() const {
+  return in_flight_;
+}
+
+void TextureStreamer::update() {
+  ponos::Timer timer;
+  frame_bytes_ = 0;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto &job : decoded_)
+      uploads_.emplace_back(std::move(job));
+    decoded_.clear();
+    decoding_.erase(std::remove_if(decoding_.begin(), decoding_.end(), [](const std::future<void> &f) {
+      return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), decoding_.end());
+  }
+  if (uploads_.empty()) {
+    frame_ms_ = 0;
+    return;
+  }
+  size_t budget = frame_budget;
+  bool progress = true;
+  while (!uploads_.empty() && progress) {
+    auto &job = *uploads_.front();
+    if (!job.err.empty() || job.image.levels.empty()) {
+      finish(job);
+      uploads_.pop_front();
+      continue;
+    }
+    ponos::Timer job_timer;
+    size_t before = budget;
+    bool done = false;
+    while (!done && budget) {
+      size_t b = budget;
+      done = !uploadBand(job, budget);
+      if (b == budget)
+        break; // ring is busy
+    }
+    progress = budget != before || done;
+    job.stats.upload_ms += job_timer.tack();
+    job.stats.upload_frames += budget != before;
+    frame_bytes_ += before - budget;
+    if (done) {
+      finish(job);
+      uploads_.pop_front();
+    }
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  frame_ms_ = timer.tack();
+}
+
+bool TextureStreamer::uploadBand(Job &job, size_t &budget) {
+  const auto &image = job.image;
+  if (!job.texture) {
+    GLsizei levels = static_cast<GLsizei>(image.levels.size());
+    if (image.generate_mipmaps)
+      levels = std::max(levels, mipCount(image.width(), image.height()));
+    glGenTextures(1, &job.texture);
+    glBindTexture(GL_TEXTURE_2D, job.texture);
+    glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat(image.format), image.width(), image.height());
+  }
+  auto &slot = ring_[next_slot_];
+  if (slot.fence) {
+    if (glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+      return true;
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+  }
+  const auto &level = image.levels[job.level];
+  const u32 row_height = rowHeight(image.format);
+  const size_t row_bytes = rowBytes(image.format, level.width);
+  const size_t row_count = (level.height + row_height - 1) / row_height;
+  size_t rows = std::min(row_count - job.row, std::max<size_t>(budget / row_bytes, 1));
+  size_t size = rows * row_bytes;
+  if (!slot.buffer)
+    glGenBuffers(1, &slot.buffer);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+  if (slot.capacity < size) {
+    slot.capacity = std::max(size, frame_budget / ring_.size());
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, slot.capacity, nullptr, GL_STREAM_DRAW);
+  }
+  void *dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                               GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+  if (!dst) {
+    job.err = job.path + ": could not map pixel buffer";
+    return false;
+  }
+  std::memcpy(dst, image.data.data() + level.offset + job.row * row_bytes, size);
+  glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+  GLint y = static_cast<GLint>(job.row * row_height);
+  GLsizei height = static_cast<GLsizei>(std::min<size_t>(rows * row_height, level.height - y));
+  glBindTexture(GL_TEXTURE_2D, job.texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  if (isCompressed(image.format))
+    glCompressedTexSubImage2D(GL_TEXTURE_2D, job.level, 0, y, level.width, height,
+                              internalFormat(image.format), size, nullptr);
+  else
+    glTexSubImage2D(GL_TEXTURE_2D, job.level, 0, y, level.width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  next_slot_ = (next_slot_ + 1) % ring_.size();
+  budget -= std::min(budget, size);
+  job.stats.bytes += size;
+  job.row += rows;
+  if (job.row == row_count) {
+    job.row = 0;
+    ++job.level;
+  }
+  return job.level < image.levels.size();
+}
+
+bool compressedTexturesSupported() {
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i = 0; i < count; ++i) {
+    auto *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+    // RGTC (BC5) is core since GL 3.0
+    if (name && std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+      return true;
+  }
+  return false;
+}
+
+void TextureStreamer::finish(Job &job) {
+  if (job.texture) {
+    glBindTexture(GL_TEXTURE_2D, job.texture);
+    if (!job.err.empty()) {
+      glDeleteTextures(1, &job.texture);
+      job.texture = 0;
+    } else {
+      if (job.image.generate_mipmaps) {
+        ponos::Timer timer;
+        glGenerateMipmap(GL_TEXTURE_2D);
+        job.stats.upload_ms += timer.tack();
+      } else
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(job.image.levels.size()) - 1);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+  job.stats.total_ms = job.timer.tack();
+  --in_flight_;
+  if (job.callback)
+    job.callback(job.texture, job.stats, job.err);
+}
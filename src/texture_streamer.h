@@ -0,0 +1,127 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file texture_streamer.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Asynchronous texture loading.
+
+#ifndef GLSL_EXPERIMENTS_TEXTURE_STREAMER_H
+#define GLSL_EXPERIMENTS_TEXTURE_STREAMER_H
+
+#include "texture_cache.h"
+
+#include <circe/circe.h>
+#include <atomic>
+#include <memory>
+
+/// Loads textures without stalling the render loop.
+/// Files are decoded by a thread pool. Decoded images are then uploaded from
+/// the GL thread in row bands, through a ring of pixel buffer objects, never
+/// moving more than frame_budget bytes per frame. A band is only written into
+/// a PBO after the GPU finished reading its previous content (fence), so the
+/// copy never waits for the driver.
+///
+/// Usage:
+///   TextureStreamer streamer;
+///   streamer.load("file.jpg", [](GLuint texture, const TextureStreamer::Stats &stats, const std::string &err) {});
+///   // every frame, on the GL thread
+///   streamer.update();
+class TextureStreamer {
+public:
+  struct Stats {
+    f64 decode_ms{0}; //!< time spent decoding (worker thread)
+    f64 upload_ms{0}; //!< time spent copying and issuing uploads (GL thread)
+    f64 total_ms{0};  //!< from load() to completion
+    u32 upload_frames{0};
+    size_t bytes{0};
+    PixelFormat format{PixelFormat::RGBA8};
+  };
+  /// Called from update(). On success **texture** is a complete texture
+  /// owned by the callee; on failure it is 0 and **err** says why.
+  using Callback = std::function<void(GLuint texture, const Stats &stats, const std::string &err)>;
+  /// \param pool **[in | optional]** decode threads
+  /// \param ring_size **[in | optional]** number of PBOs
+  explicit TextureStreamer(ThreadPool &pool = ThreadPool::global(), u32 ring_size = 3);
+  /// Waits for pending decodes
+  ~TextureStreamer();
+  TextureStreamer(const TextureStreamer &) = delete;
+  TextureStreamer &operator=(const TextureStreamer &) = delete;
+  /// Schedules **path** for decoding. Thread safe.
+  /// \param path **[in]** image file
+  /// \param callback **[in]**
+  void load(const std::string &path, Callback callback);
+  /// Uploads pending images within the frame budget and fires callbacks of
+  /// the completed ones. Must be called from the GL thread.
+  void update();
+  /// \return number of textures not yet completed
+  [[nodiscard]] size_t pending() const;
+  /// \return bytes uploaded by the last update()
+  [[nodiscard]] size_t frameBytes() const { return frame_bytes_; }
+  /// \return time spent by the last update()
+  [[nodiscard]] f64 frameMs() const { return frame_ms_; }
+  /// Maximum bytes uploaded per update(). At least one band is always
+  /// uploaded, so rows wider than the budget still make progress.
+  size_t frame_budget{8u << 20};
+  /// When set, images are loaded through the cache of compressed textures
+  /// instead of being decoded
+  TextureCache *cache{nullptr};
+
+private:
+  struct Job {
+    std::string path;
+    Callback callback;
+    Image image;
+    std::string err;
+    Stats stats;
+    ponos::Timer timer;
+    GLuint texture{0};
+    size_t level{0}; //!< level being uploaded
+    size_t row{0};   //!< next data row of level
+  };
+  struct PboSlot {
+    GLuint buffer{0};
+    size_t capacity{0};
+    GLsync fence{nullptr};
+  };
+  /// \return false if the job is done
+  bool uploadBand(Job &job, size_t &budget);
+  void finish(Job &job);
+
+  ThreadPool &pool_;
+  std::vector<PboSlot> ring_;
+  size_t next_slot_{0};
+  std::deque<std::unique_ptr<Job>> uploads_;
+  // filled by decode workers
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Job>> decoded_;
+  std::vector<std::future<void>> decoding_;
+  std::atomic<size_t> in_flight_{0};
+  size_t frame_bytes_{0};
+  f64 frame_ms_{0};
+};
+
+/// \return true if the context can sample every format compressImage produces.
+/// Requires a current GL context.
+bool compressedTexturesSupported();
+
+#endif //GLSL_EXPERIMENTS_TEXTURE_STREAMER_H
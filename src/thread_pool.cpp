@@ -0,0 +1,94 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file thread_pool.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(u32 thread_count) {
+  if (!thread_count)
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  for (u32 i = 0; i < thread_count; ++i)
+    workers_.emplace_back([this] {
+      while (true) {
+        std::packaged_task<void()> job;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          condition_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+          if (stop_ && jobs_.empty())
+            return;
+          job = std::move(jobs_.front());
+          jobs_.pop_front();
+        }
+        job();
+      }
+    });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (auto &worker : workers_)
+    worker.join();
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> job) {
+  std::packaged_task<void()> task(std::move(job));
+  auto future = task.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.emplace_back(std::move(task));
+  }
+  condition_.notify_one();
+  return future;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)> &f, size_t min_grain) {
+  if (!count)
+    return;
+  size_t range_count = std::min<size_t>(size(), (count + min_grain - 1) / std::max<size_t>(min_grain, 1));
+  if (range_count <= 1) {
+    f(0, count);
+    return;
+  }
+  size_t range_size = (count + range_count - 1) / range_count;
+  std::vector<std::future<void>> ranges;
+  for (size_t begin = 0; begin < count; begin += range_size) {
+    size_t end = std::min(count, begin + range_size);
+    ranges.emplace_back(submit([&f, begin, end] { f(begin, end); }));
+  }
+  for (auto &range : ranges)
+    range.get();
+}
+
+ThreadPool &ThreadPool::global() {
+  static ThreadPool pool;
+  return pool;
+}
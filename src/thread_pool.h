@@ -0,0 +1,76 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file thread_pool.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Fixed-size worker pool for CPU-side jobs.
+
+#ifndef GLSL_EXPERIMENTS_THREAD_POOL_H
+#define GLSL_EXPERIMENTS_THREAD_POOL_H
+
+#include <ponos/ponos.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed set of worker threads consuming a FIFO of jobs.
+///
+/// Usage:
+///   ThreadPool pool;
+///   auto done = pool.submit([] { ... });
+///   pool.parallelFor(n, [&](size_t begin, size_t end) { ... });
+///
+/// parallelFor blocks the caller, so it must not be called from inside a job.
+class ThreadPool {
+public:
+  /// \param thread_count **[in | optional]** 0 means one per hardware thread
+  explicit ThreadPool(u32 thread_count = 0);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  /// \param job **[in]**
+  /// \return future signaled when **job** finishes
+  std::future<void> submit(std::function<void()> job);
+  /// Splits [0, count) into one contiguous range per worker and waits for all
+  /// of them.
+  /// \param count **[in]** number of items
+  /// \param f **[in]** called as f(begin, end)
+  /// \param min_grain **[in | optional]** minimum items per range
+  void parallelFor(size_t count, const std::function<void(size_t, size_t)> &f, size_t min_grain = 1);
+  [[nodiscard]] u32 size() const { return static_cast<u32>(workers_.size()); }
+  /// \return pool shared by the whole application
+  static ThreadPool &global();
+
+private:
+  std::vector<std::thread> workers_;
+  std::deque<std::packaged_task<void()>> jobs_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_{false};
+};
+
+#endif //GLSL_EXPERIMENTS_THREAD_POOL_H
@@ -0,0 +1,147 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file uniform_binding_table.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "uniform_binding_table.h"
+
+#include <cstring>
+
+namespace {
+
+u32 uniformTypeSize(GLenum type) {
+  switch (type) {
+  case GL_INT:
+  case GL_BOOL:
+  case GL_SAMPLER_2D:
+  case GL_SAMPLER_CUBE:
+  case GL_FLOAT: return 4;
+  case GL_FLOAT_VEC2: return 8;
+  case GL_FLOAT_VEC3: return 12;
+  case GL_FLOAT_VEC4: return 16;
+  case GL_FLOAT_MAT4: return 64;
+  default: return 0;
+  }
+}
+
+}
+
+int UniformBindingTable::add(GLint location, GLenum type) {
+  auto size = uniformTypeSize(type);
+  if (location < 0 || !size)
+    return -1;
+  Binding binding;
+  binding.location = location;
+  binding.type = type;
+  binding.offset = static_cast<u32>(arena_.size());
+  binding.size = size;
+  arena_.resize(arena_.size() + size, 0);
+  bindings_.emplace_back(binding);
+  return static_cast<int>(bindings_.size()) - 1;
+}
+
+void UniformBindingTable::clear() {
+  bindings_.clear();
+  arena_.clear();
+}
+
+void UniformBindingTable::invalidate() {
+  for (auto &b : bindings_)
+    b.dirty = true;
+}
+
+void UniformBindingTable::set(int binding, int value) {
+  write(binding, &value, sizeof(value));
+}
+
+void UniformBindingTable::set(int binding, f32 value) {
+  write(binding, &value, sizeof(value));
+}
+
+void UniformBindingTable::set(int binding, const ponos::vec2 &value) {
+  f32 v[2] = {static_cast<f32>(value.x), static_cast<f32>(value.y)};
+  write(binding, v, sizeof(v));
+}
+
+void UniformBindingTable::set(int binding, const ponos::vec3 &value) {
+  f32 v[3] = {static_cast<f32>(value.x), static_cast<f32>(value.y), static_cast<f32>(value.z)};
+  write(binding, v, sizeof(v));
+}
+
+void UniformBindingTable::set(int binding, const ponos::point3 &value) {
+  f32 v[3] = {static_cast<f32>(value.x), static_cast<f32>(value.y), static_cast<f32>(value.z)};
+  write(binding, v, sizeof(v));
+}
+
+void UniformBindingTable::set(int binding, const ponos::mat4 &value) {
+  f32 m[16];
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      m[i * 4 + j] = static_cast<f32>(value.m[i][j]);
+  write(binding, m, sizeof(m));
+}
+
+u32 UniformBindingTable::upload() {
+  u32 call_count = 0;
+  for (auto &b : bindings_) {
+    if (!b.dirty)
+      continue;
+    const auto *data = arena_.data() + b.offset;
+    const auto *f = reinterpret_cast<const f32 *>(data);
+    switch (b.type) {
+    case GL_INT:
+    case GL_BOOL:
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_CUBE: glUniform1iv(b.location, 1, reinterpret_cast<const GLint *>(data));
+      break;
+    case GL_FLOAT: glUniform1fv(b.location, 1, f);
+      break;
+    case GL_FLOAT_VEC2: glUniform2fv(b.location, 1, f);
+      break;
+    case GL_FLOAT_VEC3: glUniform3fv(b.location, 1, f);
+      break;
+    case GL_FLOAT_VEC4: glUniform4fv(b.location, 1, f);
+      break;
+    case GL_FLOAT_MAT4: glUniformMatrix4fv(b.location, 1, GL_FALSE, f);
+      break;
+    default: break;
+    }
+    b.dirty = false;
+    call_count++;
+  }
+  return call_count;
+}
+
+void UniformBindingTable::write(int binding, const void *data, u32 size) {
+  if (binding < 0)
+    return;
+  auto &b = bindings_[binding];
+  auto *dst = arena_.data() + b.offset;
+  // a type mismatch between shader and value is ignored, like GL would
+  if (size != b.size || !std::memcmp(dst, data, size))
+    return;
+  std::memcpy(dst, data, size);
+  b.dirty = true;
+}
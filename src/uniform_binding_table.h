@@ -0,0 +1,77 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file uniform_binding_table.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Location-cached uniform values with dirty tracking.
+
+#ifndef GLSL_EXPERIMENTS_UNIFORM_BINDING_TABLE_H
+#define GLSL_EXPERIMENTS_UNIFORM_BINDING_TABLE_H
+
+#include <circe/circe.h>
+
+/// Uniforms of a linked program resolved once into a contiguous table. Values
+/// are written into a single arena and only the ones that changed since the
+/// last upload reach GL.
+///
+/// Usage:
+///   int b = table.add(program.locateUniform("model"), GL_FLOAT_MAT4);
+///   ... every frame
+///   table.set(b, matrix);
+///   table.upload(); // program must be in use
+class UniformBindingTable {
+public:
+  struct Binding {
+    GLint location{-1};
+    GLenum type{0};
+    u32 offset{0}; //!< in the value arena, in bytes
+    u32 size{0};   //!< in bytes
+    bool dirty{true};
+  };
+  /// \param location **[in]** uniform location
+  /// \param type **[in]** GL uniform type
+  /// \return binding index, -1 if **location** is invalid or **type** unsupported
+  int add(GLint location, GLenum type);
+  void clear();
+  /// Marks every binding for upload (ex: after the program was relinked)
+  void invalidate();
+  void set(int binding, int value);
+  void set(int binding, f32 value);
+  void set(int binding, const ponos::vec2 &value);
+  void set(int binding, const ponos::vec3 &value);
+  void set(int binding, const ponos::point3 &value);
+  /// \param value **[in]** matrix already transposed to column-major order
+  void set(int binding, const ponos::mat4 &value);
+  /// Issues GL calls for dirty bindings. The owner program must be in use.
+  /// \return number of GL uniform calls issued
+  u32 upload();
+  [[nodiscard]] size_t size() const { return bindings_.size(); }
+
+private:
+  void write(int binding, const void *data, u32 size);
+
+  std::vector<Binding> bindings_;
+  std::vector<u8> arena_;
+};
+
+#endif //GLSL_EXPERIMENTS_UNIFORM_BINDING_TABLE_H
@@ -0,0 +1,65 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file uniform_blocks.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "uniform_blocks.h"
+
+#include <cstring>
+
+UniformBlockBuffer::UniformBlockBuffer(std::string name, GLuint binding, u32 size)
+    : name(std::move(name)), binding(binding), shadow_(size, 0) {}
+
+UniformBlockBuffer::~UniformBlockBuffer() {
+  if (buffer_)
+    glDeleteBuffers(1, &buffer_);
+}
+
+bool UniformBlockBuffer::attach(GLuint program_id) const {
+  auto index = glGetUniformBlockIndex(program_id, name.c_str());
+  if (index == GL_INVALID_INDEX)
+    return false;
+  glUniformBlockBinding(program_id, index, binding);
+  return true;
+}
+
+bool UniformBlockBuffer::update(const void *data) {
+  if (!buffer_) {
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    glBufferData(GL_UNIFORM_BUFFER, shadow_.size(), nullptr, GL_DYNAMIC_DRAW);
+  }
+  if (written_ && !std::memcmp(shadow_.data(), data, shadow_.size()))
+    return false;
+  std::memcpy(shadow_.data(), data, shadow_.size());
+  glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, shadow_.size(), shadow_.data());
+  written_ = true;
+  return true;
+}
+
+void UniformBlockBuffer::bind() const {
+  glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer_);
+}
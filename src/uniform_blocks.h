@@ -0,0 +1,233 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file uniform_blocks.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief std140 uniform blocks shared by the editor shaders.
+
+#ifndef GLSL_EXPERIMENTS_UNIFORM_BLOCKS_H
+#define GLSL_EXPERIMENTS_UNIFORM_BLOCKS_H
+
+#include <circe/circe.h>
+#include <cstddef>
+
+// *********************************************************************************************************************
+//                                                                                                      std140 layout
+// *********************************************************************************************************************
+/// Base alignment and size of a GLSL type under std140 (in bytes)
+struct Std140Member {
+  u32 alignment;
+  u32 size;
+};
+
+constexpr Std140Member std140_float{4, 4};
+constexpr Std140Member std140_int{4, 4};
+constexpr Std140Member std140_vec2{8, 8};
+constexpr Std140Member std140_vec3{16, 12};
+constexpr Std140Member std140_vec4{16, 16};
+constexpr Std140Member std140_mat4{16, 64};
+
+constexpr u32 std140RoundUp(u32 offset, u32 alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+/// \return layout of an array of **count** **element**s (vec4 aligned stride)
+constexpr Std140Member std140Array(Std140Member element, u32 count) {
+  return {16, std140RoundUp(element.size, 16) * count};
+}
+
+/// \param members **[in]** member layouts, in declaration order
+/// \param i **[in]** member index
+/// \return offset of member **i** inside its struct/block
+template<size_t N>
+constexpr u32 std140Offset(const Std140Member (&members)[N], size_t i) {
+  u32 offset = 0;
+  for (size_t m = 0; m < i; ++m)
+    offset = std140RoundUp(offset, members[m].alignment) + members[m].size;
+  return std140RoundUp(offset, members[i].alignment);
+}
+
+/// \param members **[in]** member layouts, in declaration order
+/// \return layout of a struct containing **members** (vec4 aligned and padded)
+template<size_t N>
+constexpr Std140Member std140Struct(const Std140Member (&members)[N]) {
+  return {16, std140RoundUp(std140Offset(members, N - 1) + members[N - 1].size, 16)};
+}
+
+/// Fails compilation if the C++ member offset diverges from the std140 rules
+#define STD140_CHECK_MEMBER(TYPE, MEMBER, LAYOUT, INDEX) \
+  static_assert(offsetof(TYPE, MEMBER) == std140Offset(LAYOUT, INDEX), \
+                #TYPE "::" #MEMBER " does not match the std140 layout")
+#define STD140_CHECK_SIZE(TYPE, LAYOUT) \
+  static_assert(sizeof(TYPE) == std140Struct(LAYOUT).size, #TYPE " does not match the std140 size")
+
+// *********************************************************************************************************************
+//                                                                                                        block data
+// *********************************************************************************************************************
+/// GLSL:
+///   layout(std140, binding = 0) uniform FrameBlock {
+///     mat4 view;
+///     mat4 projection;
+///     vec3 cameraPosition;
+///     float time;
+///     vec2 screenResolution;
+///   };
+struct FrameBlockData {
+  alignas(16) f32 view[16]{};
+  alignas(16) f32 projection[16]{};
+  alignas(16) f32 camera_position[3]{};
+  f32 time{0};
+  alignas(8) f32 screen_resolution[2]{};
+};
+
+/// GLSL struct Light
+struct LightBlockData {
+  alignas(16) f32 direction[3]{};
+  alignas(16) f32 point[3]{};
+  alignas(16) f32 ambient[3]{};
+  alignas(16) f32 diffuse[3]{};
+  alignas(16) f32 specular[3]{};
+};
+
+/// GLSL struct Material
+struct MaterialBlockData {
+  alignas(16) f32 k_ambient[3]{};
+  alignas(16) f32 k_diffuse[3]{};
+  alignas(16) f32 k_specular[3]{};
+  f32 shininess{0};
+};
+
+/// GLSL:
+///   layout(std140, binding = 1) uniform SceneBlock {
+///     Light light;
+///     Material material;
+///   };
+struct SceneBlockData {
+  alignas(16) LightBlockData light;
+  alignas(16) MaterialBlockData material;
+};
+
+/// GLSL:
+///   layout(std140, binding = 2) uniform EnvironmentBlock {
+///     vec4 irradianceSH[9];
+///     float environmentLevels;
+///     float environmentIntensity;
+///     int environmentEnabled;
+///   };
+struct EnvironmentBlockData {
+  alignas(16) f32 irradiance_sh[9][4]{}; //!< rgb, w unused
+  f32 levels{0};                         //!< mips of the prefiltered cube map
+  f32 intensity{1};
+  i32 enabled{0};
+};
+
+/// GLSL:
+///   layout(std140, binding = 3) uniform ShadowBlock {
+///     mat4 shadowMatrices[4];
+///     vec4 shadowTiles[4];
+///     vec4 shadowSplits;
+///     int shadowCascadeCount;
+///     float shadowBias;
+///   };
+struct ShadowBlockData {
+  alignas(16) f32 matrices[4][16]{}; //!< world -> (tile uv, depth) of each cascade, column major
+  alignas(16) f32 tiles[4][4]{};     //!< atlas offset (xy) and scale (zw) of each cascade
+  alignas(16) f32 splits[4]{};       //!< view distance where each cascade ends
+  i32 cascade_count{0};              //!< 0 when shadows are off
+  f32 bias{0};                       //!< depth bias, in light clip space units
+};
+
+constexpr Std140Member frame_block_layout[] = {std140_mat4, std140_mat4, std140_vec3, std140_float, std140_vec2};
+STD140_CHECK_MEMBER(FrameBlockData, view, frame_block_layout, 0);
+STD140_CHECK_MEMBER(FrameBlockData, projection, frame_block_layout, 1);
+STD140_CHECK_MEMBER(FrameBlockData, camera_position, frame_block_layout, 2);
+STD140_CHECK_MEMBER(FrameBlockData, time, frame_block_layout, 3);
+STD140_CHECK_MEMBER(FrameBlockData, screen_resolution, frame_block_layout, 4);
+STD140_CHECK_SIZE(FrameBlockData, frame_block_layout);
+
+constexpr Std140Member light_layout[] = {std140_vec3, std140_vec3, std140_vec3, std140_vec3, std140_vec3};
+STD140_CHECK_MEMBER(LightBlockData, direction, light_layout, 0);
+STD140_CHECK_MEMBER(LightBlockData, point, light_layout, 1);
+STD140_CHECK_MEMBER(LightBlockData, ambient, light_layout, 2);
+STD140_CHECK_MEMBER(LightBlockData, diffuse, light_layout, 3);
+STD140_CHECK_MEMBER(LightBlockData, specular, light_layout, 4);
+STD140_CHECK_SIZE(LightBlockData, light_layout);
+
+constexpr Std140Member material_layout[] = {std140_vec3, std140_vec3, std140_vec3, std140_float};
+STD140_CHECK_MEMBER(MaterialBlockData, k_ambient, material_layout, 0);
+STD140_CHECK_MEMBER(MaterialBlockData, k_diffuse, material_layout, 1);
+STD140_CHECK_MEMBER(MaterialBlockData, k_specular, material_layout, 2);
+STD140_CHECK_MEMBER(MaterialBlockData, shininess, material_layout, 3);
+STD140_CHECK_SIZE(MaterialBlockData, material_layout);
+
+constexpr Std140Member scene_block_layout[] = {std140Struct(light_layout), std140Struct(material_layout)};
+STD140_CHECK_MEMBER(SceneBlockData, light, scene_block_layout, 0);
+STD140_CHECK_MEMBER(SceneBlockData, material, scene_block_layout, 1);
+STD140_CHECK_SIZE(SceneBlockData, scene_block_layout);
+
+constexpr Std140Member environment_block_layout[] = {std140Array(std140_vec4, 9), std140_float, std140_float,
+                                                     std140_int};
+STD140_CHECK_MEMBER(EnvironmentBlockData, irradiance_sh, environment_block_layout, 0);
+STD140_CHECK_MEMBER(EnvironmentBlockData, levels, environment_block_layout, 1);
+STD140_CHECK_MEMBER(EnvironmentBlockData, intensity, environment_block_layout, 2);
+STD140_CHECK_MEMBER(EnvironmentBlockData, enabled, environment_block_layout, 3);
+STD140_CHECK_SIZE(EnvironmentBlockData, environment_block_layout);
+
+constexpr Std140Member shadow_block_layout[] = {std140Array(std140_mat4, 4), std140Array(std140_vec4, 4),
+                                                std140_vec4, std140_int, std140_float};
+STD140_CHECK_MEMBER(ShadowBlockData, matrices, shadow_block_layout, 0);
+STD140_CHECK_MEMBER(ShadowBlockData, tiles, shadow_block_layout, 1);
+STD140_CHECK_MEMBER(ShadowBlockData, splits, shadow_block_layout, 2);
+STD140_CHECK_MEMBER(ShadowBlockData, cascade_count, shadow_block_layout, 3);
+STD140_CHECK_MEMBER(ShadowBlockData, bias, shadow_block_layout, 4);
+STD140_CHECK_SIZE(ShadowBlockData, shadow_block_layout);
+
+// *********************************************************************************************************************
+//                                                                                                 UniformBlockBuffer
+// *********************************************************************************************************************
+/// Uniform buffer bound to a fixed binding point. The whole block is written
+/// with a single glBufferSubData, and only when its content changed.
+class UniformBlockBuffer {
+public:
+  /// \param name **[in]** block name in GLSL
+  /// \param binding **[in]** uniform buffer binding point
+  /// \param size **[in]** block size in bytes
+  UniformBlockBuffer(std::string name, GLuint binding, u32 size);
+  ~UniformBlockBuffer();
+  /// Points the program's block (if declared) to this buffer's binding point.
+  /// \return true if **program_id** declares the block
+  bool attach(GLuint program_id) const;
+  /// \param data **[in]** block data, with the size given at construction
+  /// \return true if the buffer was written
+  bool update(const void *data);
+  void bind() const;
+
+  const std::string name;
+  const GLuint binding;
+private:
+  std::vector<u8> shadow_;
+  GLuint buffer_{0};
+  bool written_{false};
+};
+
+#endif //GLSL_EXPERIMENTS_UNIFORM_BLOCKS_H
@@ -0,0 +1,329 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file vertex_format.cpp
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief
+
+#include "vertex_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// GL enums, without pulling GL headers into GL free code
+constexpr u32 gl_short = 0x1402;
+constexpr u32 gl_unsigned_short = 0x1403;
+constexpr u32 gl_float = 0x1406;
+constexpr u32 gl_half_float = 0x140B;
+constexpr u32 gl_int_2_10_10_10_rev = 0x8D9F;
+
+struct AttributeRole {
+  enum : int { OTHER = 0, POSITION, DIRECTION, TEXCOORD };
+};
+
+int attributeRole(const MeshAttribute &attribute) {
+  const std::string name = attribute.name;
+  if (name == "position" && attribute.component_count == 3)
+    return AttributeRole::POSITION;
+  if ((name == "normal" || name == "tangent" || name == "bitangent") && attribute.component_count == 3)
+    return AttributeRole::DIRECTION;
+  if (name == "uv" || name == "texcoord")
+    return AttributeRole::TEXCOORD;
+  return AttributeRole::OTHER;
+}
+
+u32 alignUp4(u32 size) {
+  return (size + 3) & ~3u;
+}
+
+u16 unorm16(f32 value) {
+  return static_cast<u16>(std::lround(std::min(std::max(value, 0.f), 1.f) * 65535.f));
+}
+
+i16 snorm16(f32 value) {
+  return static_cast<i16>(std::lround(std::min(std::max(value, -1.f), 1.f) * 32767.f));
+}
+
+u32 snorm10(f32 value) {
+  return static_cast<u32>(std::lround(std::min(std::max(value, -1.f), 1.f) * 511.f)) & 0x3ffu;
+}
+
+f32 dot3(const f32 *a, const f32 *b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+}
+
+const char *vertexFormatName(int format) {
+  switch (format) {
+  case VertexFormat::FLOAT: return "float";
+  case VertexFormat::COMPACT_OCTAHEDRAL: return "16 bit, octahedral normals";
+  case VertexFormat::COMPACT_1010102: return "16 bit, 10:10:10:2 normals";
+  default: return "unknown";
+  }
+}
+
+u16 floatToHalf(f32 value) {
+  u32 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const u32 sign = (bits >> 16) & 0x8000u;
+  const i32 exponent = static_cast<i32>((bits >> 23) & 0xffu);
+  u32 mantissa = bits & 0x7fffffu;
+  if (exponent == 0xff)
+    return static_cast<u16>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+  const i32 half_exponent = exponent - 127 + 15;
+  if (half_exponent >= 31)
+    return static_cast<u16>(sign | 0x7c00u);
+  u32 shift = 13;
+  if (half_exponent <= 0) {
+    // subnormal
+    if (half_exponent < -10)
+      return static_cast<u16>(sign);
+    mantissa |= 0x800000u;
+    shift = static_cast<u32>(14 - half_exponent);
+  } else
+    mantissa |= static_cast<u32>(half_exponent) << 23;
+  u32 half = mantissa >> shift;
+  const u32 remainder = mantissa & ((1u << shift) - 1);
+  const u32 midpoint = 1u << (shift - 1);
+  // a carry out of the mantissa correctly moves to the next exponent
+  if (remainder > midpoint || (remainder == midpoint && (half & 1u)))
+    half++;
+  return static_cast<u16>(sign | half);
+}
+
+std::vector<f32> addTangentFrames(const f32 *vertices, size_t vertex_count, u32 stride, u32 normal_offset,
+                                  i32 uv_offset, const u32 *indices, size_t index_count) {
+  // uv gradients of the adjacent triangles: d position / du, then d position / dv
+  std::vector<f32> gradients(vertex_count * 6, 0.f);
+  for (size_t i = 0; uv_offset >= 0 && i + 2 < index_count; i += 3) {
+    const f32 *p[3];
+    for (int k = 0; k < 3; ++k)
+      p[k] = vertices + size_t(indices[i + k]) * stride;
+    const f32 du1 = p[1][uv_offset] - p[0][uv_offset], dv1 = p[1][uv_offset + 1] - p[0][uv_offset + 1];
+    const f32 du2 = p[2][uv_offset] - p[0][uv_offset], dv2 = p[2][uv_offset + 1] - p[0][uv_offset + 1];
+    const f32 det = du1 * dv2 - du2 * dv1;
+    if (std::abs(det) < 1e-12f)
+      continue;
+    const f32 r = 1 / det;
+    for (int d = 0; d < 3; ++d) {
+      const f32 e1 = p[1][d] - p[0][d], e2 = p[2][d] - p[0][d];
+      const f32 s = (e1 * dv2 - e2 * dv1) * r, t = (e2 * du1 - e1 * du2) * r;
+      for (int k = 0; k < 3; ++k) {
+        gradients[indices[i + k] * 6 + d] += s;
+        gradients[indices[i + k] * 6 + 3 + d] += t;
+      }
+    }
+  }
+  const u32 output_stride = stride + 6;
+  std::vector<f32> output(vertex_count * output_stride);
+  for (size_t v = 0; v < vertex_count; ++v) {
+    const f32 *input = vertices + v * stride;
+    f32 *out = &output[v * output_stride];
+    std::copy(input, input + stride, out);
+    f32 n[3] = {input[normal_offset], input[normal_offset + 1], input[normal_offset + 2]};
+    f32 length = std::sqrt(dot3(n, n));
+    if (length <= 0) {
+      n[0] = n[1] = 0;
+      n[2] = length = 1;
+    }
+    for (auto &c : n)
+      c /= length;
+    // Gram-Schmidt
+    const f32 *s = &gradients[v * 6], *t = s + 3;
+    f32 tangent[3];
+    for (int d = 0; d < 3; ++d)
+      tangent[d] = s[d] - n[d] * dot3(n, s);
+    length = std::sqrt(dot3(tangent, tangent));
+    if (length < 1e-8f) {
+      // any direction perpendicular to the normal
+      const f32 axis[3] = {std::abs(n[0]) < 0.9f ? 1.f : 0.f, std::abs(n[0]) < 0.9f ? 0.f : 1.f, 0.f};
+      for (int d = 0; d < 3; ++d)
+        tangent[d] = axis[d] - n[d] * dot3(n, axis);
+      length = std::sqrt(dot3(tangent, tangent));
+    }
+    for (auto &c : tangent)
+      c /= length;
+    f32 bitangent[3] = {n[1] * tangent[2] - n[2] * tangent[1], n[2] * tangent[0] - n[0] * tangent[2],
+                        n[0] * tangent[1] - n[1] * tangent[0]};
+    if (dot3(bitangent, t) < 0)
+      for (auto &c : bitangent)
+        c = -c;
+    std::copy(tangent, tangent + 3, out + stride);
+    std::copy(bitangent, bitangent + 3, out + stride + 3);
+  }
+  return output;
+}
+
+void octahedralEncode(const f32 v[3], f32 encoded[2]) {
+  const f32 l1 = std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]);
+  if (l1 <= 0) {
+    encoded[0] = encoded[1] = 0;
+    return;
+  }
+  f32 x = v[0] / l1, y = v[1] / l1;
+  if (v[2] < 0) {
+    // fold the lower hemisphere over the diagonals
+    const f32 folded_x = (1 - std::abs(y)) * (x >= 0 ? 1.f : -1.f);
+    y = (1 - std::abs(x)) * (y >= 0 ? 1.f : -1.f);
+    x = folded_x;
+  }
+  encoded[0] = x;
+  encoded[1] = y;
+}
+
+bool packVertices(const void *vertices, size_t vertex_count, const MeshAttribute *attributes,
+                  u32 attribute_count, u32 stride, int format, PackedVertices &packed, std::string &err,
+                  ThreadPool &pool) {
+  if (format < 0 || format >= VertexFormat::COUNT) {
+    err = "unknown vertex format";
+    return false;
+  }
+  if (attribute_count > MeshFileHeader::max_attributes) {
+    err = "too many vertex attributes";
+    return false;
+  }
+  for (u32 i = 0; i < attribute_count; ++i)
+    if (attributes[i].type != gl_float) {
+      err = ponos::concat("vertex attribute ", attributes[i].name, " is not float");
+      return false;
+    }
+  const auto *input = static_cast<const u8 *>(vertices);
+  auto read = [&](size_t vertex, const MeshAttribute &attribute, u32 component) {
+    f32 value;
+    memcpy(&value, input + vertex * stride + attribute.offset + component * sizeof(f32), sizeof(f32));
+    return value;
+  };
+  packed = PackedVertices();
+  packed.attribute_count = attribute_count;
+  if (format == VertexFormat::FLOAT) {
+    packed.stride = stride;
+    std::copy(attributes, attributes + attribute_count, packed.attributes);
+    packed.data.assign(input, input + vertex_count * stride);
+    return true;
+  }
+  packed.dequantization.normal_encoding =
+      format == VertexFormat::COMPACT_OCTAHEDRAL ? NormalEncoding::OCTAHEDRAL : NormalEncoding::XYZ;
+  // output layout, every attribute aligned to 4 bytes
+  int roles[MeshFileHeader::max_attributes]{};
+  for (u32 i = 0; i < attribute_count; ++i) {
+    auto &output = packed.attributes[i];
+    output = attributes[i];
+    output.offset = packed.stride;
+    roles[i] = attributeRole(attributes[i]);
+    switch (roles[i]) {
+    case AttributeRole::POSITION:
+      // the 4th short is padding, shaders read vec3
+      output.type = gl_unsigned_short;
+      output.normalized = 1;
+      packed.stride += 4 * sizeof(u16);
+      break;
+    case AttributeRole::DIRECTION:
+      if (format == VertexFormat::COMPACT_OCTAHEDRAL) {
+        output.type = gl_short;
+        output.component_count = 2;
+      } else {
+        output.type = gl_int_2_10_10_10_rev;
+        output.component_count = 4;
+      }
+      output.normalized = 1;
+      packed.stride += 4;
+      break;
+    case AttributeRole::TEXCOORD:
+      output.type = gl_half_float;
+      output.normalized = 0;
+      packed.stride += alignUp4(attributes[i].component_count * sizeof(u16));
+      break;
+    default:packed.stride += attributes[i].component_count * sizeof(f32);
+    }
+  }
+  // positions are stored relative to the bounds of the mesh
+  f32 bounds_min[3] = {0, 0, 0}, bounds_max[3] = {0, 0, 0};
+  for (u32 i = 0; i < attribute_count; ++i) {
+    if (roles[i] != AttributeRole::POSITION)
+      continue;
+    for (int d = 0; d < 3; ++d) {
+      bounds_min[d] = vertex_count ? read(0, attributes[i], d) : 0;
+      bounds_max[d] = bounds_min[d];
+    }
+    for (size_t v = 1; v < vertex_count; ++v)
+      for (int d = 0; d < 3; ++d) {
+        bounds_min[d] = std::min(bounds_min[d], read(v, attributes[i], d));
+        bounds_max[d] = std::max(bounds_max[d], read(v, attributes[i], d));
+      }
+    break;
+  }
+  auto &dequantization = packed.dequantization;
+  for (int d = 0; d < 3; ++d) {
+    dequantization.position_offset[d] = bounds_min[d];
+    dequantization.position_scale[d] = bounds_max[d] - bounds_min[d];
+  }
+  packed.data.assign(vertex_count * packed.stride, 0);
+  pool.parallelFor(vertex_count, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      u8 *output = packed.data.data() + v * packed.stride;
+      for (u32 i = 0; i < attribute_count; ++i) {
+        const auto &attribute = attributes[i];
+        u8 *out = output + packed.attributes[i].offset;
+        switch (roles[i]) {
+        case AttributeRole::POSITION: {
+          u16 q[4] = {0, 0, 0, 0};
+          for (int d = 0; d < 3; ++d) {
+            const f32 extent = dequantization.position_scale[d];
+            q[d] = extent > 0 ? unorm16((read(v, attribute, d) - bounds_min[d]) / extent) : 0;
+          }
+          memcpy(out, q, sizeof(q));
+          break;
+        }
+        case AttributeRole::DIRECTION: {
+          f32 n[3] = {read(v, attribute, 0), read(v, attribute, 1), read(v, attribute, 2)};
+          if (format == VertexFormat::COMPACT_OCTAHEDRAL) {
+            f32 e[2];
+            octahedralEncode(n, e);
+            i16 q[2] = {snorm16(e[0]), snorm16(e[1])};
+            memcpy(out, q, sizeof(q));
+          } else {
+            const f32 length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            const f32 inv = length > 0 ? 1 / length : 0;
+            u32 q = snorm10(n[0] * inv) | snorm10(n[1] * inv) << 10 | snorm10(n[2] * inv) << 20;
+            memcpy(out, &q, sizeof(q));
+          }
+          break;
+        }
+        case AttributeRole::TEXCOORD:
+          for (u32 c = 0; c < attribute.component_count; ++c) {
+            u16 h = floatToHalf(read(v, attribute, c));
+            memcpy(out + c * sizeof(u16), &h, sizeof(h));
+          }
+          break;
+        default:
+          memcpy(out, input + v * stride + attribute.offset, attribute.component_count * sizeof(f32));
+        }
+      }
+    }
+  }, 1024);
+  return true;
+}
@@ -0,0 +1,114 @@
+/// Copyright (c) 2020, FilipeCN.
+///
+/// The MIT License (MIT)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+///
+///\file vertex_format.h
+///\author FilipeCN (filipedecn@gmail.com)
+///\date 2026-16-10
+///
+///\brief Compact vertex formats: quantized positions, octahedral normals and half float texture coordinates.
+
+#ifndef GLSL_EXPERIMENTS_VERTEX_FORMAT_H
+#define GLSL_EXPERIMENTS_VERTEX_FORMAT_H
+
+#include "mesh_file.h"
+#include "thread_pool.h"
+
+/// Storage of the vertex attributes on the GPU. Compact formats keep
+/// positions as 16 bit integers normalized to the mesh bounds, normal,
+/// tangent and bitangent as 2x16 bit octahedral or 10:10:10:2 vectors and
+/// texture coordinates as half floats. Other attributes stay float.
+///
+/// Shaders read compact vertices through shaders/include/vertex_format.glsl.
+struct VertexFormat {
+  enum : int { FLOAT = 0, COMPACT_OCTAHEDRAL, COMPACT_1010102, COUNT };
+};
+
+/// How normal, tangent and bitangent attributes are stored
+struct NormalEncoding {
+  enum : int { XYZ = 0, OCTAHEDRAL };
+};
+
+/// Maps stored attributes back to object space, GLSL:
+///   uniform vec3 positionScale;
+///   uniform vec3 positionOffset;
+///   uniform int normalEncoding;
+struct VertexDequantization {
+  f32 position_scale[3]{1, 1, 1};
+  f32 position_offset[3]{0, 0, 0};
+  int normal_encoding{NormalEncoding::XYZ};
+};
+
+/// Interleaved vertex buffer in a VertexFormat, attribute i goes to location i
+struct PackedVertices {
+  std::vector<u8> data;
+  u32 stride{0}; //!< in bytes
+  u32 attribute_count{0};
+  MeshAttribute attributes[MeshFileHeader::max_attributes];
+  VertexDequantization dequantization;
+};
+
+/// \param format **[in]**
+/// \return name for UI and logs
+const char *vertexFormatName(int format);
+
+/// Converts float vertices into **format**. Attributes are identified by
+/// name: "position"; "normal", "tangent" and "bitangent"; "uv" and
+/// "texcoord".
+/// \param vertices **[in]** interleaved vertex data
+/// \param vertex_count **[in]**
+/// \param attributes **[in]** GL_FLOAT attributes of **vertices**
+/// \param attribute_count **[in]**
+/// \param stride **[in]** in bytes
+/// \param format **[in]** VertexFormat
+/// \param packed **[out]**
+/// \param err **[out]**
+/// \param pool **[in | optional]** vertices are converted in parallel
+/// \return false if an attribute is not float or the format is unknown
+bool packVertices(const void *vertices, size_t vertex_count, const MeshAttribute *attributes,
+                  u32 attribute_count, u32 stride, int format, PackedVertices &packed, std::string &err,
+                  ThreadPool &pool = ThreadPool::global());
+
+/// \param value **[in]**
+/// \return IEEE 754 half precision bits, rounded to nearest even
+u16 floatToHalf(f32 value);
+
+/// Appends a tangent and a bitangent (3 floats each) to every vertex. The
+/// tangent follows the u direction of the texture coordinates (Lengyel's
+/// method), orthogonalized against the normal; the bitangent is
+/// cross(normal, tangent), flipped to follow v. Vertices without uv
+/// gradients get an arbitrary frame around their normal.
+/// \param vertices **[in]** interleaved float vertices
+/// \param vertex_count **[in]**
+/// \param stride **[in]** in floats
+/// \param normal_offset **[in]** in floats, inside a vertex
+/// \param uv_offset **[in]** in floats, inside a vertex, negative if there are no uvs
+/// \param indices **[in]** triangle list
+/// \param index_count **[in]**
+/// \return vertices with a stride of **stride** + 6 floats
+std::vector<f32> addTangentFrames(const f32 *vertices, size_t vertex_count, u32 stride, u32 normal_offset,
+                                  i32 uv_offset, const u32 *indices, size_t index_count);
+
+/// Octahedral mapping of a unit vector (Meyer et al. 2010)
+/// \param v **[in]** direction, does not need to be normalized
+/// \param encoded **[out]** in [-1, 1]
+void octahedralEncode(const f32 v[3], f32 encoded[2]);
+
+#endif //GLSL_EXPERIMENTS_VERTEX_FORMAT_H